@@ -3,6 +3,7 @@
 #include "Util.hpp"
 
 #include "attrs/ContainerType.hpp"
+#include "attrs/FieldTemperature.hpp"
 
 // here we just include necessary StdName/Name_*.h
 // if you want to include all, you can define macro UBPA_UDREFL_INCLUDE_ALL_STD_NAME
@@ -55,6 +56,50 @@ namespace Ubpa::UDRefl {
 	};
 	UBPA_UDREFL_ENUM_BOOL_OPERATOR_DEFINE(FieldFlag)
 
+	// meta method groups generated by details::TypeAutoRegister_Default<T>
+	// see AutoRegisterPolicy<T>
+	// always registered (independent of the flags)
+	// - the destructor, the ContainerType attr and the ContainerVTable (see TypeInfo::container_vtable)
+	// - the pointee type, the element types of raw arrays, containers (key / mapped / value type),
+	//   pair / tuple and the alternatives of variant
+	// the other member types (size / iterator / pointer types, ...) are registered by Container,
+	// the fields of pair (first / second) by TupleVariant
+	enum class AutoRegisterFlag {
+		Lifecycle    = 0b0000001, // ctors, copy / move assignment
+		Arithmetic   = 0b0000010, // operator bool, arithmetic, bitwise, ++ / --, compound assignment
+		Compare      = 0b0000100, // == != < > <= >= (except containers)
+		Stream       = 0b0001000, // operator<< / operator>> with std streams (6 overloads per direction)
+		Iterator     = 0b0010000, // [] / * and iterator operations (advance, next, prev, distance)
+		Container    = 0b0100000, // container methods and member types
+		TupleVariant = 0b1000000, // pair, tuple, variant and optional
+
+		None         = 0b0000000,
+		Default      = 0b1110111, // All except Stream
+		All          = 0b1111111
+	};
+	UBPA_UDREFL_ENUM_BOOL_OPERATOR_DEFINE(AutoRegisterFlag)
+
+	// specialize it to select the meta method groups of T
+	// stream operators are opt-in, arithmetic types and strings (include char pointers) opt in by default
+	template<typename T>
+	struct AutoRegisterPolicy {
+		static constexpr AutoRegisterFlag flags =
+			std::is_arithmetic_v<T>
+			|| is_instance_of_v<T, std::basic_string>
+			|| is_instance_of_v<T, std::basic_string_view>
+			|| std::is_same_v<std::remove_cv_t<T>, const char*>
+			|| std::is_same_v<std::remove_cv_t<T>, char*>
+			? AutoRegisterFlag::Default | AutoRegisterFlag::Stream
+			: AutoRegisterFlag::Default;
+	};
+
+	// used by data-driven RegisterType
+	enum class FieldLayoutPolicy {
+		Declared,            // in the given order
+		AlignmentDescending, // sort by alignment (stable), minimize padding
+		HotCold              // hot fields first, then cold fields (see attr FieldTemperature), each part is sorted by alignment
+	};
+
 	using SharedBuffer = std::shared_ptr<void>;
 	class ObjectView;
 	class SharedObject;
@@ -106,5 +151,8 @@ namespace Ubpa::UDRefl {
 	class FieldRange;
 	class MethodRange;
 
+	class ContainerView;
+	class ObjectSpan;
+
 	class ReflMngr;
 }
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Util.hpp"
+
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace Ubpa::UDRefl {
+	// inline storage of ContainerIterator, larger iterators aren't supported
+	static constexpr std::size_t ContainerIteratorStorageSize = 4 * sizeof(void*);
+
+	// type-erased operations of a container type
+	// - meta methods registered by ReflMngr::AddContainerVTableMethods share the same thunks,
+	//   only the entries of the table are generated per type
+	// - ReflMngr::AddContainerVTable stores the table in TypeInfo, ObjectView::AsContainer() uses it directly
+	// - unsupported operations are nullptr
+	struct ContainerVTable {
+		std::size_t(*size)(const void* obj);
+		bool(*empty)(const void* obj);
+
+		// elements are objects (not proxies, e.g. std::vector<bool>::reference)
+		Type element_type; // maybe const (e.g. std::set), invalid if elements aren't objects
+		std::size_t element_size;
+		// contiguous elements, the stride is element_size
+		void*(*data)(void* obj);
+		// call callback(element, ctx) on each element in order
+		void(*for_each)(void* obj, void(*callback)(void* element, void* ctx), void* ctx);
+
+		void(*reserve)(void* obj, std::size_t n);
+		// resize to n elements, new elements are value-initialized
+		void(*resize)(void* obj, std::size_t n);
+		// emplace a value-initialized element at the end, return its address
+		void*(*emplace_back)(void* obj);
+		void(*clear)(void* obj);
+		// append count elements (contiguous, type is element_type without const) at the end,
+		// or insert them for associative containers (reserve once if possible)
+		// move : move-construct them, otherwise copy-construct them
+		// return false if the elements can't be moved / copied (nothing is appended)
+		bool(*append)(void* obj, void* src, std::size_t count, bool move);
+		// append returns true for copies / moves, check them before destructive steps (e.g. clear)
+		bool can_copy_append;
+		bool can_move_append;
+
+		// iterator (see ContainerIterator), supported if the iterator fits in ContainerIteratorStorageSize bytes
+		// - begin / end : construct the iterator in the storage
+		// - dereference : return the address of the element
+		// - copy / destroy : nullptr if the iterator is trivially copyable (copy the storage)
+		void(*begin)(void* obj, void* iter);
+		void(*end)(void* obj, void* iter);
+		void(*increment)(void* iter);
+		bool(*equal)(const void* lhs, const void* rhs);
+		void*(*dereference)(const void* iter);
+		void(*copy_iterator)(void* dst, const void* src);
+		void(*destroy_iterator)(void* iter);
+	};
+
+	template<typename T>
+	concept container_object_elements = requires(T & t) { std::begin(t); std::end(t); }
+		&& std::is_lvalue_reference_v<decltype(*std::begin(std::declval<T&>()))>;
+
+	template<typename T>
+	concept container_contiguous = container_object_elements<T>
+		&& std::contiguous_iterator<decltype(std::begin(std::declval<T&>()))>;
+
+	template<typename T>
+	concept container_emplace_back_default = container_object_elements<T> && requires(T & t) { t.emplace_back(); t.back(); };
+
+	template<typename T>
+	concept container_inline_iterator = container_object_elements<T>
+		&& std::is_same_v<decltype(std::begin(std::declval<T&>())), decltype(std::end(std::declval<T&>()))>
+		&& std::is_nothrow_copy_constructible_v<decltype(std::begin(std::declval<T&>()))>
+		&& sizeof(decltype(std::begin(std::declval<T&>()))) <= ContainerIteratorStorageSize
+		&& alignof(decltype(std::begin(std::declval<T&>()))) <= alignof(std::max_align_t);
+
+	template<typename T>
+	concept container_append = container_object_elements<T> && container_value_type<T>
+		&& std::is_same_v<std::remove_cvref_t<decltype(*std::begin(std::declval<T&>()))>, typename T::value_type>
+		&& (container_push_back_clvalue<T> || container_push_back_rvalue<T> || container_insert_clvalue<T> || container_insert_rvalue<T>);
+
+	template<typename T>
+	constexpr ContainerVTable GenerateContainerVTable() noexcept {
+		ContainerVTable vtable{};
+		if constexpr (container_size<T>)
+			vtable.size = [](const void* obj) { return static_cast<std::size_t>(std::size(*static_cast<const T*>(obj))); };
+		if constexpr (container_empty<T>)
+			vtable.empty = [](const void* obj) { return static_cast<bool>(std::empty(*static_cast<const T*>(obj))); };
+		if constexpr (container_object_elements<T>) {
+			using Element = std::remove_reference_t<decltype(*std::begin(std::declval<T&>()))>;
+			vtable.element_type = Type_of<Element>;
+			vtable.element_size = sizeof(Element);
+			vtable.for_each = [](void* obj, void(*callback)(void*, void*), void* ctx) {
+				for (auto& element : *static_cast<T*>(obj))
+					callback(const_cast<void*>(static_cast<const void*>(std::addressof(element))), ctx);
+			};
+		}
+		if constexpr (container_contiguous<T>) {
+			vtable.data = [](void* obj) {
+				return const_cast<void*>(static_cast<const void*>(std::to_address(std::begin(*static_cast<T*>(obj)))));
+			};
+		}
+		if constexpr (container_reserve<T>)
+			vtable.reserve = [](void* obj, std::size_t n) { static_cast<T*>(obj)->reserve(static_cast<typename T::size_type>(n)); };
+		if constexpr (container_resize_cnt<T>)
+			vtable.resize = [](void* obj, std::size_t n) { static_cast<T*>(obj)->resize(static_cast<typename T::size_type>(n)); };
+		if constexpr (container_emplace_back_default<T>) {
+			vtable.emplace_back = [](void* obj) {
+				auto& c = *static_cast<T*>(obj);
+				c.emplace_back();
+				return const_cast<void*>(static_cast<const void*>(std::addressof(c.back())));
+			};
+		}
+		if constexpr (container_clear<T>)
+			vtable.clear = [](void* obj) { static_cast<T*>(obj)->clear(); };
+		if constexpr (container_append<T>) {
+			using Value = typename T::value_type;
+			constexpr bool memcpyable = std::is_trivially_copyable_v<Value> && container_contiguous<T> && container_resize_cnt<T>;
+			// moving falls back to copying
+			constexpr bool copyable = memcpyable || (std::is_copy_constructible_v<Value>
+				&& (container_push_back_clvalue<T> || container_insert_clvalue<T>));
+			constexpr bool movable = copyable || (std::is_move_constructible_v<Value>
+				&& (container_push_back_rvalue<T> || container_insert_rvalue<T>));
+			vtable.can_copy_append = copyable;
+			vtable.can_move_append = movable;
+			vtable.append = [](void* obj, void* src, std::size_t count, bool move) {
+				auto& c = *static_cast<T*>(obj);
+				auto* first = static_cast<Value*>(src);
+				if constexpr (memcpyable) {
+					// memcpy the payload into the grown storage
+					const std::size_t offset = std::size(c);
+					c.resize(static_cast<typename T::size_type>(offset + count));
+					if (count > 0)
+						std::memcpy(std::to_address(std::begin(c)) + offset, first, count * sizeof(Value));
+					return true;
+				}
+				else {
+					if (move ? !movable : !copyable)
+						return false;
+					if constexpr (container_reserve<T>)
+						c.reserve(static_cast<typename T::size_type>(std::size(c) + count));
+					for (std::size_t i = 0; i < count; i++) {
+						if constexpr (std::is_move_constructible_v<Value> && (container_push_back_rvalue<T> || container_insert_rvalue<T>)) {
+							if (move) {
+								if constexpr (container_push_back_rvalue<T>)
+									c.push_back(std::move(first[i]));
+								else
+									c.insert(std::move(first[i]));
+								continue;
+							}
+						}
+						if constexpr (std::is_copy_constructible_v<Value>) {
+							if constexpr (container_push_back_clvalue<T>)
+								c.push_back(first[i]);
+							else if constexpr (container_insert_clvalue<T>)
+								c.insert(first[i]);
+						}
+					}
+					return true;
+				}
+			};
+		}
+		if constexpr (container_inline_iterator<T>) {
+			using Iterator = decltype(std::begin(std::declval<T&>()));
+			vtable.begin = [](void* obj, void* iter) { new (iter) Iterator{ std::begin(*static_cast<T*>(obj)) }; };
+			vtable.end = [](void* obj, void* iter) { new (iter) Iterator{ std::end(*static_cast<T*>(obj)) }; };
+			vtable.increment = [](void* iter) { ++*static_cast<Iterator*>(iter); };
+			vtable.equal = [](const void* lhs, const void* rhs) {
+				return static_cast<bool>(*static_cast<const Iterator*>(lhs) == *static_cast<const Iterator*>(rhs));
+			};
+			vtable.dereference = [](const void* iter) {
+				return const_cast<void*>(static_cast<const void*>(std::addressof(**static_cast<const Iterator*>(iter))));
+			};
+			if constexpr (!std::is_trivially_copyable_v<Iterator>) {
+				vtable.copy_iterator = [](void* dst, const void* src) { new (dst) Iterator{ *static_cast<const Iterator*>(src) }; };
+				vtable.destroy_iterator = [](void* iter) { static_cast<Iterator*>(iter)->~Iterator(); };
+			}
+		}
+		return vtable;
+	}
+
+	template<typename T>
+	inline constexpr ContainerVTable ContainerVTable_of = GenerateContainerVTable<T>();
+}
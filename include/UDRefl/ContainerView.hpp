@@ -0,0 +1,227 @@
+#pragma once
+
+#include "ContainerVTable.hpp"
+#include "ObjectSpan.hpp"
+
+namespace Ubpa::UDRefl {
+	// iterator of ContainerView, no allocation
+	// - the concrete iterator is stored inline, ++ / == / * call the function pointers of the ContainerVTable
+	// - a default constructed iterator is equal to another one (the begin / end of an unsupported container)
+	class ContainerIterator {
+	public:
+		using value_type = ObjectView;
+		using difference_type = std::ptrdiff_t;
+
+		constexpr ContainerIterator() noexcept = default;
+
+		ContainerIterator(const ContainerIterator& rhs) noexcept : vtable{ rhs.vtable }, element_type{ rhs.element_type } {
+			CopyStorage(rhs);
+		}
+
+		ContainerIterator& operator=(const ContainerIterator& rhs) noexcept {
+			if (this != &rhs) {
+				DestroyStorage();
+				vtable = rhs.vtable;
+				element_type = rhs.element_type;
+				CopyStorage(rhs);
+			}
+			return *this;
+		}
+
+		~ContainerIterator() { DestroyStorage(); }
+
+		ObjectView operator*() const {
+			assert(vtable);
+			return { element_type, vtable->dereference(storage) };
+		}
+
+		ContainerIterator& operator++() {
+			assert(vtable);
+			vtable->increment(storage);
+			return *this;
+		}
+
+		ContainerIterator operator++(int) {
+			ContainerIterator rst = *this;
+			++*this;
+			return rst;
+		}
+
+		bool operator==(const ContainerIterator& rhs) const {
+			if (!vtable || !rhs.vtable)
+				return vtable == rhs.vtable;
+			return vtable->equal(storage, rhs.storage);
+		}
+
+	private:
+		friend class ContainerView;
+		ContainerIterator(const ContainerVTable* vtable, Type element_type) noexcept :
+			vtable{ vtable }, element_type{ element_type } {}
+
+		void CopyStorage(const ContainerIterator& rhs) noexcept {
+			if (vtable && vtable->copy_iterator)
+				vtable->copy_iterator(storage, rhs.storage);
+			else
+				std::memcpy(storage, rhs.storage, ContainerIteratorStorageSize);
+		}
+
+		// the storage is constructed iff vtable isn't nullptr
+		void DestroyStorage() noexcept {
+			if (vtable && vtable->destroy_iterator)
+				vtable->destroy_iterator(storage);
+		}
+
+		const ContainerVTable* vtable{ nullptr };
+		Type element_type;
+		alignas(std::max_align_t) std::uint8_t storage[ContainerIteratorStorageSize]{};
+	};
+
+	// direct access of a container by its ContainerVTable, created by ObjectView::AsContainer()
+	// - no overload resolution and no SharedObject per element (compare to obj.size(), obj[i], ...)
+	// - elements are views of the objects in the container
+	// - invalid (operator bool returns false) if the type isn't a registered container
+	// - modifiers return false / an invalid view if the operation is unsupported or the container is const
+	class ContainerView {
+	public:
+		constexpr ContainerView() noexcept = default;
+		// element_type is the vtable's one, with const if the container is const
+		constexpr ContainerView(ObjectView obj, const ContainerVTable* vtable, Type element_type) noexcept :
+			obj{ obj }, vtable{ vtable }, element_type{ element_type } {}
+
+		constexpr ObjectView GetObject() const noexcept { return obj; }
+		constexpr const ContainerVTable* GetVTable() const noexcept { return vtable; }
+		constexpr Type GetElementType() const noexcept { return element_type; }
+
+		constexpr bool Valid() const noexcept { return vtable != nullptr; }
+		explicit constexpr operator bool() const noexcept { return Valid(); }
+
+		constexpr bool IsConst() const noexcept { return obj.GetType().RemoveReference().IsConst(); }
+		constexpr bool IsContiguous() const noexcept { return vtable && vtable->data; }
+
+		std::size_t Size() const {
+			assert(vtable && vtable->size);
+			return vtable->size(obj.GetPtr());
+		}
+
+		bool Empty() const {
+			assert(vtable && (vtable->empty || vtable->size));
+			return vtable->empty ? vtable->empty(obj.GetPtr()) : vtable->size(obj.GetPtr()) == 0;
+		}
+
+		// nullptr if the elements aren't contiguous
+		void* Data() const { return IsContiguous() ? vtable->data(obj.GetPtr()) : nullptr; }
+
+		// invalid if the elements aren't contiguous
+		ObjectSpan GetContiguousElements() const {
+			if (!IsContiguous())
+				return {};
+			return { element_type, vtable->data(obj.GetPtr()), vtable->size(obj.GetPtr()), vtable->element_size };
+		}
+
+		// contiguous only, no bounds checking
+		ObjectView operator[](std::size_t idx) const {
+			assert(IsContiguous());
+			return { element_type, forward_offset(vtable->data(obj.GetPtr()), idx * vtable->element_size) };
+		}
+
+		// range-for : for (ObjectView element : obj.AsContainer())
+		// begin() == end() if the iterator isn't supported (see ContainerVTable::begin), use ForEach instead
+		constexpr bool IsIterable() const noexcept { return vtable && vtable->begin; }
+
+		ContainerIterator begin() const {
+			if (!IsIterable())
+				return {};
+			ContainerIterator iter{ vtable, element_type };
+			vtable->begin(obj.GetPtr(), iter.storage);
+			return iter;
+		}
+
+		ContainerIterator end() const {
+			if (!IsIterable())
+				return {};
+			ContainerIterator iter{ vtable, element_type };
+			vtable->end(obj.GetPtr(), iter.storage);
+			return iter;
+		}
+
+		// func(ObjectView element), return false if the elements can't be iterated
+		template<typename Func>
+		bool ForEach(Func&& func) const {
+			if (!vtable || !vtable->for_each)
+				return false;
+			struct Context {
+				Func& func;
+				Type element_type;
+			} ctx{ func, element_type };
+			vtable->for_each(
+				obj.GetPtr(),
+				[](void* element, void* ctx) {
+					auto& context = *static_cast<Context*>(ctx);
+					context.func(ObjectView{ context.element_type, element });
+				},
+				&ctx
+			);
+			return true;
+		}
+
+		bool Reserve(std::size_t n) const {
+			if (!vtable || !vtable->reserve || IsConst())
+				return false;
+			vtable->reserve(obj.GetPtr(), n);
+			return true;
+		}
+
+		// new elements are value-initialized
+		bool Resize(std::size_t n) const {
+			if (!vtable || !vtable->resize || IsConst())
+				return false;
+			vtable->resize(obj.GetPtr(), n);
+			return true;
+		}
+
+		// value-initialized element
+		ObjectView EmplaceBack() const {
+			if (!vtable || !vtable->emplace_back || IsConst())
+				return {};
+			return { element_type, vtable->emplace_back(obj.GetPtr()) };
+		}
+
+		bool Clear() const {
+			if (!vtable || !vtable->clear || IsConst())
+				return false;
+			vtable->clear(obj.GetPtr());
+			return true;
+		}
+
+		// append (push_back / insert) the elements of src, which must not alias the container
+		// - the element types (without const) and the strides must be same
+		// - trivially copyable elements are memcpy-ed into resizable contiguous containers
+		// - move : move-construct the elements (src is a const span -> copy)
+		bool AppendRange(ObjectSpan src, bool move = false) const {
+			if (!vtable || !vtable->append || IsConst())
+				return false;
+			if (src.GetElementType().RemoveConst() != vtable->element_type.RemoveConst() || src.GetStride() != vtable->element_size)
+				return false;
+			return vtable->append(obj.GetPtr(), src.GetData(), src.Size(), move && !src.GetElementType().IsConst());
+		}
+
+		// clear, then AppendRange
+		// the container is unchanged if the elements can't be appended
+		bool AssignRange(ObjectSpan src, bool move = false) const {
+			if (!vtable || !vtable->clear || !vtable->append || IsConst())
+				return false;
+			if (src.GetElementType().RemoveConst() != vtable->element_type.RemoveConst() || src.GetStride() != vtable->element_size)
+				return false;
+			move = move && !src.GetElementType().IsConst();
+			if (move ? !vtable->can_move_append : !vtable->can_copy_append)
+				return false;
+			vtable->clear(obj.GetPtr());
+			return vtable->append(obj.GetPtr(), src.GetData(), src.Size(), move);
+		}
+
+	private:
+		ObjectView obj;
+		const ContainerVTable* vtable{ nullptr };
+		Type element_type;
+	};
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Object.hpp"
+
+#include <atomic>
+
+namespace Ubpa::UDRefl {
+	struct TypeInfo;
+
+	// interned records, owned by ReflMngr (addresses are stable until the program ends)
+	// - the name views point to the registries (nregistry / tregistry)
+	// - typeinfo is updated by ReflMngr::RegisterType and ReflMngr::Clear (release),
+	//   TypeHandle::GetTypeInfo() reads it without locks (acquire)
+	struct TypeRecord {
+		TypeRecord(Type type, TypeInfo* typeinfo) noexcept : type{ type }, typeinfo{ typeinfo } {}
+
+		Type type;
+		std::atomic<TypeInfo*> typeinfo;
+	};
+	struct NameRecord {
+		Name name;
+	};
+
+	// 8-byte handle of a Type (a pointer to the TypeRecord), created by ReflMngr::GetTypeHandle
+	// - compare / hash : a pointer compare / hash
+	// - GetTypeInfo() : no hash map lookup
+	// - convertible to Type for the existing APIs
+	class TypeHandle {
+	public:
+		constexpr TypeHandle() noexcept = default;
+		explicit constexpr TypeHandle(const TypeRecord* record) noexcept : record{ record } {}
+
+		constexpr const TypeRecord* GetRecord() const noexcept { return record; }
+		constexpr bool Valid() const noexcept { return record != nullptr; }
+		explicit constexpr operator bool() const noexcept { return Valid(); }
+
+		Type GetType() const noexcept { return record ? record->type : Type{}; }
+		TypeID GetID() const noexcept { return GetType().GetID(); }
+		std::string_view GetName() const noexcept { return GetType().GetName(); }
+		TypeInfo* GetTypeInfo() const noexcept { return record ? record->typeinfo.load(std::memory_order_acquire) : nullptr; }
+
+		operator Type() const noexcept { return GetType(); }
+
+		constexpr bool operator==(const TypeHandle&) const noexcept = default;
+
+	private:
+		const TypeRecord* record{ nullptr };
+	};
+
+	// 8-byte handle of a Name (a pointer to the NameRecord), created by ReflMngr::GetNameHandle
+	class NameHandle {
+	public:
+		constexpr NameHandle() noexcept = default;
+		explicit constexpr NameHandle(const NameRecord* record) noexcept : record{ record } {}
+
+		constexpr const NameRecord* GetRecord() const noexcept { return record; }
+		constexpr bool Valid() const noexcept { return record != nullptr; }
+		explicit constexpr operator bool() const noexcept { return Valid(); }
+
+		Name GetName() const noexcept { return record ? record->name : Name{}; }
+		NameID GetID() const noexcept { return GetName().GetID(); }
+		std::string_view GetView() const noexcept { return GetName().GetView(); }
+
+		operator Name() const noexcept { return GetName(); }
+
+		constexpr bool operator==(const NameHandle&) const noexcept = default;
+
+	private:
+		const NameRecord* record{ nullptr };
+	};
+
+	// 16-byte ObjectView for large arrays of views, convertible to ObjectView
+	// ObjectView itself keeps Type (name view + ID) and the pointer, its Type is part of the public API
+	class CompactObjectView {
+	public:
+		constexpr CompactObjectView() noexcept = default;
+		constexpr CompactObjectView(TypeHandle type, void* ptr) noexcept : type{ type }, ptr{ ptr } {}
+
+		constexpr TypeHandle GetTypeHandle() const noexcept { return type; }
+		constexpr void* GetPtr() const noexcept { return ptr; }
+
+		ObjectView AsObjectView() const noexcept { return { type.GetType(), ptr }; }
+		operator ObjectView() const noexcept { return AsObjectView(); }
+
+		constexpr bool operator==(const CompactObjectView&) const noexcept = default;
+
+	private:
+		TypeHandle type;
+		void* ptr{ nullptr };
+	};
+}
+
+template<>
+struct std::hash<Ubpa::UDRefl::TypeHandle> {
+	std::size_t operator()(const Ubpa::UDRefl::TypeHandle& handle) const noexcept {
+		return std::hash<const void*>()(handle.GetRecord());
+	}
+};
+
+template<>
+struct std::hash<Ubpa::UDRefl::NameHandle> {
+	std::size_t operator()(const Ubpa::UDRefl::NameHandle& handle) const noexcept {
+		return std::hash<const void*>()(handle.GetRecord());
+	}
+};
+
+template<>
+struct std::hash<Ubpa::UDRefl::CompactObjectView> {
+	std::size_t operator()(const Ubpa::UDRefl::CompactObjectView& obj) const noexcept {
+		return std::hash<const void*>()(obj.GetTypeHandle().GetRecord()) ^ std::hash<const void*>()(obj.GetPtr());
+	}
+};
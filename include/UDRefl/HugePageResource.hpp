@@ -0,0 +1,85 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <array>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	// memory resource for large heaps of reflected objects, e.g. Mngr.SetObjectResource(...)
+	// - reserves virtual address ranges (chunks) with mmap (VirtualAlloc on Windows)
+	// - on Linux, chunks are aligned to 2 MiB and advised with madvise(MADV_HUGEPAGE)
+	// - a request (size, alignment) (in ReflMngr, it's TypeInfo::size and TypeInfo::alignment)
+	//   is served by the size class round_up(size, max(alignment, 16)) if it <= MaxSmallSize,
+	//   each class carves slabs from chunks and reuses freed blocks (free list),
+	//   larger requests are mapped directly
+	// - Clear() returns all memory to the OS, all allocated blocks become invalid
+	// thread-safe
+	class UDRefl_core_API HugePageResource : public std::pmr::memory_resource {
+	public:
+		static constexpr std::size_t Granularity = 16;
+		static constexpr std::size_t MaxSmallSize = 4096;
+		static constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+		static constexpr std::size_t DefaultChunkSize = 64 * 1024 * 1024;
+
+		struct Stats {
+			std::size_t reserved_bytes{ 0 };      // chunks + large blocks
+			std::size_t allocated_bytes{ 0 };     // live blocks (by size class)
+			std::size_t peak_allocated_bytes{ 0 };
+			std::size_t num_chunks{ 0 };
+			std::size_t num_large_blocks{ 0 };
+			std::size_t num_allocations{ 0 };     // total
+			std::size_t num_deallocations{ 0 };   // total
+			std::size_t num_reused_blocks{ 0 };   // allocations served by free lists
+			std::size_t num_huge_page_advised{ 0 }; // chunks advised with MADV_HUGEPAGE successfully
+		};
+
+		// chunk_size is rounded up to HugePageSize
+		explicit HugePageResource(std::size_t chunk_size = DefaultChunkSize);
+		HugePageResource(const HugePageResource&) = delete;
+		HugePageResource& operator=(const HugePageResource&) = delete;
+		~HugePageResource();
+
+		// return all memory to the OS
+		void Clear() noexcept;
+
+		Stats GetStats() const;
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		static constexpr std::size_t NumSizeClass = MaxSmallSize / Granularity;
+
+		struct Block {
+			void* ptr;
+			std::size_t size;
+		};
+
+		struct FreeNode {
+			FreeNode* next;
+		};
+
+		struct SizeClass {
+			FreeNode* freelist{ nullptr };
+			std::byte* slab_cursor{ nullptr };
+			std::byte* slab_end{ nullptr };
+		};
+
+		void* CarveSlab(std::size_t bytes, std::size_t alignment);
+
+		const std::size_t chunk_size;
+
+		mutable std::mutex mutex;
+		std::array<SizeClass, NumSizeClass> classes;
+		std::vector<Block> chunks;
+		std::unordered_map<void*, Block> larges; // aligned ptr -> mapped block
+		std::byte* chunk_cursor{ nullptr };
+		std::byte* chunk_end{ nullptr };
+		Stats stats;
+	};
+}
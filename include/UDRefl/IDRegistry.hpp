@@ -31,6 +31,9 @@ namespace Ubpa::UDRefl {
 		void UnregisterUnmanaged(T ID);
 		void Clear() noexcept;
 
+		// bytes of managed names and the table (estimated), in the arena
+		std::size_t GetArenaBytes() const;
+
 	protected:
 		std::pmr::polymorphic_allocator<char> get_allocator() { return &resource; }
 		mutable std::shared_mutex smutex;
@@ -38,6 +41,7 @@ namespace Ubpa::UDRefl {
 	private:
 		std::pmr::monotonic_buffer_resource resource;
 		std::pmr::unordered_map<T, std::string_view> id2name;
+		std::size_t name_bytes{ 0 };
 
 #ifndef NDEBUG
 	public:
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "ContainerVTable.hpp"
 #include "FieldPtr.hpp"
 #include "MethodPtr.hpp"
 
-#include <set>
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <vector>
 
 namespace Ubpa::UDRefl {
 	using Attr = SharedObject;
@@ -13,7 +18,123 @@ namespace Ubpa::UDRefl {
 		bool operator()(const Attr& lhs, const Type& rhs) const noexcept { return lhs.GetType() < rhs;           }
 		bool operator()(const Type& lhs, const Attr& rhs) const noexcept { return lhs           < rhs.GetType(); }
 	};
-	using AttrSet = std::set<Attr, AttrLess>;
+
+	// frequently queried attributes are cached in the slots of AttrSet,
+	// so ReflMngr::GetTypeAttr<A>(type) doesn't search TypeInfo::attrs
+	// - AttrSlot<A>::index == NumAttrSlots means A isn't cached
+	// - AttrSet::insert / erase / clear keep the slots in sync
+	inline constexpr std::size_t NumAttrSlots = 1;
+	template<typename A>
+	struct AttrSlot { static constexpr std::size_t index = NumAttrSlots; };
+	template<>
+	struct AttrSlot<ContainerType> { static constexpr std::size_t index = 0; };
+	// runtime version of AttrSlot, return NumAttrSlots if the type isn't cached
+	UDRefl_core_API std::size_t GetAttrSlotIndex(Type type) noexcept;
+
+	// small flat set of Attr sorted by type
+	// an entity has only a few attributes, so a binary search in contiguous memory beats a tree walk
+	class UDRefl_core_API AttrSet {
+	public:
+		using value_type = Attr;
+		using iterator = std::vector<Attr>::const_iterator;
+		using const_iterator = iterator;
+
+		AttrSet() noexcept = default;
+		AttrSet(std::initializer_list<Attr> ilist) {
+			attrs.reserve(ilist.size());
+			for (const auto& attr : ilist)
+				insert(attr);
+		}
+
+		const_iterator begin() const noexcept { return attrs.begin(); }
+		const_iterator end() const noexcept { return attrs.end(); }
+		std::size_t size() const noexcept { return attrs.size(); }
+		bool empty() const noexcept { return attrs.empty(); }
+		const Attr& operator[](std::size_t i) const noexcept { return attrs[i]; }
+
+		const_iterator lower_bound(Type type) const noexcept { return std::lower_bound(attrs.begin(), attrs.end(), type, AttrLess{}); }
+		const_iterator find(Type type) const noexcept {
+			auto target = lower_bound(type);
+			return target != attrs.end() && target->GetType() == type ? target : attrs.end();
+		}
+		const_iterator find(const Attr& attr) const noexcept { return find(attr.GetType()); }
+		bool contains(Type type) const noexcept { return find(type) != attrs.end(); }
+
+		// the object of the cached attribute (see AttrSlot), nullptr if the set doesn't contain it
+		const void* GetSlot(std::size_t index) const noexcept {
+			assert(index < NumAttrSlots);
+			return slots[index];
+		}
+
+		// if the set already contains an attribute of the same type, do nothing and return false
+		std::pair<const_iterator, bool> insert(Attr attr) {
+			const Type type = attr.GetType();
+			auto target = lower_bound(type);
+			if (target != attrs.end() && target->GetType() == type)
+				return { target, false };
+			auto rst = attrs.insert(target, std::move(attr));
+			if (std::size_t slot = GetAttrSlotIndex(type); slot < NumAttrSlots)
+				slots[slot] = rst->GetPtr();
+			return { rst, true };
+		}
+
+		std::size_t erase(Type type) {
+			auto target = find(type);
+			if (target == attrs.end())
+				return 0;
+			attrs.erase(target);
+			if (std::size_t slot = GetAttrSlotIndex(type); slot < NumAttrSlots)
+				slots[slot] = nullptr;
+			return 1;
+		}
+
+		void clear() noexcept {
+			attrs.clear();
+			slots = {};
+		}
+
+	private:
+		std::vector<Attr> attrs;
+		// pointers to the objects of attrs, the objects are shared, so copies of the set keep them valid
+		std::array<const void*, NumAttrSlots> slots{};
+	};
+
+	// the only empty AttrSet shared by all CompactAttrSet
+	UDRefl_core_API const AttrSet& EmptyAttrSet() noexcept;
+
+	// AttrSet of a field or a method, most of them are empty
+	// it only stores a pointer, and empty sets share EmptyAttrSet()
+	class UDRefl_core_API CompactAttrSet {
+	public:
+		CompactAttrSet() noexcept = default;
+		CompactAttrSet(AttrSet attrs) : set{ attrs.empty() ? nullptr : std::make_unique<AttrSet>(std::move(attrs)) } {}
+		CompactAttrSet(const CompactAttrSet& rhs) : set{ rhs.set ? std::make_unique<AttrSet>(*rhs.set) : nullptr } {}
+		CompactAttrSet(CompactAttrSet&&) noexcept = default;
+		CompactAttrSet& operator=(const CompactAttrSet& rhs) { return *this = CompactAttrSet{ rhs }; }
+		CompactAttrSet& operator=(CompactAttrSet&&) noexcept = default;
+
+		const AttrSet& Get() const noexcept { return set ? *set : EmptyAttrSet(); }
+		operator const AttrSet&() const noexcept { return Get(); }
+
+		// allocate an AttrSet if it's empty
+		AttrSet& GetMutable() {
+			if (!set)
+				set = std::make_unique<AttrSet>();
+			return *set;
+		}
+
+		bool empty() const noexcept { return !set || set->empty(); }
+		std::size_t size() const noexcept { return set ? set->size() : 0; }
+		AttrSet::const_iterator begin() const noexcept { return Get().begin(); }
+		AttrSet::const_iterator end() const noexcept { return Get().end(); }
+		template<typename Key>
+		AttrSet::const_iterator find(const Key& key) const { return Get().find(key); }
+
+		void clear() noexcept { set.reset(); }
+
+	private:
+		std::unique_ptr<AttrSet> set;
+	};
 
 	class UDRefl_core_API BaseInfo {
 	public:
@@ -35,12 +156,20 @@ namespace Ubpa::UDRefl {
 
 	struct UDRefl_core_API FieldInfo {
 		FieldPtr fieldptr;
-		AttrSet attrs;
+		CompactAttrSet attrs; // erase by ReflMngr::RemoveFieldAttr to keep the attr indices in sync
 	};
 
 	struct UDRefl_core_API MethodInfo {
 		MethodPtr methodptr;
-		AttrSet attrs;
+		CompactAttrSet attrs; // erase by ReflMngr::RemoveMethodAttr to keep the attr indices in sync
+	};
+
+	// element of ReflMngr's attribute indices (fields / methods)
+	struct MemberAttrEntry {
+		Type type;
+		Name name;
+
+		bool operator==(const MemberAttrEntry&) const noexcept = default;
 	};
 
 	// trivial : https://docs.microsoft.com/en-us/cpp/cpp/trivial-standard-layout-and-pod-types?view=msvc-160
@@ -53,7 +182,8 @@ namespace Ubpa::UDRefl {
 		std::unordered_map<Name, FieldInfo> fieldinfos;
 		std::unordered_multimap<Name, MethodInfo> methodinfos;
 		std::unordered_map<Type, BaseInfo> baseinfos;
-		AttrSet attrs;
+		AttrSet attrs; // erase by ReflMngr::RemoveTypeAttr to keep the attr indices in sync
+		const ContainerVTable* container_vtable{ nullptr }; // set by ReflMngr::AddContainerVTable
 	};
 }
 
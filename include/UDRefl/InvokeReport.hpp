@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Util.hpp"
+
+#include <array>
+#include <iosfwd>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	// the invoke profiler is enabled by the macro UBPA_UDREFL_ENABLE_PROFILER
+	// (CMake option Ubpa_UDRefl_enable_Profiler), otherwise the hooks in BInvoke / MInvoke / Construct compile to nothing
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+	static constexpr bool InvokeProfilerEnabled = true;
+#else
+	static constexpr bool InvokeProfilerEnabled = false;
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+
+	// BInvoke / MInvoke try the overloads in 4 phases (in order)
+	enum class InvokePhase : std::uint8_t {
+		Exact,       // exact arguments, variable / static methods
+		ExactConst,  // exact arguments, const methods
+		Convert,     // converted arguments, variable / static methods (Construct only uses this phase)
+		ConvertConst // converted arguments, const methods
+	};
+	static constexpr std::size_t NumInvokePhase = 4;
+
+	// stats of a (type, method)
+	struct InvokeStats {
+		std::uint64_t calls{ 0 };           // include failures
+		std::uint64_t failures{ 0 };        // no compatible overload
+		std::uint64_t time_ns{ 0 };         // cumulative, include resolution (nested invocations are included)
+		std::uint64_t overloads_tried{ 0 }; // argument checks (NewArgsGuard)
+		std::array<std::uint64_t, NumInvokePhase> phase_hits{}; // index : InvokePhase
+		std::uint64_t copied_args{ 0 };     // copy-constructed / converted arguments
+		std::uint64_t pointer_array_args{ 0 }; // pointer / array adjusted arguments
+		std::uint64_t derived_args{ 0 };    // derived to base casted arguments
+
+		UDRefl_core_API InvokeStats& operator+=(const InvokeStats& rhs) noexcept;
+	};
+
+	// returned by ReflMngr::GetInvokeReport(), merged from the thread-local counters
+	struct InvokeReport {
+		struct Entry {
+			Type type;   // the object type (ctor for Construct)
+			Name method;
+			InvokeStats stats;
+		};
+
+		std::vector<Entry> entries; // sorted by time_ns (descending)
+
+		UDRefl_core_API InvokeStats Total() const noexcept;
+
+		// header : type,method,calls,failures,time_ns,overloads_tried,exact,exact_const,convert,convert_const,copied_args,pointer_array_args,derived_args
+		UDRefl_core_API void WriteCSV(std::ostream& os) const;
+	};
+
+	// text table
+	UDRefl_core_API std::ostream& operator<<(std::ostream& os, const InvokeReport& report);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Util.hpp"
+
+#include <unordered_map>
+
+namespace Ubpa::UDRefl {
+	// bytes of metadata, returned by ReflMngr::GetMemoryStats()
+	// node-based containers are estimated by their element size plus node overhead,
+	// heap payloads of std::function (captures bigger than its small buffer) aren't counted
+	struct MemoryStats {
+		struct TypeStats {
+			std::size_t typeinfo{ 0 };       // node in typeinfos, baseinfos
+			std::size_t fields{ 0 };         // fieldinfos (exclude dynamic fields)
+			std::size_t methods{ 0 };        // methodinfos (ParamList are interned, see param_lists)
+			std::size_t attrs{ 0 };          // type attrs, field attrs and method attrs (with their objects)
+			std::size_t dynamic_fields{ 0 }; // dynamic shared / buffer fields (with their objects)
+
+			constexpr std::size_t Total() const noexcept {
+				return typeinfo + fields + methods + attrs + dynamic_fields;
+			}
+		};
+
+		std::size_t name_arena{ 0 };     // names and tables in nregistry and tregistry
+		std::size_t param_lists{ 0 };    // interned ParamList shared by all methods
+		std::size_t attr_indices{ 0 };   // inverted attribute indices (attr type -> types / fields / methods)
+		std::size_t typeinfos{ 0 };      // buckets of typeinfos + sum of TypeStats::typeinfo
+		std::size_t fields{ 0 };
+		std::size_t methods{ 0 };
+		std::size_t attrs{ 0 };
+		std::size_t dynamic_fields{ 0 };
+
+		std::unordered_map<Type, TypeStats> types;
+
+		constexpr std::size_t Total() const noexcept {
+			return name_arena + param_lists + attr_indices + typeinfos + fields + methods + attrs + dynamic_fields;
+		}
+	};
+}
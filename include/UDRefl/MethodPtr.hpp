@@ -7,6 +7,18 @@
 namespace Ubpa::UDRefl {
 	using ParamList = std::vector<Type>;
 
+	UDRefl_core_API const ParamList& EmptyParamList() noexcept;
+
+	// many methods share the same signature (e.g. operators of T take (const T&)),
+	// so MethodPtr stores a pointer to an interned ParamList
+	// - empty list -> nullptr
+	// - the returned pointer is valid until the program ends
+	// thread-safe
+	UDRefl_core_API const ParamList* InternParamList(ParamList paramList);
+
+	// bytes of all interned ParamList
+	UDRefl_core_API std::size_t GetInternedParamListBytes() noexcept;
+
 	class UDRefl_core_API MethodPtr {
 	public:
 		using Func = std::function<void(void*, void*, ArgsView)>;
@@ -16,8 +28,9 @@ namespace Ubpa::UDRefl {
 
 		MethodFlag GetMethodFlag() const noexcept { return flag; }
 		const Type& GetResultType() const noexcept { return result_type; }
-		const ParamList& GetParamList() const noexcept { return paramList; }
+		const ParamList& GetParamList() const noexcept { return paramList ? *paramList : EmptyParamList(); }
 
+		// paramLists are interned, so comparing pointers is enough
 		bool IsDistinguishableWith(const MethodPtr& rhs) const noexcept { return flag != rhs.flag || paramList != rhs.paramList; }
 
 		// argTypes[i] == paramList[i] || paramList[i].Is<ObjectView>()
@@ -31,6 +44,6 @@ namespace Ubpa::UDRefl {
 		Func func;
 		MethodFlag flag{ MethodFlag::None };
 		Type result_type;
-		ParamList paramList;
+		const ParamList* paramList{ nullptr }; // interned, nullptr for empty list
 	};
 }
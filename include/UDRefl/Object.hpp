@@ -145,6 +145,15 @@ namespace Ubpa::UDRefl {
 		FieldRange GetFields(FieldFlag flag = FieldFlag::All) const;
 		VarRange GetVars(FieldFlag flag = FieldFlag::All) const;
 
+		//
+		// Container
+		//////////////
+
+		// direct access by the ContainerVTable (no Invoke), include "ContainerView.hpp" to use it
+		ContainerView AsContainer() const;
+		// vector, array, span, raw array, string, ... (invalid if the elements aren't contiguous)
+		ObjectSpan GetContiguousElements() const;
+
 		//////////
 		// Meta //
 		//////////
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Object.hpp"
+
+namespace Ubpa::UDRefl {
+	// contiguous elements of the same type (e.g. of std::vector, std::array, std::span, raw arrays)
+	// - the address of element i is data + i * stride
+	// - created by ObjectView::GetContiguousElements() or from a typed span
+	// - elements are views, the span doesn't own them
+	class ObjectSpan {
+	public:
+		constexpr ObjectSpan() noexcept = default;
+		constexpr ObjectSpan(Type element_type, void* data, std::size_t count, std::size_t stride) noexcept :
+			element_type{ element_type }, data{ data }, count{ count }, stride{ stride } {}
+		template<typename T, std::size_t Extent> requires NonObjectAndView<std::remove_const_t<T>>
+		constexpr ObjectSpan(std::span<T, Extent> elements) noexcept :
+			ObjectSpan{ Type_of<T>, const_cast<void*>(static_cast<const void*>(elements.data())), elements.size(), sizeof(T) } {}
+
+		constexpr Type GetElementType() const noexcept { return element_type; }
+		constexpr void* GetData() const noexcept { return data; }
+		constexpr std::size_t GetStride() const noexcept { return stride; }
+		constexpr std::size_t Size() const noexcept { return count; }
+		constexpr std::size_t SizeBytes() const noexcept { return count * stride; }
+		constexpr bool Empty() const noexcept { return count == 0; }
+
+		constexpr bool Valid() const noexcept { return element_type.Valid(); }
+		explicit constexpr operator bool() const noexcept { return Valid(); }
+
+		// no bounds checking
+		constexpr ObjectView operator[](std::size_t idx) const noexcept {
+			assert(idx < count);
+			return { element_type, forward_offset(data, idx * stride) };
+		}
+
+		constexpr ObjectSpan Subspan(std::size_t offset, std::size_t n) const noexcept {
+			assert(offset + n <= count);
+			return { element_type, forward_offset(data, offset * stride), n, stride };
+		}
+
+		// typed view for bulk algorithms (memcpy, SIMD kernels, ...)
+		// T must be the element type (include const)
+		template<typename T>
+		std::span<T> As() const noexcept {
+			assert(element_type.Is<T>() && stride == sizeof(T));
+			return { static_cast<T*>(data), count };
+		}
+
+	private:
+		Type element_type;
+		void* data{ nullptr };
+		std::size_t count{ 0 };
+		std::size_t stride{ 0 };
+	};
+}
@@ -1,6 +1,13 @@
 #pragma once
 
+#include "ContainerVTable.hpp"
+#include "Handle.hpp"
 #include "Info.hpp"
+#include "InvokeReport.hpp"
+#include "Trace.hpp"
+#include "MemoryStats.hpp"
+
+#include <shared_mutex>
 
 namespace Ubpa::UDRefl {
 	constexpr Type GlobalType = TypeIDRegistry::Meta::global;
@@ -27,13 +34,49 @@ namespace Ubpa::UDRefl {
 		SharedObject GetFieldAttr(Type type, Name field_name, Type attr_type) const;
 		SharedObject GetMethodAttr(Type type, Name method_name, Type attr_type) const;
 
+		// inverted attribute indices : attribute type -> types / fields / methods carrying it, O(1)
+		// - updated by AddTypeAttr, AddFieldAttr, AddMethodAttr and by AddField / AddMethod with attrs,
+		//   entries are erased by RemoveTypeAttr, RemoveFieldAttr, RemoveMethodAttr
+		// - erasing from TypeInfo::attrs / FieldInfo::attrs / MethodInfo::attrs directly leaves stale entries
+		// - spans are invalidated by the next registration of an attribute of the same type
+		std::span<const Type>            GetTypesWithAttr  (Type attr_type) const;
+		std::span<const MemberAttrEntry> GetFieldsWithAttr (Type attr_type) const;
+		std::span<const MemberAttrEntry> GetMethodsWithAttr(Type attr_type) const;
+
+		// compact handles (see Handle.hpp), records are interned on the first call
+		// the name is registered in tregistry / nregistry, the type needn't be registered
+		// thread-safe
+		TypeHandle GetTypeHandle(Type type) const;
+		NameHandle GetNameHandle(Name name) const;
+
+		// nullptr if the type or the attribute doesn't exist
+		// O(1) for attributes cached in slots (see AttrSlot), else a binary search in the type's AttrSet
+		template<typename A>
+		const A* GetTypeAttr(Type type) const;
+
 		void SetTemporaryResource(std::shared_ptr<std::pmr::memory_resource> rsrc);
 		void SetObjectResource(std::shared_ptr<std::pmr::memory_resource> rsrc);
 
 		std::pmr::memory_resource* GetTemporaryResource() const { return temporary_resource.get(); }
 		std::pmr::memory_resource* GetObjectResource() const { return object_resource.get(); }
 
+		// O(#type + #field + #method + #attr), metadata only (objects aren't counted)
+		MemoryStats GetMemoryStats() const;
+
+		// merge the thread-local counters of the invoke profiler (see InvokeProfilerEnabled)
+		// empty if the profiler is disabled
+		InvokeReport GetInvokeReport() const;
+		void ResetInvokeReport();
+
+		// timeline of Invoke / Construct / MNew / MDelete / RegisterType (see TraceEnabled)
+		// - StartTrace drops the previous events, each thread keeps at most capacity_per_thread latest events
+		// - WriteTrace outputs Chrome trace-event JSON (chrome://tracing, Perfetto), call it after StopTrace
+		void StartTrace(std::size_t capacity_per_thread = 1 << 16);
+		void StopTrace();
+		void WriteTrace(std::ostream& os) const;
+
 		// clear order
+		// - attr indices
 		// - field attrs
 		// - type attrs
 		// - type dynamic shared field
@@ -124,11 +167,26 @@ namespace Ubpa::UDRefl {
 		bool AddTypeAttr(Type type, Attr attr);
 		bool AddFieldAttr(Type type, Name field_name, Attr attr);
 		bool AddMethodAttr(Type type, Name method_name, Attr attr);
+		// keep the attribute indices in sync (see GetTypesWithAttr), false if the attribute doesn't exist
+		// RemoveMethodAttr erases the attribute of all overloads
+		bool RemoveTypeAttr(Type type, Type attr_type);
+		bool RemoveFieldAttr(Type type, Name field_name, Type attr_type);
+		bool RemoveMethodAttr(Type type, Name method_name, Type attr_type);
 		
 		Name AddTrivialDefaultConstructor(Type type);
 		Name AddTrivialCopyConstructor   (Type type);
+		Name AddTrivialMoveConstructor   (Type type);
+		// operator= (const T&) with memcpy of the whole size, for trivially copy assignable types
+		// which are final or POD (their tail padding can't hold the members of derived types)
+		Name AddTrivialCopyAssignment    (Type type);
 		Name AddZeroDefaultConstructor   (Type type);
 		Name AddDefaultConstructor       (Type type);
+		// store vtable in the TypeInfo for ObjectView::AsContainer(), no method is registered
+		// vtable must outlive ReflMngr (e.g. ContainerVTable_of<T>)
+		bool AddContainerVTable(Type type, const ContainerVTable* vtable);
+		// register container methods (empty, size) with the thunks shared by all containers,
+		// call it after AddContainerVTable
+		bool AddContainerVTableMethods(Type type);
 		Name AddDestructor               (Type type);
 
 		// - data-driven
@@ -148,6 +206,26 @@ namespace Ubpa::UDRefl {
 			bool is_trivial = false
 		);
 
+		// require
+		// - same as above
+		// - field_attrs.empty() || field_attrs.size() == field_names.size()
+		// - min_alignment is a power of 2 (e.g. 64 for a cache line)
+		// auto compute
+		// - same as above, fields are placed according to layout_policy
+		// - alignment of type is at least min_alignment
+		// - if layout_policy is HotCold, the first cold field starts at a min_alignment boundary
+		// fields get attrs in field_attrs
+		Type RegisterType(
+			Type type,
+			std::span<const Type> bases,
+			std::span<const Type> field_types,
+			std::span<const Name> field_names,
+			std::span<const AttrSet> field_attrs,
+			FieldLayoutPolicy layout_policy,
+			size_t min_alignment = 1,
+			bool is_trivial = false
+		);
+
 		// -- template --
 
 		// call
@@ -157,6 +235,13 @@ namespace Ubpa::UDRefl {
 		template<typename T>
 		void RegisterType();
 
+		// same as RegisterType<T>(), but the meta method groups of T are selected by Flags
+		// (instead of details::TypeAutoRegister<T> and AutoRegisterPolicy<T>)
+		// e.g. RegisterType<T, AutoRegisterFlag::None>() for types that only need field access
+		// dependent types (pointee, elements, ...) use their own policies
+		template<typename T, AutoRegisterFlag Flags>
+		void RegisterType();
+
 		// get TypeID from field_data
 		// field_data can be
 		// 1. member object pointer
@@ -360,10 +445,24 @@ namespace Ubpa::UDRefl {
 
 		template<typename... Args> bool IsConstructible(Type type) const;
 
+		//
+		// Container
+		//////////////
+		//
+		// bulk operations by the ContainerVTable, see ContainerView::AppendRange / AssignRange
+		//
+
+		bool AppendRange(ObjectView container, ObjectSpan src, bool move = false) const;
+		bool AssignRange(ObjectView container, ObjectSpan src, bool move = false) const;
+
 	private:
 		ReflMngr();
 		~ReflMngr();
 
+		// shared body of RegisterType<T>() and RegisterType<T, Flags>(), T is without cvref
+		template<typename T, typename AutoRegister>
+		void RegisterTypeImpl();
+
 		// for
 		// - argument copy
 		// - user argument buffer
@@ -372,6 +471,18 @@ namespace Ubpa::UDRefl {
 		// for
 		// - New/MakeShared
 		std::shared_ptr<std::pmr::memory_resource> object_resource;
+
+		// interned records of TypeHandle / NameHandle, nodes are never erased
+		mutable std::shared_mutex handle_mutex;
+		mutable std::unordered_map<TypeID, TypeRecord> typerecords;
+		// TypeID without cvref -> records of its cvref variants, their typeinfo is updated by RegisterType
+		mutable std::unordered_multimap<TypeID, TypeRecord*> typerecord_aliases;
+		mutable std::unordered_map<NameID, NameRecord> namerecords;
+
+		// attr type -> entries
+		std::unordered_map<Type, std::vector<Type>> typeattr_index;
+		std::unordered_map<Type, std::vector<MemberAttrEntry>> fieldattr_index;
+		std::unordered_map<Type, std::vector<MemberAttrEntry>> methodattr_index;
 	};
 
 	inline static ReflMngr& Mngr = ReflMngr::Instance();
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Object.hpp"
+
+#include <memory_resource>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	class MethodPtr;
+
+	// memory resource for request-scoped objects
+	// - pass it as rsrc / rst_rsrc to MNew, MMakeShared and MInvoke
+	// - memory is carved from a monotonic buffer, deallocate does nothing
+	// - objects which need destruction (with a registered dtor) are recorded by ReflMngr,
+	//   they are destructed in reverse order and then memory is released in one sweep in Release() / dtor
+	// - MDelete and the deleter of SharedObject don't destruct the object, the arena does
+	// - objects must not be used after Release()
+	// - ReflMngr finds arenas by FromResource, no RTTI
+	// not thread-safe
+	class UDRefl_core_API ScopedObjectArena : public std::pmr::memory_resource {
+	public:
+		explicit ScopedObjectArena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		ScopedObjectArena(std::size_t initial_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		ScopedObjectArena(const ScopedObjectArena&) = delete;
+		ScopedObjectArena& operator=(const ScopedObjectArena&) = delete;
+		~ScopedObjectArena();
+
+		// record obj if it needs destruction, return true if recorded
+		// obj's memory should be allocated from this arena
+		bool Track(ObjectView obj);
+
+		// destruct all recorded objects, then release all memory
+		void Release();
+
+		std::size_t GetTrackedNum() const noexcept { return entries.size(); }
+		std::pmr::memory_resource* GetUpstreamResource() const noexcept { return buffer.upstream_resource(); }
+
+		// rsrc as an arena, nullptr if it isn't an arena
+		// live arenas are registered by their ctor / dtor, an atomic load if there is no arena,
+		// otherwise a lookup in the registry (shared lock)
+		static ScopedObjectArena* FromResource(std::pmr::memory_resource* rsrc) noexcept;
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void*, std::size_t, std::size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		struct Entry {
+			const MethodPtr* dtor;
+			void* ptr;
+		};
+
+		std::pmr::monotonic_buffer_resource buffer;
+		std::pmr::vector<Entry> entries;
+	};
+}
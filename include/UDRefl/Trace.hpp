@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Util.hpp"
+
+#include <iosfwd>
+
+namespace Ubpa::UDRefl {
+	// the tracer is enabled by the macro UBPA_UDREFL_ENABLE_TRACE
+	// (CMake option Ubpa_UDRefl_enable_Trace), otherwise TraceScope is an empty class
+	// usage: Mngr.StartTrace(), ..., Mngr.StopTrace(), Mngr.WriteTrace(os)
+#ifdef UBPA_UDREFL_ENABLE_TRACE
+	static constexpr bool TraceEnabled = true;
+#else
+	static constexpr bool TraceEnabled = false;
+#endif // UBPA_UDREFL_ENABLE_TRACE
+
+	enum class TraceEvent : std::uint8_t {
+		Invoke,      // BInvoke / MInvoke (include Invoke)
+		Construct,
+		MNew,
+		MDelete,
+		RegisterType // template and data-driven RegisterType
+	};
+
+	namespace details {
+		// when tracing, each thread records complete events (begin + duration) into its own ring buffer
+		// - only the owner thread writes (lock-free), old events are overwritten when it is full
+		// - an event is dropped if the tracer stopped before it ends, or restarted after it began
+		// - WriteTrace skips the events being overwritten (see TraceSlot in Trace.cpp)
+		// - the type and the name are stored as IDs, resolved by the registries when writing
+		UDRefl_core_API bool TraceIsRecording() noexcept;
+		UDRefl_core_API std::uint64_t TraceNow() noexcept;
+		UDRefl_core_API void TraceRecord(TraceEvent event, TypeID type, NameID name, std::uint64_t begin, std::uint64_t end) noexcept;
+	}
+
+#ifdef UBPA_UDREFL_ENABLE_TRACE
+	// records an event from its construction to its destruction (if the tracer is recording)
+	class TraceScope {
+	public:
+		TraceScope(TraceEvent event, Type type, Name name = {}) noexcept :
+			recording{ details::TraceIsRecording() },
+			event{ event }, type{ type.GetID() }, name{ name.GetID() },
+			begin{ recording ? details::TraceNow() : 0 } {}
+
+		~TraceScope() {
+			if (recording)
+				details::TraceRecord(event, type, name, begin, details::TraceNow());
+		}
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+	private:
+		bool recording;
+		TraceEvent event;
+		TypeID type;
+		NameID name;
+		std::uint64_t begin;
+	};
+#else
+	class TraceScope {
+	public:
+		constexpr TraceScope(TraceEvent, Type, Name = {}) noexcept {}
+	};
+#endif // UBPA_UDREFL_ENABLE_TRACE
+}
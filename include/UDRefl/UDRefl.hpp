@@ -2,15 +2,25 @@
 
 #include "Basic.hpp"
 #include "config.hpp"
+#include "ContainerView.hpp"
+#include "ContainerVTable.hpp"
 #include "FieldPtr.hpp"
+#include "Handle.hpp"
+#include "HugePageResource.hpp"
 #include "IDRegistry.hpp"
 #include "Info.hpp"
+#include "InvokeReport.hpp"
+#include "MemoryStats.hpp"
 #include "MethodPtr.hpp"
 #include "Object.hpp"
+#include "ObjectSpan.hpp"
 #include "ReflMngr.hpp"
+#include "ScopedObjectArena.hpp"
+#include "Trace.hpp"
 #include "Util.hpp"
 
 #include "attrs/ContainerType.hpp"
+#include "attrs/FieldTemperature.hpp"
 
 #include "ranges/common.hpp"
 #include "ranges/FieldRange.hpp"
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../Util.hpp"
+
+namespace Ubpa::UDRefl {
+	// field attr, used by FieldLayoutPolicy::HotCold in data-driven RegisterType
+	// - Hot fields are placed at the front of the type
+	// - Cold fields are placed after all hot fields
+	// a field without this attr is regarded as Hot
+	enum class FieldTemperature {
+		Hot,
+		Cold
+	};
+}
@@ -17,6 +17,16 @@
 // #define UBPA_UDREFL_INCLUDE_ALL_STD_NAME
 #endif // UBPA_UDREFL_INCLUDE_ALL_STD_NAME
 
+// use it in "InvokeReport.hpp"
+#ifndef UBPA_UDREFL_ENABLE_PROFILER
+// #define UBPA_UDREFL_ENABLE_PROFILER
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+
+// use it in "Trace.hpp"
+#ifndef UBPA_UDREFL_ENABLE_TRACE
+// #define UBPA_UDREFL_ENABLE_TRACE
+#endif // UBPA_UDREFL_ENABLE_TRACE
+
 namespace Ubpa::UDRefl {
     static constexpr std::size_t MaxArgNum = 64;
     static_assert(MaxArgNum <= 256 - 2);
@@ -61,6 +61,7 @@ namespace Ubpa::UDRefl {
 		buffer[name.size()] = 0;
 
 		std::string_view new_name{ buffer, name.size() };
+		name_bytes += name.size() + 1;
 
 		id2name.emplace_hint(target, ID, new_name); // target is thread-safe
 
@@ -101,6 +102,23 @@ namespace Ubpa::UDRefl {
 		unmanagedIDs.clear();
 #endif // !NDEBUG
 		resource.release();
+		name_bytes = 0;
+	}
+
+	template<typename T, typename U>
+	std::size_t IDRegistry<T, U>::GetArenaBytes() const {
+		// node : next + hash + (ID, name)
+		constexpr std::size_t node_size = 2 * sizeof(void*) + sizeof(std::pair<const T, std::string_view>);
+
+		std::shared_lock rlock{ smutex };
+		std::size_t bytes = name_bytes
+			+ id2name.size() * node_size
+			+ id2name.bucket_count() * sizeof(void*);
+#ifndef NDEBUG
+		bytes += unmanagedIDs.size() * (2 * sizeof(void*) + sizeof(T))
+			+ unmanagedIDs.bucket_count() * sizeof(void*);
+#endif // !NDEBUG
+		return bytes;
 	}
 
 #ifndef NDEBUG
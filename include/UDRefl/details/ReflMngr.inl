@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -256,102 +257,122 @@ namespace Ubpa::UDRefl::details {
 		register_ctor_impl<T, TypeList<>, Args...>::run(mngr);
 	}
 
-	template<template<typename>class get_size, std::size_t TargetIdx, typename T>
-	ObjectView runtime_get_impl(T&& obj, std::size_t i) {
-		using U = std::remove_cvref_t<T>;
-		if constexpr (TargetIdx == get_size<U>::value)
-			return {};
-		else {
-			if (i == TargetIdx)
-				return ObjectView{ std::get<TargetIdx>(std::forward<T>(obj)) };
-			else
-				return runtime_get_impl<get_size, TargetIdx + 1>(std::forward<T>(obj), i);
+	// TypeID -> the first index of the type in Ts, O(1) open addressing table built at compile time
+	// used by the tuple get(Type), variants look up by index() (see runtime_variant_holds_alternative)
+	template<typename... Ts>
+	struct TypeIndexTable {
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+		static constexpr std::size_t capacity = std::bit_ceil(2 * sizeof...(Ts) + 1);
+
+		struct Slot {
+			std::size_t id{ TypeID::InvalidValue() };
+			std::size_t index{ npos };
+		};
+
+		static constexpr std::array<Slot, capacity> slots = [] {
+			std::array<Slot, capacity> slots{};
+			constexpr std::array<std::size_t, sizeof...(Ts)> ids = { TypeID_of<Ts>.GetValue()... };
+			for (std::size_t i = 0; i < ids.size(); i++) {
+				std::size_t k = ids[i] & (capacity - 1);
+				while (slots[k].index != npos && slots[k].id != ids[i])
+					k = (k + 1) & (capacity - 1);
+				if (slots[k].index == npos)
+					slots[k] = { ids[i], i };
+			}
+			return slots;
+		}();
+
+		static constexpr std::size_t Find(TypeID id) noexcept {
+			std::size_t k = id.GetValue() & (capacity - 1);
+			while (slots[k].index != npos) {
+				if (slots[k].id == id.GetValue())
+					return slots[k].index;
+				k = (k + 1) & (capacity - 1);
+			}
+			return npos;
 		}
-	}
+	};
+
+	template<template<std::size_t, typename>class get_type, typename U, std::size_t... Ns>
+	TypeIndexTable<typename get_type<Ns, U>::type...> type_index_table_of(std::index_sequence<Ns...>);
+	template<template<typename>class get_size, template<std::size_t, typename>class get_type, typename U>
+	using TypeIndexTable_of = decltype(type_index_table_of<get_type, U>(std::make_index_sequence<get_size<U>::value>{}));
 
+	// jump table of std::get<I> (I : [0, get_size<U>::value)), T maybe const
+	template<typename T, std::size_t... Ns>
+	constexpr auto runtime_get_table(std::index_sequence<Ns...>) noexcept {
+		using Getter = ObjectView(*)(T&);
+		return std::array<Getter, sizeof...(Ns)>{ [](T& obj) { return ObjectView{ std::get<Ns>(obj) }; }... };
+	}
 	template<template<typename>class get_size, typename T>
-	ObjectView runtime_get(T&& obj, std::size_t i) {
-		using U = std::remove_cvref_t<T>;
-		assert(i < get_size<U>::value);
-		return runtime_get_impl<get_size, 0>(std::forward<T>(obj), i);
+	inline constexpr auto runtime_get_table_v = runtime_get_table<T>(std::make_index_sequence<get_size<std::remove_const_t<T>>::value>{});
+
+	// jump table of get_type<I, U>::type
+	template<template<std::size_t, typename>class get_type, typename U, std::size_t... Ns>
+	constexpr std::array<Type, sizeof...(Ns)> runtime_type_table(std::index_sequence<Ns...>) noexcept {
+		return { Type_of<typename get_type<Ns, U>::type>... };
 	}
 
-	template<template<typename>class get_size, template<std::size_t, typename>class get_type, std::size_t TargetIdx, typename T>
-	ObjectView runtime_get_impl(T&& obj, const Type & type) {
+	template<template<typename>class get_size, typename T>
+	ObjectView runtime_get(T&& obj, std::size_t i) {
 		using U = std::remove_cvref_t<T>;
-		if constexpr (TargetIdx == get_size<U>::value)
+		// out of range, or variant_npos of a valueless variant
+		if (i >= get_size<U>::value)
 			return {};
-		else {
-			if (type == Type_of<typename get_type<TargetIdx, U>::type>)
-				return ObjectView{ std::get<TargetIdx>(std::forward<T>(obj)) };
-			else
-				return runtime_get_impl<get_size, get_type, TargetIdx + 1>(std::forward<T>(obj), type);
-		}
+		return runtime_get_table_v<get_size, std::remove_reference_t<T>>[i](obj);
 	}
 
 	template<template<typename>class get_size, template<std::size_t, typename>class get_type, typename T>
 	ObjectView runtime_get(T&& obj, const Type& type) {
-		return runtime_get_impl<get_size, get_type, 0>(std::forward<T>(obj), type);
-	}
-
-	template<std::size_t TargetIdx, typename T>
-	Type runtime_tuple_element_impl(std::size_t i) noexcept {
-		if constexpr (TargetIdx == std::tuple_size_v<T>)
+		using U = std::remove_cvref_t<T>;
+		using Table = TypeIndexTable_of<get_size, get_type, U>;
+		const std::size_t i = Table::Find(type.GetID());
+		if (i == Table::npos)
 			return {};
-		else {
-			if (i == TargetIdx)
-				return Type_of<std::tuple_element_t<TargetIdx, T>>;
-			else
-				return runtime_tuple_element_impl<TargetIdx + 1, T>(i);
-		}
+		return runtime_get_table_v<get_size, std::remove_reference_t<T>>[i](obj);
 	}
 
 	template<typename T>
 	Type runtime_tuple_element(std::size_t i) noexcept {
+		static constexpr auto table = runtime_type_table<std::tuple_element, T>(std::make_index_sequence<std::tuple_size_v<T>>{});
 		assert(i < std::tuple_size_v<T>);
-		return runtime_tuple_element_impl<0, T>(i);
+		return table[i];
 	}
 
 	template<typename T, std::size_t... Ns>
-	void register_tuple_elements(ReflMngr& mngr, std::index_sequence<Ns...>) {
+	void register_tuple_element_types(ReflMngr& mngr, std::index_sequence<Ns...>) {
 		(mngr.RegisterType<std::tuple_element_t<Ns, T>>(), ...);
-		register_ctor<T, std::tuple_element_t<Ns, T>...>(mngr);
 	}
 
-	template<std::size_t TargetIdx, typename T>
-	bool runtime_variant_holds_alternative_impl(const T& obj, const Type& type) noexcept {
-		if constexpr (TargetIdx == std::variant_size_v<T>)
-			return false;
-		else {
-			using Elem = std::variant_alternative_t<TargetIdx, T>;
-			if (type == Type_of<Elem>)
-				return std::holds_alternative<Elem>(obj);
-			else
-				return runtime_variant_holds_alternative_impl<TargetIdx + 1>(obj, type);
-		}
+	template<typename T, std::size_t... Ns>
+	void register_tuple_elements(ReflMngr& mngr, std::index_sequence<Ns...>) {
+		register_ctor<T, std::tuple_element_t<Ns, T>...>(mngr);
 	}
 
+	template<typename T>
+	inline constexpr auto runtime_variant_type_table_v = runtime_type_table<std::variant_alternative, T>(std::make_index_sequence<std::variant_size_v<T>>{});
+
+	// compare type with the active alternative, so repeated alternatives (e.g. std::variant<int, int>) work
 	template<typename T>
 	bool runtime_variant_holds_alternative(const T& obj, const Type& type) noexcept {
-		return runtime_variant_holds_alternative_impl<0>(obj, type);
+		const std::size_t i = obj.index();
+		// variant_npos of a valueless variant
+		return i < std::variant_size_v<T> && runtime_variant_type_table_v<T>[i].GetID() == type.GetID();
 	}
 
-	template<std::size_t TargetIdx, typename T>
-	Type runtime_variant_alternative_impl(std::size_t i) {
-		if constexpr (TargetIdx == std::variant_size_v<T>)
+	// the active alternative if its type is type, otherwise nullptr
+	template<typename T>
+	ObjectView runtime_variant_get(T& obj, const Type& type) {
+		using U = std::remove_const_t<T>;
+		if (!runtime_variant_holds_alternative<U>(obj, type))
 			return {};
-		else {
-			if (i == TargetIdx)
-				return Type_of<std::variant_alternative_t<TargetIdx, T>>;
-			else
-				return runtime_variant_alternative_impl<TargetIdx + 1, T>(i);
-		}
+		return runtime_get_table_v<std::variant_size, T>[obj.index()](obj);
 	}
 
 	template<typename T>
 	Type runtime_variant_alternative(std::size_t i) {
 		assert(i < std::variant_size_v<T>);
-		return runtime_variant_alternative_impl<0, T>(i);
+		return runtime_variant_type_table_v<T>[i];
 	}
 
 	template<typename T, std::size_t Idx>
@@ -371,522 +392,627 @@ namespace Ubpa::UDRefl::details {
 	}
 
 	template<typename T, std::size_t... Ns>
-	void register_variant_alternatives(ReflMngr& mngr, std::index_sequence<Ns...>) {
+	void register_variant_alternative_types(ReflMngr& mngr, std::index_sequence<Ns...>) {
 		(mngr.RegisterType<std::variant_alternative_t<Ns, T>>(), ...);
+	}
+
+	template<typename T, std::size_t... Ns>
+	void register_variant_alternatives(ReflMngr& mngr, std::index_sequence<Ns...>) {
 		(register_variant_ctor_assign<T, Ns>(mngr), ...);
 	}
 
-	template<typename T>
+	template<typename T, AutoRegisterFlag Flags = AutoRegisterPolicy<T>::flags>
 	struct TypeAutoRegister_Default {
 		static void run(ReflMngr& mngr) {
-			if constexpr (std::is_default_constructible_v<T> && !std::is_trivial_v<T>)
-				mngr.AddConstructor<T>();
-			if constexpr (type_ctor_copy<T> && !std::is_trivial_v<T>)
-				mngr.AddConstructor<T, const T&>();
-			if constexpr (type_ctor_move<T> && !std::is_trivial_v<T>)
-				mngr.AddConstructor<T, T&&>();
-			if constexpr (std::is_destructible_v<T> && !std::is_trivial_v<T>)
-				mngr.AddDestructor<T>();
-
-			if constexpr (std::is_pointer_v<T>) {
-				mngr.RegisterType<std::remove_pointer_t<T>>();
-				if constexpr (std::is_const_v<std::remove_pointer_t<T>>)
+			// lifecycle
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::Lifecycle)) {
+				// trivially copyable types share the memcpy thunks (see ReflMngr::AddTrivial*)
+				if constexpr (std::is_default_constructible_v<T> && !std::is_trivial_v<T>)
+					mngr.AddConstructor<T>();
+				if constexpr (type_ctor_copy<T> && !std::is_trivial_v<T>) {
+					if constexpr (std::is_trivially_copy_constructible_v<T>)
+						mngr.AddTrivialCopyConstructor(Type_of<T>);
+					else
+						mngr.AddConstructor<T, const T&>();
+				}
+				if constexpr (type_ctor_move<T> && !std::is_trivial_v<T>) {
+					if constexpr (std::is_trivially_move_constructible_v<T>)
+						mngr.AddTrivialMoveConstructor(Type_of<T>);
+					else
+						mngr.AddConstructor<T, T&&>();
+				}
+				if constexpr (std::is_pointer_v<T> && std::is_const_v<std::remove_pointer_t<T>>)
 					mngr.AddConstructor<T, const std::add_pointer_t<std::remove_const_t<std::remove_pointer_t<T>>> &>();
+
+				if constexpr (std::is_array_v<T> && std::rank_v<T> == 0) {
+					using Ele = std::remove_extent_t<T>;
+					mngr.AddConstructor<T, const std::add_pointer_t<Ele>&>();
+					if constexpr (std::is_const_v<Ele>)
+						mngr.AddConstructor<T, const std::add_pointer_t<std::remove_const_t<Ele>>&>();
+				}
+
+				if constexpr (operator_assignment_copy<T>) {
+					// a base subobject may share its tail padding with the members of the derived type
+					if constexpr (std::is_trivially_copy_assignable_v<T>
+						&& (std::is_final_v<T> || (std::is_trivial_v<T> && std::is_standard_layout_v<T>)))
+					{
+						mngr.AddTrivialCopyAssignment(Type_of<T>);
+					}
+					else
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment, [](T& lhs, const T& rhs) -> T& { return lhs = rhs; });
+				}
+				if constexpr (operator_assignment_move<T> && (!std::is_trivially_move_assignable_v<T> || !std::is_trivially_copy_assignable_v<T>))
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment, [](T& lhs, T&& rhs) -> T& { return lhs = std::move(rhs); });
 			}
 
-			if constexpr (operator_bool<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bool, [](const T& obj) { return static_cast<bool>(obj); });
+			// owned objects must be destroyable
+			if constexpr (std::is_destructible_v<T> && !std::is_trivially_destructible_v<T>)
+				mngr.AddDestructor<T>();
 
-			if constexpr (operator_plus<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_add, [](const T& lhs) { return +lhs; });
-			if constexpr (operator_minus<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_sub, [](const T& lhs) { return -lhs; });
+			if constexpr (std::is_pointer_v<T>)
+				mngr.RegisterType<std::remove_pointer_t<T>>();
 
-			if constexpr (std::is_array_v<T> && std::rank_v<T> == 0) {
-				using Ele = std::remove_extent_t<T>;
-				mngr.AddConstructor<T, const std::add_pointer_t<Ele>&>();
-				if constexpr (std::is_const_v<Ele>)
-					mngr.AddConstructor<T, const std::add_pointer_t<std::remove_const_t<Ele>>&>();
+			// element types, independent of the flags
+			if constexpr (std::is_array_v<T>)
+				mngr.RegisterType<std::remove_extent_t<T>>();
+			else {
+				if constexpr (container_key_type<T>)
+					mngr.RegisterType<typename T::key_type>();
+				if constexpr (container_mapped_type<T>)
+					mngr.RegisterType<typename T::mapped_type>();
+				if constexpr (container_value_type<T>)
+					mngr.RegisterType<typename T::value_type>();
+			}
+			// ContainerView, ObjectSpan and the ext serializers rely on the vtable, only the Meta::container_* methods are opt-out
+			if constexpr (container_empty<T> || container_size<T> || container_object_elements<T>)
+				mngr.AddContainerVTable(Type_of<T>, &ContainerVTable_of<T>);
+			if constexpr (IsPair<T>) {
+				mngr.RegisterType<typename T::first_type>();
+				mngr.RegisterType<typename T::second_type>();
+			}
+			if constexpr (IsTuple<T> && !IsArray<T>)
+				register_tuple_element_types<T>(mngr, std::make_index_sequence<std::tuple_size_v<T>>{});
+			if constexpr (IsVariant<T>)
+				register_variant_alternative_types<T>(mngr, std::make_index_sequence<std::variant_size_v<T>>{});
+
+			// arithmetic, bitwise, increment / decrement and compound assignment
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::Arithmetic)) {
+				if constexpr (operator_bool<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bool, [](const T& obj) { return static_cast<bool>(obj); });
+
+				if constexpr (operator_plus<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_add, [](const T& lhs) { return +lhs; });
+				if constexpr (operator_minus<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_sub, [](const T& lhs) { return -lhs; });
+
+				if constexpr (operator_add<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_add, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs + rhs; });
+				if constexpr (operator_sub<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_sub, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs - rhs; });
+				if constexpr (operator_mul<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_mul, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs * rhs; });
+				if constexpr (operator_div<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_div, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs / rhs; });
+				if constexpr (operator_mod<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_mod, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs % rhs; });
+
+				if constexpr (operator_bnot<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bnot, [](const T& lhs) -> decltype(auto) { return ~lhs; });
+				if constexpr (operator_band<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_band, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs & rhs; });
+				if constexpr (operator_bor<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bor, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs & rhs; });
+				if constexpr (operator_bxor<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bxor, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs & rhs; });
+				if constexpr (operator_shl<const T&, const std::size_t&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](const T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs << rhs; });
+				if constexpr (operator_shr<const T&, const std::size_t&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs >> rhs; });
+
+				if constexpr (operator_pre_inc<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_pre_inc, [](T& lhs) -> decltype(auto) { return ++lhs; });
+				if constexpr (operator_post_inc<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_post_inc, [](T& lhs) -> decltype(auto) { return lhs++; });
+				if constexpr (operator_pre_dec<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_pre_dec, [](T& lhs) -> decltype(auto) { return --lhs; });
+				if constexpr (operator_post_dec<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_post_dec, [](T& lhs) -> decltype(auto) { return lhs--; });
+
+				if constexpr (operator_assignment_add<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_add, [](T& lhs, const T& rhs) -> T& { return lhs += rhs; });
+				if constexpr (operator_assignment_sub<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_sub, [](T& lhs, const T& rhs) -> T& { return lhs -= rhs; });
+				if constexpr (operator_assignment_mul<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_mul, [](T& lhs, const T& rhs) -> T& { return lhs *= rhs; });
+				if constexpr (operator_assignment_div<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_div, [](T& lhs, const T& rhs) -> T& { return lhs /= rhs; });
+				if constexpr (operator_assignment_mod<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_mod, [](T& lhs, const T& rhs) -> T& { return lhs %= rhs; });
+				if constexpr (operator_assignment_band<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_band, [](T& lhs, const T& rhs) -> T& { return lhs &= rhs; });
+				if constexpr (operator_assignment_bor<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_bor, [](T& lhs, const T& rhs) -> T& { return lhs |= rhs; });
+				if constexpr (operator_assignment_bxor<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_bxor, [](T& lhs, const T& rhs) -> T& { return lhs ^= rhs; });
+				if constexpr (operator_assignment_shl<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_shl, [](T& lhs, const T& rhs) -> T& { return lhs <<= rhs; });
+				if constexpr (operator_assignment_shl<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_shr, [](T& lhs, const T& rhs) -> T& { return lhs >>= rhs; });
 			}
 
-			if constexpr (operator_add<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_add, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs + rhs; });
-			if constexpr (operator_sub<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_sub, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs - rhs; });
-			if constexpr (operator_mul<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_mul, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs * rhs; });
-			if constexpr (operator_div<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_div, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs / rhs; });
-			if constexpr (operator_mod<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_mod, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs % rhs; });
-
-			if constexpr (operator_bnot<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bnot, [](const T& lhs) -> decltype(auto) { return ~lhs; });
-			if constexpr (operator_band<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_band, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs & rhs; });
-			if constexpr (operator_bor<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bor, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs & rhs; });
-			if constexpr (operator_bxor<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_bxor, [](const T& lhs, const T& rhs) -> decltype(auto) { return lhs & rhs; });
-			if constexpr (operator_shl<const T&, const std::size_t&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](const T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs << rhs; });
-			if constexpr (operator_shr<const T&, const std::size_t&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs >> rhs; });
-
-			if constexpr (operator_shr<std::istream&, T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::istream& rhs) -> decltype(auto) { return rhs >> lhs; });
-			if constexpr (operator_shr<std::istringstream&, T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::istringstream& rhs) -> decltype(auto) { return rhs >> lhs; });
-			if constexpr (operator_shr<std::ifstream&, T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::ifstream& rhs) -> decltype(auto) { return rhs >> lhs; });
-			if constexpr (operator_shr<std::iostream&, T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::iostream& rhs) -> decltype(auto) { return rhs >> lhs; });
-			if constexpr (operator_shr<std::stringstream&, T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::stringstream& rhs) -> decltype(auto) { return rhs >> lhs; });
-			if constexpr (operator_shr<std::fstream&, T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::fstream& rhs) -> decltype(auto) { return rhs >> lhs; });
-
-			if constexpr (operator_shl<std::ostream&, const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::ostream& rhs) -> decltype(auto) { return rhs << lhs; });
-			if constexpr (operator_shl<std::ostringstream&, const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::ostringstream& rhs) -> decltype(auto) { return rhs << lhs; });
-			if constexpr (operator_shl<std::ofstream&, const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::ofstream& rhs) -> decltype(auto) { return rhs << lhs; });
-			if constexpr (operator_shl<std::iostream&, const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::iostream& rhs) -> decltype(auto) { return rhs << lhs; });
-			if constexpr (operator_shl<std::stringstream&, const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::stringstream& rhs) -> decltype(auto) { return rhs << lhs; });
-			if constexpr (operator_shl<std::fstream&, const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::fstream& rhs) -> decltype(auto) { return rhs << lhs; });
-
-			if constexpr (operator_pre_inc<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_pre_inc, [](T& lhs) -> decltype(auto) { return ++lhs; });
-			if constexpr (operator_post_inc<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_post_inc, [](T& lhs) -> decltype(auto) { return lhs++; });
-			if constexpr (operator_pre_dec<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_pre_dec, [](T& lhs) -> decltype(auto) { return --lhs; });
-			if constexpr (operator_post_dec<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_post_dec, [](T& lhs) -> decltype(auto) { return lhs--; });
-
-			if constexpr (operator_assignment_copy<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment, [](T& lhs, const T& rhs) -> T& { return lhs = rhs; });
-			if constexpr (operator_assignment_move<T> && (!std::is_trivially_move_assignable_v<T> || !std::is_trivially_copy_assignable_v<T>))
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment, [](T& lhs, T&& rhs) -> T& { return lhs = std::move(rhs); });
-			if constexpr (operator_assignment_add<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_add, [](T& lhs, const T& rhs) -> T& { return lhs += rhs; });
-			if constexpr (operator_assignment_sub<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_sub, [](T& lhs, const T& rhs) -> T& { return lhs -= rhs; });
-			if constexpr (operator_assignment_mul<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_mul, [](T& lhs, const T& rhs) -> T& { return lhs *= rhs; });
-			if constexpr (operator_assignment_div<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_div, [](T& lhs, const T& rhs) -> T& { return lhs /= rhs; });
-			if constexpr (operator_assignment_mod<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_mod, [](T& lhs, const T& rhs) -> T& { return lhs %= rhs; });
-			if constexpr (operator_assignment_band<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_band, [](T& lhs, const T& rhs) -> T& { return lhs &= rhs; });
-			if constexpr (operator_assignment_bor<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_bor, [](T& lhs, const T& rhs) -> T& { return lhs |= rhs; });
-			if constexpr (operator_assignment_bxor<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_bxor, [](T& lhs, const T& rhs) -> T& { return lhs ^= rhs; });
-			if constexpr (operator_assignment_shl<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_shl, [](T& lhs, const T& rhs) -> T& { return lhs <<= rhs; });
-			if constexpr (operator_assignment_shl<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment_shr, [](T& lhs, const T& rhs) -> T& { return lhs >>= rhs; });
-
-			if constexpr (!IsContainerType<T>) {
-				if constexpr (operator_eq<T>)
-					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_eq, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs == rhs); });
-				if constexpr (operator_ne<T>)
-					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_ne, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs != rhs); });
-				if constexpr (operator_lt<T>)
-					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_lt, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs < rhs); });
-				if constexpr (operator_gt<T>)
-					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_gt, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs > rhs); });
-				if constexpr (operator_le<T>)
-					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_le, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs <= rhs); });
-				if constexpr (operator_ge<T>)
-					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_ge, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs >= rhs); });
+			// stream
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::Stream)) {
+				if constexpr (operator_shr<std::istream&, T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::istream& rhs) -> decltype(auto) { return rhs >> lhs; });
+				if constexpr (operator_shr<std::istringstream&, T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::istringstream& rhs) -> decltype(auto) { return rhs >> lhs; });
+				if constexpr (operator_shr<std::ifstream&, T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::ifstream& rhs) -> decltype(auto) { return rhs >> lhs; });
+				if constexpr (operator_shr<std::iostream&, T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::iostream& rhs) -> decltype(auto) { return rhs >> lhs; });
+				if constexpr (operator_shr<std::stringstream&, T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::stringstream& rhs) -> decltype(auto) { return rhs >> lhs; });
+				if constexpr (operator_shr<std::fstream&, T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shl, [](T& lhs, std::fstream& rhs) -> decltype(auto) { return rhs >> lhs; });
+
+				if constexpr (operator_shl<std::ostream&, const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::ostream& rhs) -> decltype(auto) { return rhs << lhs; });
+				if constexpr (operator_shl<std::ostringstream&, const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::ostringstream& rhs) -> decltype(auto) { return rhs << lhs; });
+				if constexpr (operator_shl<std::ofstream&, const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::ofstream& rhs) -> decltype(auto) { return rhs << lhs; });
+				if constexpr (operator_shl<std::iostream&, const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::iostream& rhs) -> decltype(auto) { return rhs << lhs; });
+				if constexpr (operator_shl<std::stringstream&, const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::stringstream& rhs) -> decltype(auto) { return rhs << lhs; });
+				if constexpr (operator_shl<std::fstream&, const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_shr, [](const T& lhs, std::fstream& rhs) -> decltype(auto) { return rhs << lhs; });
 			}
 
-			if constexpr (operator_subscript<T, const std::size_t>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs[rhs]; });
-			if constexpr (operator_subscript<const T, const std::size_t>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](const T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs[rhs]; });
-			if constexpr (operator_indirection<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_indirection, [](T& lhs) -> decltype(auto) { return *lhs; });
-			if constexpr (operator_indirection<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_indirection, [](const T& lhs) -> decltype(auto) { return *lhs; });
-
-			// iterator
-			if constexpr (std::input_iterator<T>) {
-				mngr.AddMemberMethod(
-					NameIDRegistry::Meta::advance,
-					[](T& lhs, const std::iter_difference_t<T>& rhs) { std::advance(lhs, rhs); }
-				);
-				mngr.AddMemberMethod(
-					NameIDRegistry::Meta::next,
-					[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return std::next(lhs, rhs); }
-				);
-				mngr.AddMemberMethod(
-					NameIDRegistry::Meta::prev,
-					[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return std::prev(lhs, rhs); }
-				);
-				if constexpr (std::is_convertible_v<std::iter_difference_t<T>, std::size_t>) {
+			// compare
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::Compare)) {
+				if constexpr (!IsContainerType<T>) {
+					if constexpr (operator_eq<T>)
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_eq, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs == rhs); });
+					if constexpr (operator_ne<T>)
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_ne, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs != rhs); });
+					if constexpr (operator_lt<T>)
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_lt, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs < rhs); });
+					if constexpr (operator_gt<T>)
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_gt, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs > rhs); });
+					if constexpr (operator_le<T>)
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_le, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs <= rhs); });
+					if constexpr (operator_ge<T>)
+						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_ge, [](const T& lhs, const T& rhs) { return static_cast<bool>(lhs >= rhs); });
+				}
+			}
+
+			// subscript, indirection and iterator
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::Iterator)) {
+				if constexpr (operator_subscript<T, const std::size_t>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs[rhs]; });
+				if constexpr (operator_subscript<const T, const std::size_t>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](const T& lhs, const std::size_t& rhs) -> decltype(auto) { return lhs[rhs]; });
+				if constexpr (operator_indirection<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_indirection, [](T& lhs) -> decltype(auto) { return *lhs; });
+				if constexpr (operator_indirection<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_indirection, [](const T& lhs) -> decltype(auto) { return *lhs; });
+
+				if constexpr (std::input_iterator<T>) {
 					mngr.AddMemberMethod(
-						NameIDRegistry::Meta::distance,
-						[](const T& lhs, const T& rhs) { return static_cast<std::size_t>(std::distance(lhs, rhs)); }
+						NameIDRegistry::Meta::advance,
+						[](T& lhs, const std::iter_difference_t<T>& rhs) { std::advance(lhs, rhs); }
 					);
-				}
-				if constexpr (std::random_access_iterator<T>) {
 					mngr.AddMemberMethod(
-						NameIDRegistry::Meta::operator_add,
-						[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return lhs + rhs; }
+						NameIDRegistry::Meta::next,
+						[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return std::next(lhs, rhs); }
 					);
 					mngr.AddMemberMethod(
-						NameIDRegistry::Meta::operator_sub,
-						[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return lhs - rhs; }
+						NameIDRegistry::Meta::prev,
+						[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return std::prev(lhs, rhs); }
 					);
+					if constexpr (std::is_convertible_v<std::iter_difference_t<T>, std::size_t>) {
+						mngr.AddMemberMethod(
+							NameIDRegistry::Meta::distance,
+							[](const T& lhs, const T& rhs) { return static_cast<std::size_t>(std::distance(lhs, rhs)); }
+						);
+					}
+					if constexpr (std::random_access_iterator<T>) {
+						mngr.AddMemberMethod(
+							NameIDRegistry::Meta::operator_add,
+							[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return lhs + rhs; }
+						);
+						mngr.AddMemberMethod(
+							NameIDRegistry::Meta::operator_sub,
+							[](const T& lhs, const std::iter_difference_t<T>& rhs) -> decltype(auto) { return lhs - rhs; }
+						);
+					}
 				}
 			}
 
-			// pair
-
-			if constexpr (IsPair<T>) {
-				mngr.RegisterType<typename T::first_type>();
-				mngr.RegisterType<typename T::second_type>();
-				mngr.AddField<&T::first>("first");
-				mngr.AddField<&T::second>("second");
-			}
-
-			// tuple
-
-			if constexpr (IsTuple<T> && !IsArray<T>) {
-				mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::tuple_size, []() { return static_cast<std::size_t>(std::tuple_size_v<T>); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const std::size_t& i) { return runtime_get<std::tuple_size>(t, i); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const std::size_t& i) { return runtime_get<std::tuple_size>(t, i); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const Type& type) { return runtime_get<std::tuple_size, std::tuple_element>(t, type); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const Type& type) { return runtime_get<std::tuple_size, std::tuple_element>(t, type); });
-				mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::tuple_element, [](const std::size_t& i) { return runtime_tuple_element<T>(i); });
-				register_tuple_elements<T>(mngr, std::make_index_sequence<std::tuple_size_v<T>>{});
-			}
-
-			// variant
-
-			if constexpr (IsVariant<T>) {
-				mngr.AddMemberMethod(NameIDRegistry::Meta::variant_index, [](const T& t) { return static_cast<std::size_t>(t.index()); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::variant_valueless_by_exception, [](const T& t) { return static_cast<bool>(t.valueless_by_exception()); });
-				mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::variant_size, []() { return static_cast<std::size_t>(std::variant_size_v<T>); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const std::size_t& i) { return runtime_get<std::variant_size>(t, i); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const std::size_t& i) { return runtime_get<std::variant_size>(t, i); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::holds_alternative, [](const T& t, const Type& type) { return runtime_variant_holds_alternative(t, type); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const Type& type) { return runtime_get<std::variant_size, std::variant_alternative>(t, type); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const Type& type) { return runtime_get<std::variant_size, std::variant_alternative>(t, type); });
-				mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::variant_alternative, [](const std::size_t& i) { return runtime_variant_alternative<T>(i); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::variant_visit_get, [](T& t) { return runtime_get<std::variant_size>(t, t.index()); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::variant_visit_get, [](const T& t) { return runtime_get<std::variant_size>(t, t.index()); });
-				register_variant_alternatives<T>(mngr, std::make_index_sequence<std::variant_size_v<T>>{});
-			}
-
-			// optional
+			// pair, tuple, variant and optional
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::TupleVariant)) {
+				if constexpr (IsPair<T>) {
+					mngr.AddField<&T::first>("first");
+					mngr.AddField<&T::second>("second");
+				}
 
-			if constexpr (IsOptional<T>) {
-				mngr.AddMemberMethod(NameIDRegistry::Meta::optional_has_value, [](const T& t) { return static_cast<bool>(t.has_value()); });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::optional_value, [](T& t) { return ObjectView{ t.value() }; });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::optional_value, [](const T& t) { return ObjectView{ t.value() }; });
-				mngr.AddMemberMethod(NameIDRegistry::Meta::optional_reset, [](T& t) { t.reset(); });
+				// tuple
 
-				using Elem = typename T::value_type;
-				if constexpr (type_ctor<T, const Elem&>)
-					mngr.AddConstructor<T, const Elem&>();
-				if constexpr (operator_assignment<T, const Elem&>) {
+				if constexpr (IsTuple<T> && !IsArray<T>) {
+					mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::tuple_size, []() { return static_cast<std::size_t>(std::tuple_size_v<T>); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const std::size_t& i) { return runtime_get<std::tuple_size>(t, i); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const std::size_t& i) { return runtime_get<std::tuple_size>(t, i); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const Type& type) { return runtime_get<std::tuple_size, std::tuple_element>(t, type); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const Type& type) { return runtime_get<std::tuple_size, std::tuple_element>(t, type); });
+					mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::tuple_element, [](const std::size_t& i) { return runtime_tuple_element<T>(i); });
+					register_tuple_elements<T>(mngr, std::make_index_sequence<std::tuple_size_v<T>>{});
+				}
 
-					mngr.AddMemberMethod(
-						NameIDRegistry::Meta::operator_assignment,
-						[](T& t, const Elem& elem) -> T& {
-							t = elem;
-							return t;
-						});
+				// variant
+
+				if constexpr (IsVariant<T>) {
+					mngr.AddMemberMethod(NameIDRegistry::Meta::variant_index, [](const T& t) { return static_cast<std::size_t>(t.index()); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::variant_valueless_by_exception, [](const T& t) { return static_cast<bool>(t.valueless_by_exception()); });
+					mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::variant_size, []() { return static_cast<std::size_t>(std::variant_size_v<T>); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const std::size_t& i) { return runtime_get<std::variant_size>(t, i); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const std::size_t& i) { return runtime_get<std::variant_size>(t, i); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::holds_alternative, [](const T& t, const Type& type) { return runtime_variant_holds_alternative(t, type); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](T& t, const Type& type) { return runtime_variant_get(t, type); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::get, [](const T& t, const Type& type) { return runtime_variant_get(t, type); });
+					mngr.AddStaticMethod(Type_of<T>, NameIDRegistry::Meta::variant_alternative, [](const std::size_t& i) { return runtime_variant_alternative<T>(i); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::variant_visit_get, [](T& t) { return runtime_get<std::variant_size>(t, t.index()); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::variant_visit_get, [](const T& t) { return runtime_get<std::variant_size>(t, t.index()); });
+					register_variant_alternatives<T>(mngr, std::make_index_sequence<std::variant_size_v<T>>{});
 				}
 
-				if constexpr (!std::is_fundamental_v<Elem>) {
-					if constexpr (type_ctor<T, Elem&&>)
-						mngr.AddConstructor<T, Elem&&>();
-					if constexpr (operator_assignment<T, Elem&&>)
-						mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment, [](T& t, Elem&& elem) -> T& { return t = std::move(elem); });
+				// optional
+
+				if constexpr (IsOptional<T>) {
+					mngr.AddMemberMethod(NameIDRegistry::Meta::optional_has_value, [](const T& t) { return static_cast<bool>(t.has_value()); });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::optional_value, [](T& t) { return ObjectView{ t.value() }; });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::optional_value, [](const T& t) { return ObjectView{ t.value() }; });
+					mngr.AddMemberMethod(NameIDRegistry::Meta::optional_reset, [](T& t) { t.reset(); });
+
+					using Elem = typename T::value_type;
+					if constexpr (type_ctor<T, const Elem&>)
+						mngr.AddConstructor<T, const Elem&>();
+					if constexpr (operator_assignment<T, const Elem&>) {
+
+						mngr.AddMemberMethod(
+							NameIDRegistry::Meta::operator_assignment,
+							[](T& t, const Elem& elem) -> T& {
+								t = elem;
+								return t;
+							});
+					}
+
+					if constexpr (!std::is_fundamental_v<Elem>) {
+						if constexpr (type_ctor<T, Elem&&>)
+							mngr.AddConstructor<T, Elem&&>();
+						if constexpr (operator_assignment<T, Elem&&>)
+							mngr.AddMemberMethod(NameIDRegistry::Meta::operator_assignment, [](T& t, Elem&& elem) -> T& { return t = std::move(elem); });
+					}
 				}
 			}
 
 			// container
+			if constexpr (enum_contain(Flags, AutoRegisterFlag::Container)) {
+				// - assign
+
+				if constexpr (container_assign<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_assign, [](T& lhs, const typename T::size_type& s, const typename T::value_type& v) { lhs.assign(s, v); });
+
+				// - iterator
+
+				if constexpr (container_begin<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_begin, [](T& lhs) -> decltype(auto) { return std::begin(lhs); });
+				if constexpr (container_begin<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_begin, [](const T& lhs) -> decltype(auto) { return std::begin(lhs); });
+				if constexpr (container_cbegin<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_cbegin, [](const T& lhs) -> decltype(auto) { return std::cbegin(lhs); });
+				if constexpr (container_end<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_end, [](T& lhs) -> decltype(auto) { return std::end(lhs); });
+				if constexpr (container_end<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_end, [](const T& lhs) -> decltype(auto) { return std::end(lhs); });
+				if constexpr (container_cend<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_cend, [](const T& lhs) -> decltype(auto) { return std::cend(lhs); });
+
+				if constexpr (container_rbegin<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_rbegin, [](T& lhs) -> decltype(auto) { return std::rbegin(lhs); });
+				if constexpr (container_rbegin<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_rbegin, [](const T& lhs) -> decltype(auto) { return std::rbegin(lhs); });
+				if constexpr (container_crbegin<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_crbegin, [](const T& lhs) -> decltype(auto) { return std::rbegin(lhs); });
+				if constexpr (container_rend<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_rend, [](T& lhs) -> decltype(auto) { return std::rend(lhs); });
+				if constexpr (container_rend<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_rend, [](const T& lhs) -> decltype(auto) { return std::rend(lhs); });
+				if constexpr (container_crend<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_crend, [](const T& lhs) -> decltype(auto) { return std::crend(lhs); });
 
-			// - assign
-
-			if constexpr (container_assign<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_assign, [](T& lhs, const typename T::size_type& s, const typename T::value_type& v) { lhs.assign(s, v); });
-
-			// - iterator
-
-			if constexpr (container_begin<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_begin, [](T& lhs) -> decltype(auto) { return std::begin(lhs); });
-			if constexpr (container_begin<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_begin, [](const T& lhs) -> decltype(auto) { return std::begin(lhs); });
-			if constexpr (container_cbegin<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_cbegin, [](const T& lhs) -> decltype(auto) { return std::cbegin(lhs); });
-			if constexpr (container_end<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_end, [](T& lhs) -> decltype(auto) { return std::end(lhs); });
-			if constexpr (container_end<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_end, [](const T& lhs) -> decltype(auto) { return std::end(lhs); });
-			if constexpr (container_cend<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_cend, [](const T& lhs) -> decltype(auto) { return std::cend(lhs); });
+				// - element access
 
-			if constexpr (container_rbegin<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_rbegin, [](T& lhs) -> decltype(auto) { return std::rbegin(lhs); });
-			if constexpr (container_rbegin<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_rbegin, [](const T& lhs) -> decltype(auto) { return std::rbegin(lhs); });
-			if constexpr (container_crbegin<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_crbegin, [](const T& lhs) -> decltype(auto) { return std::rbegin(lhs); });
-			if constexpr (container_rend<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_rend, [](T& lhs) -> decltype(auto) { return std::rend(lhs); });
-			if constexpr (container_rend<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_rend, [](const T& lhs) -> decltype(auto) { return std::rend(lhs); });
-			if constexpr (container_crend<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_crend, [](const T& lhs) -> decltype(auto) { return std::crend(lhs); });
+				if constexpr (container_at_size<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](T& lhs, const std::size_t& n) -> decltype(auto) { return lhs.at(n); });
+				if constexpr (container_at_size<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](const T& lhs, const std::size_t& n) -> decltype(auto) { return lhs.at(n); });
 
-			// - element access
+				if constexpr (container_at_key<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs.at(key); });
+				if constexpr (container_at_key<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](const T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs.at(key); });
 
-			if constexpr (container_at_size<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](T& lhs, const std::size_t& n) -> decltype(auto) { return lhs.at(n); });
-			if constexpr (container_at_size<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](const T& lhs, const std::size_t& n) -> decltype(auto) { return lhs.at(n); });
+				if constexpr (container_subscript_size<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, const get_container_size_type_t<T>& rhs) -> decltype(auto) { return lhs[rhs]; });
+				if constexpr (container_subscript_size<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](const T& lhs, const get_container_size_type_t<T>& rhs) -> decltype(auto) { return lhs[rhs]; });
 
-			if constexpr (container_at_key<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs.at(key); });
-			if constexpr (container_at_key<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_at, [](const T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs.at(key); });
+				if constexpr (container_subscript_key_cl<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs[key]; });
+				if constexpr (container_subscript_key_r<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, typename T::key_type&& key) -> decltype(auto) { return lhs[std::move(key)]; });
 
-			if constexpr (container_subscript_size<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, const get_container_size_type_t<T>& rhs) -> decltype(auto) { return lhs[rhs]; });
-			if constexpr (container_subscript_size<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](const T& lhs, const get_container_size_type_t<T>& rhs) -> decltype(auto) { return lhs[rhs]; });
+				if constexpr (container_data<T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_data, [](T& lhs) -> decltype(auto) { return std::data(lhs); });
+				if constexpr (container_data<const T&>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_data, [](const T& lhs) -> decltype(auto) { return std::data(lhs); });
 
-			if constexpr (container_subscript_key_cl<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs[key]; });
-			if constexpr (container_subscript_key_r<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::operator_subscript, [](T& lhs, typename T::key_type&& key) -> decltype(auto) { return lhs[std::move(key)]; });
+				if constexpr (container_front<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_front, [](T& lhs) -> decltype(auto) { return lhs.front(); });
+				if constexpr (container_front<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_front, [](const T& lhs) -> decltype(auto) { return lhs.front(); });
 
-			if constexpr (container_data<T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_data, [](T& lhs) -> decltype(auto) { return std::data(lhs); });
-			if constexpr (container_data<const T&>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_data, [](const T& lhs) -> decltype(auto) { return std::data(lhs); });
+				if constexpr (container_back<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_back, [](T& lhs) -> decltype(auto) { return lhs.back(); });
+				if constexpr (container_back<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_back, [](const T& lhs) -> decltype(auto) { return lhs.back(); });
 
-			if constexpr (container_front<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_front, [](T& lhs) -> decltype(auto) { return lhs.front(); });
-			if constexpr (container_front<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_front, [](const T& lhs) -> decltype(auto) { return lhs.front(); });
+				if constexpr (container_top<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_top, [](T& lhs) -> decltype(auto) { return lhs.top(); });
+				if constexpr (container_top<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_top, [](const T& lhs) -> decltype(auto) { return lhs.top(); });
 
-			if constexpr (container_back<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_back, [](T& lhs) -> decltype(auto) { return lhs.back(); });
-			if constexpr (container_back<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_back, [](const T& lhs) -> decltype(auto) { return lhs.back(); });
+				// empty, size (the vtable is registered above)
+				if constexpr (container_empty<T> || container_size<T> || container_object_elements<T>)
+					mngr.AddContainerVTableMethods(Type_of<T>);
 
-			if constexpr (container_top<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_top, [](T& lhs) -> decltype(auto) { return lhs.top(); });
-			if constexpr (container_top<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_top, [](const T& lhs) -> decltype(auto) { return lhs.top(); });
+				if constexpr (container_size_bytes<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_size_bytes, [](const T& lhs) { return static_cast<std::size_t>(lhs.size_bytes()); });
 
-			if constexpr (container_empty<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_empty, [](const T& lhs) { return static_cast<bool>(std::empty(lhs)); });
+				if constexpr (container_resize_cnt<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_resize, [](T& lhs, const typename T::size_type& n) { lhs.resize(n); });
 
-			if constexpr (container_size<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_size, [](const T& lhs) { return static_cast<std::size_t>(std::size(lhs)); });
+				if constexpr (container_resize_cnt_value<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_resize, [](T& lhs, const typename T::size_type& n, const typename T::value_type& value) { lhs.resize(n, value); });
 
-			if constexpr (container_size_bytes<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_size_bytes, [](const T& lhs) { return static_cast<std::size_t>(lhs.size_bytes()); });
+				if constexpr (container_capacity<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_capacity, [](const T& lhs) { return static_cast<std::size_t>(lhs.capacity()); });
 
-			if constexpr (container_resize_cnt<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_resize, [](T& lhs, const typename T::size_type& n) { lhs.resize(n); });
+				if constexpr (container_bucket_count<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_bucket_count, [](const T& lhs) { return static_cast<std::size_t>(lhs.bucket_count()); });
 
-			if constexpr (container_resize_cnt_value<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_resize, [](T& lhs, const typename T::size_type& n, const typename T::value_type& value) { lhs.resize(n, value); });
+				if constexpr (container_reserve<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_reserve, [](T& lhs, const typename T::size_type& n) { lhs.reserve(n); });
 
-			if constexpr (container_capacity<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_capacity, [](const T& lhs) { return static_cast<std::size_t>(lhs.capacity()); });
+				if constexpr (container_shrink_to_fit<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_shrink_to_fit, [](T& lhs) { lhs.shrink_to_fit(); });
 
-			if constexpr (container_bucket_count<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_bucket_count, [](const T& lhs) { return static_cast<std::size_t>(lhs.bucket_count()); });
+				// - modifiers
 
-			if constexpr (container_reserve<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_reserve, [](T& lhs, const typename T::size_type& n) { lhs.reserve(n); });
+				if constexpr (container_clear<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_clear, [](T& lhs) { lhs.clear(); });
 
-			if constexpr (container_shrink_to_fit<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_shrink_to_fit, [](T& lhs) { lhs.shrink_to_fit(); });
+				if constexpr (container_insert_clvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::value_type& value) -> decltype(auto) { return lhs.insert(value); });
 
-			// - modifiers
+				if constexpr (container_insert_rvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, typename T::value_type&& value) -> decltype(auto) { return lhs.insert(std::move(value)); });
 
-			if constexpr (container_clear<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_clear, [](T& lhs) { lhs.clear(); });
+				if constexpr (container_insert_rnode<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, typename T::node_type&& node) -> decltype(auto) { return lhs.insert(std::move(node)); });
 
-			if constexpr (container_insert_clvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::value_type& value) -> decltype(auto) { return lhs.insert(value); });
+				if constexpr (container_insert_citer_clvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, const typename T::value_type& value) -> decltype(auto) { return lhs.insert(iter, value); });
 
-			if constexpr (container_insert_rvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, typename T::value_type&& value) -> decltype(auto) { return lhs.insert(std::move(value)); });
+				if constexpr (container_insert_citer_rvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, typename T::value_type&& value) -> decltype(auto) { return lhs.insert(iter, std::move(value)); });
 
-			if constexpr (container_insert_rnode<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, typename T::node_type&& node) -> decltype(auto) { return lhs.insert(std::move(node)); });
+				if constexpr (container_insert_citer_rnode<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, typename T::node_type&& node) -> decltype(auto) { return lhs.insert(iter, std::move(node)); });
 
-			if constexpr (container_insert_citer_clvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, const typename T::value_type& value) -> decltype(auto) { return lhs.insert(iter, value); });
+				if constexpr (container_insert_citer_cnt<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, const typename T::size_type& cnt, const typename T::value_type& value) -> decltype(auto) { return lhs.insert(iter, cnt, value); });
 
-			if constexpr (container_insert_citer_rvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, typename T::value_type&& value) -> decltype(auto) { return lhs.insert(iter, std::move(value)); });
+				if constexpr (container_insert_after_clvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert_after, [](T& lhs, const typename T::const_iterator& pos, const typename T::value_type& value) -> decltype(auto) { return lhs.insert_after(pos, value); });
 
-			if constexpr (container_insert_citer_rnode<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, typename T::node_type&& node) -> decltype(auto) { return lhs.insert(iter, std::move(node)); });
+				if constexpr (container_insert_after_rvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert_after, [](T& lhs, const typename T::const_iterator& pos, typename T::value_type&& value) -> decltype(auto) { return lhs.insert_after(pos, std::move(value)); });
 
-			if constexpr (container_insert_citer_cnt<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert, [](T& lhs, const typename T::const_iterator& iter, const typename T::size_type& cnt, const typename T::value_type& value) -> decltype(auto) { return lhs.insert(iter, cnt, value); });
+				if constexpr (container_insert_after_cnt<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert_after, [](T& lhs, const typename T::const_iterator& pos, const typename T::size_type& cnt, const typename T::value_type& value) -> decltype(auto) { return lhs.insert_after(pos, cnt, value); });
 
-			if constexpr (container_insert_after_clvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert_after, [](T& lhs, const typename T::const_iterator& pos, const typename T::value_type& value) -> decltype(auto) { return lhs.insert_after(pos, value); });
+				if constexpr (container_erase_citer<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase, [](T& lhs, const typename T::const_iterator& rhs) -> decltype(auto) { return lhs.erase(rhs); });
 
-			if constexpr (container_insert_after_rvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert_after, [](T& lhs, const typename T::const_iterator& pos, typename T::value_type&& value) -> decltype(auto) { return lhs.insert_after(pos, std::move(value)); });
+				if constexpr (container_erase_key<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.erase(rhs); });
 
-			if constexpr (container_insert_after_cnt<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_insert_after, [](T& lhs, const typename T::const_iterator& pos, const typename T::size_type& cnt, const typename T::value_type& value) -> decltype(auto) { return lhs.insert_after(pos, cnt, value); });
+				if constexpr (container_erase_range_citer<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase, [](T& lhs, const typename T::const_iterator& start, const typename T::const_iterator& end) -> decltype(auto) { return lhs.erase(start, end); });
 
-			if constexpr (container_erase_citer<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase, [](T& lhs, const typename T::const_iterator& rhs) -> decltype(auto) { return lhs.erase(rhs); });
+				if constexpr (container_erase_after<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase_after, [](T& lhs, const typename T::const_iterator& pos) -> decltype(auto) { return lhs.erase_after(pos); });
 
-			if constexpr (container_erase_key<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.erase(rhs); });
+				if constexpr (container_erase_after_range<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase_after, [](T& lhs, const typename T::const_iterator& first, const typename T::const_iterator& last) -> decltype(auto) { return lhs.erase_after(first, last); });
 
-			if constexpr (container_erase_range_citer<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase, [](T& lhs, const typename T::const_iterator& start, const typename T::const_iterator& end) -> decltype(auto) { return lhs.erase(start, end); });
+				if constexpr (container_push_front_clvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_front, [](T& lhs, const typename T::value_type& value) { lhs.push_front(value); });
 
-			if constexpr (container_erase_after<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase_after, [](T& lhs, const typename T::const_iterator& pos) -> decltype(auto) { return lhs.erase_after(pos); });
+				if constexpr (container_push_front_rvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_front, [](T& lhs, typename T::value_type&& value) { lhs.push_front(std::move(value)); });
 
-			if constexpr (container_erase_after_range<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_erase_after, [](T& lhs, const typename T::const_iterator& first, const typename T::const_iterator& last) -> decltype(auto) { return lhs.erase_after(first, last); });
+				if constexpr (container_pop_front<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_pop_front, [](T& lhs) { lhs.pop_front(); });
 
-			if constexpr (container_push_front_clvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_front, [](T& lhs, const typename T::value_type& value) { lhs.push_front(value); });
+				if constexpr (container_push_back_clvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_back, [](T& lhs, const typename T::value_type& value) { lhs.push_back(value); });
 
-			if constexpr (container_push_front_rvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_front, [](T& lhs, typename T::value_type&& value) { lhs.push_front(std::move(value)); });
+				if constexpr (container_push_back_rvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_back, [](T& lhs, typename T::value_type&& value) { lhs.push_back(std::move(value)); });
 
-			if constexpr (container_pop_front<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_pop_front, [](T& lhs) { lhs.pop_front(); });
+				if constexpr (container_pop_back<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_pop_back, [](T& lhs) { lhs.pop_back(); });
 
-			if constexpr (container_push_back_clvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_back, [](T& lhs, const typename T::value_type& value) { lhs.push_back(value); });
+				if constexpr (container_push_clvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_push, [](T& lhs, const typename T::value_type& value) { lhs.push(value); });
 
-			if constexpr (container_push_back_rvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_push_back, [](T& lhs, typename T::value_type&& value) { lhs.push_back(std::move(value)); });
+				if constexpr (container_push_rvalue<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_push, [](T& lhs, typename T::value_type&& value) { lhs.push(std::move(value)); });
 
-			if constexpr (container_pop_back<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_pop_back, [](T& lhs) { lhs.pop_back(); });
+				if constexpr (container_pop<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_pop, [](T& lhs) { lhs.pop(); });
 
-			if constexpr (container_push_clvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_push, [](T& lhs, const typename T::value_type& value) { lhs.push(value); });
+				if constexpr (container_swap<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_swap, [](T& lhs, T& rhs) { std::swap(lhs, rhs); });
 
-			if constexpr (container_push_rvalue<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_push, [](T& lhs, typename T::value_type&& value) { lhs.push(std::move(value)); });
+				if constexpr (container_merge_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_merge, [](T& lhs, T& rhs) { lhs.merge(rhs); });
 
-			if constexpr (container_pop<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_pop, [](T& lhs) { lhs.pop(); });
+				if constexpr (container_merge_r<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_merge, [](T& lhs, T&& rhs) { lhs.merge(std::move(rhs)); });
 
-			if constexpr (container_swap<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_swap, [](T& lhs, T& rhs) { std::swap(lhs, rhs); });
+				if constexpr (container_extract_citer<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_extract, [](T& lhs, const typename T::const_iterator& iter) -> decltype(auto) { return lhs.extract(iter); });
 
-			if constexpr (container_merge_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_merge, [](T& lhs, T& rhs) { lhs.merge(rhs); });
+				if constexpr (container_extract_key<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_extract, [](T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs.extract(key); });
 
-			if constexpr (container_merge_r<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_merge, [](T& lhs, T&& rhs) { lhs.merge(std::move(rhs)); });
+				// - list operations
 
-			if constexpr (container_extract_citer<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_extract, [](T& lhs, const typename T::const_iterator& iter) -> decltype(auto) { return lhs.extract(iter); });
+				if constexpr (container_splice_after_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T& other) { lhs.splice_after(pos, other); });
 
-			if constexpr (container_extract_key<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_extract, [](T& lhs, const typename T::key_type& key) -> decltype(auto) { return lhs.extract(key); });
+				if constexpr (container_splice_after_r<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T&& other) { lhs.splice_after(pos, std::move(other)); });
 
-			// - list operations
+				if constexpr (container_splice_after_it_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& it) { lhs.splice_after(pos, other, it); });
 
-			if constexpr (container_splice_after_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T& other) { lhs.splice_after(pos, other); });
+				if constexpr (container_splice_after_it_r<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& it) { lhs.splice_after(pos, std::move(other), it); });
 
-			if constexpr (container_splice_after_r<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T&& other) { lhs.splice_after(pos, std::move(other)); });
+				if constexpr (container_splice_after_range_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice_after(pos, other, first, last); });
 
-			if constexpr (container_splice_after_it_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& it) { lhs.splice_after(pos, other, it); });
+				if constexpr (container_splice_after_range_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice_after(pos, std::move(other), first, last); });
 
-			if constexpr (container_splice_after_it_r<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& it) { lhs.splice_after(pos, std::move(other), it); });
+				if constexpr (container_splice_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T& other) { lhs.splice(pos, other); });
 
-			if constexpr (container_splice_after_range_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice_after(pos, other, first, last); });
+				if constexpr (container_splice_r<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T&& other) { lhs.splice(pos, std::move(other)); });
 
-			if constexpr (container_splice_after_range_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice_after, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice_after(pos, std::move(other), first, last); });
+				if constexpr (container_splice_it_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& it) { lhs.splice(pos, other, it); });
 
-			if constexpr (container_splice_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T& other) { lhs.splice(pos, other); });
+				if constexpr (container_splice_it_r<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& it) { lhs.splice(pos, std::move(other), it); });
 
-			if constexpr (container_splice_r<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T&& other) { lhs.splice(pos, std::move(other)); });
+				if constexpr (container_splice_range_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice(pos, other, first, last); });
 
-			if constexpr (container_splice_it_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& it) { lhs.splice(pos, other, it); });
+				if constexpr (container_splice_range_l<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice(pos, std::move(other), first, last); });
 
-			if constexpr (container_splice_it_r<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& it) { lhs.splice(pos, std::move(other), it); });
+				if constexpr (container_remove<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_remove, [](T& lhs, const typename T::value_type& v) { return static_cast<std::size_t>(lhs.remove(v)); });
 
-			if constexpr (container_splice_range_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice(pos, other, first, last); });
+				if constexpr (container_reverse<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_reverse, [](T& lhs) { lhs.reverse(); });
 
-			if constexpr (container_splice_range_l<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_splice, [](T& lhs, const typename T::const_iterator& pos, T&& other, const typename T::const_iterator& first, const typename T::const_iterator& last) { lhs.splice(pos, std::move(other), first, last); });
+				if constexpr (container_unique<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_unique, [](T& lhs) { return static_cast<std::size_t>(lhs.unique()); });
 
-			if constexpr (container_remove<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_remove, [](T& lhs, const typename T::value_type& v) { return static_cast<std::size_t>(lhs.remove(v)); });
-
-			if constexpr (container_reverse<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_reverse, [](T& lhs) { lhs.reverse(); });
-
-			if constexpr (container_unique<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_unique, [](T& lhs) { return static_cast<std::size_t>(lhs.unique()); });
-
-			if constexpr (container_sort<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_sort, [](T& lhs) { lhs.sort(); });
+				if constexpr (container_sort<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_sort, [](T& lhs) { lhs.sort(); });
 			
-			// - lookup
-
-			if constexpr (container_count<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_count, [](const T& lhs, const typename T::key_type& rhs) { return static_cast<std::size_t>(lhs.count(rhs)); });
-
-			if constexpr (container_find<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_find, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.find(rhs); });
-			if constexpr (container_find<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_find, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.find(rhs); });
-
-			if constexpr (container_lower_bound<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_lower_bound, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.lower_bound(rhs); });
-			if constexpr (container_lower_bound<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_lower_bound, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.lower_bound(rhs); });
-
-			if constexpr (container_upper_bound<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_upper_bound, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.upper_bound(rhs); });
-			if constexpr (container_upper_bound<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_upper_bound, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.upper_bound(rhs); });
-
-			if constexpr (container_equal_range<T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_equal_range, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.equal_range(rhs); });
-			if constexpr (container_equal_range<const T>)
-				mngr.AddMemberMethod(NameIDRegistry::Meta::container_equal_range, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.equal_range(rhs); });
+				// - lookup
+
+				if constexpr (container_count<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_count, [](const T& lhs, const typename T::key_type& rhs) { return static_cast<std::size_t>(lhs.count(rhs)); });
+
+				if constexpr (container_find<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_find, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.find(rhs); });
+				if constexpr (container_find<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_find, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.find(rhs); });
+
+				if constexpr (container_lower_bound<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_lower_bound, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.lower_bound(rhs); });
+				if constexpr (container_lower_bound<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_lower_bound, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.lower_bound(rhs); });
+
+				if constexpr (container_upper_bound<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_upper_bound, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.upper_bound(rhs); });
+				if constexpr (container_upper_bound<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_upper_bound, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.upper_bound(rhs); });
+
+				if constexpr (container_equal_range<T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_equal_range, [](T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.equal_range(rhs); });
+				if constexpr (container_equal_range<const T>)
+					mngr.AddMemberMethod(NameIDRegistry::Meta::container_equal_range, [](const T& lhs, const typename T::key_type& rhs) -> decltype(auto) { return lhs.equal_range(rhs); });
+
+				// - type
+
+				if constexpr (std::is_array_v<T>) {
+					using value_type = std::remove_extent_t<T>;
+					using pointer = value_type*;
+					using const_pointer = const value_type*;
+					mngr.RegisterType<pointer>();
+					mngr.RegisterType<const_pointer>();
+				}
+				else {
+					if constexpr (container_size_type<T>)
+						mngr.RegisterType<typename T::size_type>();
+					if constexpr (container_difference_type<T>)
+						mngr.RegisterType<typename T::difference_type>();
+					if constexpr (!is_instance_of_v<T, std::allocator>) {
+						if constexpr (container_pointer_type<T>)
+							mngr.RegisterType<typename T::pointer>();
+						if constexpr (container_const_pointer_type<T>)
+							mngr.RegisterType<typename T::const_pointer>();
+					}
+					if constexpr (container_iterator<T>) {
+						mngr.RegisterType<typename T::iterator>();
+						if constexpr (IsMultiSet<T> || IsUnorderedMultiSet<T>)
+							mngr.RegisterType<std::pair<typename T::iterator, bool>>();
+					}
+					if constexpr (container_const_iterator<T>)
+						mngr.RegisterType<typename T::const_iterator>();
+					if constexpr (container_local_iterator<T>)
+						mngr.RegisterType<typename T::local_iterator>();
+					if constexpr (container_const_local_iterator<T>)
+						mngr.RegisterType<typename T::const_local_iterator>();
+					if constexpr (container_node_type<T>)
+						mngr.RegisterType<typename T::node_type>();
+					if constexpr (container_insert_return_type<T>) {
+						mngr.RegisterType<typename T::insert_return_type>();
+						mngr.AddField<&T::insert_return_type::position>("position");
+						mngr.AddField<&T::insert_return_type::inserted>("inserted");
+						mngr.AddField<&T::insert_return_type::node>("node");
+					}
+
+					if constexpr (container_iterator<T> && container_const_iterator<T>)
+						mngr.AddConstructor<typename T::const_iterator, const typename T::iterator&>();
+					if constexpr (container_local_iterator<T> && container_const_local_iterator<T>)
+						mngr.AddConstructor<typename T::const_local_iterator, const typename T::local_iterator&>();
+				}
+			}
 
+			// container type attr
 			if constexpr (IsVector<T>)
 				mngr.AddTypeAttr(Type_of<T>, mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::Vector }));
 			else if constexpr (IsArray<T>)
@@ -931,60 +1057,6 @@ namespace Ubpa::UDRefl::details {
 				mngr.AddTypeAttr(Type_of<T>, mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::Variant }));
 			else if constexpr (IsOptional<T>)
 				mngr.AddTypeAttr(Type_of<T>, mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::Optional }));
-
-			// - type
-
-			if constexpr (std::is_array_v<T>) {
-				using value_type = std::remove_extent_t<T>;
-				using pointer = value_type*;
-				using const_pointer = const value_type*;
-				mngr.RegisterType<value_type>();
-				mngr.RegisterType<pointer>();
-				mngr.RegisterType<const_pointer>();
-			}
-			else {
-				
-				if constexpr (container_key_type<T>)
-					mngr.RegisterType<typename T::key_type>();
-				if constexpr (container_mapped_type<T>)
-					mngr.RegisterType<typename T::mapped_type>();
-				if constexpr (container_value_type<T>)
-					mngr.RegisterType<typename T::value_type>();
-				if constexpr (container_size_type<T>)
-					mngr.RegisterType<typename T::size_type>();
-				if constexpr (container_difference_type<T>)
-					mngr.RegisterType<typename T::difference_type>();
-				if constexpr (!is_instance_of_v<T, std::allocator>) {
-					if constexpr (container_pointer_type<T>)
-						mngr.RegisterType<typename T::pointer>();
-					if constexpr (container_const_pointer_type<T>)
-						mngr.RegisterType<typename T::const_pointer>();
-				}
-				if constexpr (container_iterator<T>) {
-					mngr.RegisterType<typename T::iterator>();
-					if constexpr (IsMultiSet<T> || IsUnorderedMultiSet<T>)
-						mngr.RegisterType<std::pair<typename T::iterator, bool>>();
-				}
-				if constexpr (container_const_iterator<T>)
-					mngr.RegisterType<typename T::const_iterator>();
-				if constexpr (container_local_iterator<T>)
-					mngr.RegisterType<typename T::local_iterator>();
-				if constexpr (container_const_local_iterator<T>)
-					mngr.RegisterType<typename T::const_local_iterator>();
-				if constexpr (container_node_type<T>)
-					mngr.RegisterType<typename T::node_type>();
-				if constexpr (container_insert_return_type<T>) {
-					mngr.RegisterType<typename T::insert_return_type>();
-					mngr.AddField<&T::insert_return_type::position>("position");
-					mngr.AddField<&T::insert_return_type::inserted>("inserted");
-					mngr.AddField<&T::insert_return_type::node>("node");
-				}
-
-				if constexpr (container_iterator<T> && container_const_iterator<T>)
-					mngr.AddConstructor<typename T::const_iterator, const typename T::iterator&>();
-				if constexpr (container_local_iterator<T> && container_const_local_iterator<T>)
-					mngr.AddConstructor<typename T::const_local_iterator, const typename T::local_iterator&>();
-			}
 		}
 	};
 
@@ -993,6 +1065,22 @@ namespace Ubpa::UDRefl::details {
 };
 
 namespace Ubpa::UDRefl {
+	template<typename A>
+	const A* ReflMngr::GetTypeAttr(Type type) const {
+		const TypeInfo* typeinfo = GetTypeInfo(type);
+		if (!typeinfo)
+			return nullptr;
+
+		if constexpr (AttrSlot<A>::index < NumAttrSlots)
+			return static_cast<const A*>(typeinfo->attrs.GetSlot(AttrSlot<A>::index));
+		else {
+			auto target = typeinfo->attrs.find(Type_of<A>);
+			if (target == typeinfo->attrs.end())
+				return nullptr;
+			return static_cast<const A*>(target->GetPtr());
+		}
+	}
+
 	//
 	// Factory
 	////////////
@@ -1219,30 +1307,38 @@ namespace Ubpa::UDRefl {
 	// Modifier
 	/////////////
 
+	template<typename T, typename AutoRegister>
+	void ReflMngr::RegisterTypeImpl() {
+		if (typeinfos.contains(Type_of<T>))
+			return;
+
+		TraceScope trace{ TraceEvent::RegisterType, Type_of<T> };
+		tregistry.Register<T>();
+		RegisterType(
+			Type_of<T>,
+			std::is_empty_v<T> ? 0 : sizeof(T), alignof(T),
+			std::is_polymorphic_v<T>,
+			std::is_trivial_v<T>
+		);
+
+		AutoRegister::run(*this);
+	}
+
 	template<typename T>
 	void ReflMngr::RegisterType() {
 		static_assert(!std::is_volatile_v<T>);
-		if constexpr (std::is_void_v<T>)
-			return;
-		else {
-			if constexpr (std::is_const_v<T>)
-				RegisterType<std::remove_const_t<T>>();
-			else if constexpr (std::is_reference_v<T>)
-				RegisterType<std::remove_cvref_t<T>>();
-			else {
-				if (typeinfos.contains(Type_of<T>))
-					return;
-
-				tregistry.Register<T>();
-				RegisterType(
-					Type_of<T>,
-					std::is_empty_v<T> ? 0 : sizeof(T), alignof(T),
-					std::is_polymorphic_v<T>,
-					std::is_trivial_v<T>
-				);
+		if constexpr (!std::is_void_v<T>) {
+			using U = std::remove_cvref_t<T>;
+			RegisterTypeImpl<U, details::TypeAutoRegister<U>>();
+		}
+	}
 
-				details::TypeAutoRegister<T>::run(*this);
-			}
+	template<typename T, AutoRegisterFlag Flags>
+	void ReflMngr::RegisterType() {
+		static_assert(!std::is_volatile_v<T>);
+		if constexpr (!std::is_void_v<T>) {
+			using U = std::remove_cvref_t<T>;
+			RegisterTypeImpl<U, details::TypeAutoRegister_Default<U, Flags>>();
 		}
 	}
 
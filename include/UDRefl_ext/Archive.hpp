@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Serialize.hpp"
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Ubpa::UDRefl::ext {
+	// zero-copy archive, the archived objects are used in place (e.g. a memory-mapped file) without reading
+	//
+	// every type T has an archived type (see ArchivedType), laid out by the registry (TypeInfo size / alignment)
+	// - trivial types without pointers : T itself
+	// - containers (see ContainerVTable) : ArchiveSpan<E>, a relative span of contiguous archived elements
+	// - pointers to registered types : ArchivePtr<E>, a relative pointer, a pointee is archived once per address
+	// - the other types with fields : data-driven type Archived<T> with the same bases and field names
+	// the archived span / pointer types are derived from ArchiveSpan / ArchivePtr without fields
+	//
+	// layout : ArchiveHeader | root object | elements and pointees (in the order of writing)
+	// - the header has the TypeID of the root type and a fingerprint of all archived layouts
+	//   (names, sizes, alignments, field names / offsets / types), ArchiveLoad compares them with the registry
+	// - native byte order, padding bytes are zero except inside trivially copied objects
+	//
+	// unsupported : the types which aren't supported by BinaryWrite (except pointers), pointers to unregistered types
+	// ArchivedType registers types, so the first use of a type must happen at the registration time
+
+	// relative pointer in archives, the offset is from the address of the ArchivePtr
+	struct ArchivePtr {
+		std::int64_t offset; // 0 : nullptr
+
+		const void* Get() const noexcept {
+			return offset == 0 ? nullptr : reinterpret_cast<const std::byte*>(this) + offset;
+		}
+
+		// T : the archived type of the pointee
+		template<typename T>
+		const T* As() const noexcept { return static_cast<const T*>(Get()); }
+	};
+
+	// relative span in archives, the offset is from the address of the ArchiveSpan
+	struct ArchiveSpan {
+		std::int64_t offset; // 0 if empty
+		std::uint64_t size;  // number of elements
+
+		const void* GetData() const noexcept {
+			return offset == 0 ? nullptr : reinterpret_cast<const std::byte*>(this) + offset;
+		}
+
+		// T : the archived type of elements
+		template<typename T>
+		std::span<const T> As() const noexcept { return { static_cast<const T*>(GetData()), static_cast<std::size_t>(size) }; }
+
+		std::string_view AsString() const noexcept { return { static_cast<const char*>(GetData()), static_cast<std::size_t>(size) }; }
+	};
+
+	static constexpr std::uint64_t ArchiveMagic = 0x0048435241524455; // "UDRARCH\0"
+	static constexpr std::uint32_t ArchiveVersion = 1;
+
+	struct ArchiveHeader {
+		std::uint64_t magic;       // ArchiveMagic
+		std::uint32_t version;     // ArchiveVersion
+		std::uint32_t alignment;   // the max alignment of archived types, the alignment of the archive's address
+		std::uint64_t type;        // TypeID of the root type (not archived)
+		std::uint64_t fingerprint; // layouts of all archived types
+		std::uint64_t root;        // offset of the root object
+		std::uint64_t size;        // size of the archive
+	};
+
+	// the archived type of type, registered on the first call
+	// invalid if the type isn't supported
+	UDRefl_ext_Serialize_API Type ArchivedType(Type type);
+
+	// return an empty vector if the type isn't supported
+	// std::vector's storage is aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__, over-aligned archives should be copied
+	UDRefl_ext_Serialize_API std::vector<std::byte> ArchiveWrite(ObjectView obj);
+
+	// check the header against the registry and return a const view of the root object (its type is ArchivedType(type))
+	// - archive : the address is aligned to ArchiveHeader::alignment (e.g. mmap, new)
+	// - verify : check all offsets in the archive, O(size of the archive), for untrusted archives
+	// return an invalid view if the archive isn't the type's, or it's corrupted
+	UDRefl_ext_Serialize_API ObjectView ArchiveLoad(Type type, std::span<const std::byte> archive, bool verify = false);
+
+	// elements of an archived span, invalid if span isn't an archived span
+	UDRefl_ext_Serialize_API ObjectSpan ArchiveElements(ObjectView span);
+
+	// pointee of an archived pointer, invalid if ptr isn't an archived pointer or it's null
+	UDRefl_ext_Serialize_API ObjectView ArchiveDeref(ObjectView ptr);
+
+	// read-only memory mapping of a whole file (page-aligned), empty on failure
+	UDRefl_ext_Serialize_API std::span<const std::byte> ArchiveMapFile(const std::filesystem::path& path);
+	UDRefl_ext_Serialize_API void ArchiveUnmapFile(std::span<const std::byte> bytes);
+
+	class ArchiveFile {
+	public:
+		ArchiveFile() noexcept = default;
+		explicit ArchiveFile(const std::filesystem::path& path) : bytes{ ArchiveMapFile(path) } {}
+		ArchiveFile(ArchiveFile&& other) noexcept : bytes{ std::exchange(other.bytes, {}) } {}
+		ArchiveFile& operator=(ArchiveFile&& rhs) noexcept {
+			if (this != &rhs) {
+				ArchiveUnmapFile(bytes);
+				bytes = std::exchange(rhs.bytes, {});
+			}
+			return *this;
+		}
+		~ArchiveFile() { ArchiveUnmapFile(bytes); }
+
+		bool IsOpen() const noexcept { return !bytes.empty(); }
+		std::span<const std::byte> GetBytes() const noexcept { return bytes; }
+
+	private:
+		std::span<const std::byte> bytes;
+	};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Serialize.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Ubpa::UDRefl::ext {
+	// field-level diff / patch between two objects of the same type, e.g. state replication
+	//
+	// patch : std::uint64_t TypeID + std::uint64_t count + entries
+	// - entry : std::uint32_t depth + std::uint64_t path[depth] + std::uint64_t size + new value (binary format, see BinaryWrite)
+	// - path steps : the index of a field (the fields of bases are flattened, in the order of offsets)
+	//   or the index of an element in a contiguous container, the empty path is the whole object
+	//
+	// a plan is compiled on the first use of a type and cached (thread-safe)
+	// - runs of adjacent trivially comparable fields (trivial, no padding) are compared by one memcmp,
+	//   and field by field only if they differ
+	// - nested types are compared field by field, the entries are their changed fields
+	// - contiguous containers of the same size are compared element by element (memcmp as a whole first),
+	//   other changed containers (resized, std::list, std::map, ...) are an entry of the whole container
+	// - trivial types without fields are compared bitwise (e.g. 0.f != -0.f)
+	//
+	// the types must be supported by BinaryWrite
+
+	UDRefl_ext_Serialize_API bool IsDiffable(Type type);
+
+	// write the patch which turns from into to (the same type without cvref) into patch (cleared first)
+	// return false if the types are different or unsupported
+	UDRefl_ext_Serialize_API bool Diff(ObjectView from, ObjectView to, std::vector<std::byte>& patch);
+
+	// return an empty vector if the types are different or unsupported
+	inline std::vector<std::byte> Diff(ObjectView from, ObjectView to) {
+		std::vector<std::byte> patch;
+		if (!Diff(from, to, patch))
+			patch.clear();
+		return patch;
+	}
+
+	// the number of entries of a patch, SerializeError if the header is corrupted
+	UDRefl_ext_Serialize_API std::size_t PatchEntryCount(std::span<const std::byte> patch);
+
+	// apply the entries of patch to a (non-const) obj in order
+	// return false if the patch isn't the type's, or it's corrupted (the entries before it are applied)
+	UDRefl_ext_Serialize_API bool Apply(ObjectView obj, std::span<const std::byte> patch);
+}
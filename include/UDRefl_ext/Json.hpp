@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Serialize.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace Ubpa::UDRefl::ext {
+	// streaming JSON of reflected objects
+	// - bool, integers, float, double : true / false, numbers (std::to_chars / std::from_chars), non-finite floats are null
+	// - std::string : string
+	// - containers (see ContainerVTable) : array, std::map's elements are objects { "first": ..., "second": ... }
+	// - types with fields : object, the fields of bases are members of the same object
+	//
+	// a plan is compiled on the first use of a type and cached (like BinaryWrite)
+	// - field keys are pre-rendered for writing, and looked up by NameID (sorted, binary search) for reading
+	// - the writer / reader buffer JsonChunkSize bytes, a document is never held as a whole
+	// - reading overwrites the fields in the document, unknown fields are skipped, missing fields are unchanged
+	//
+	// unsupported : enums, pointers, the types which aren't supported by BinaryWrite
+
+	static constexpr std::size_t JsonChunkSize = 16 * 1024;
+	// nesting depth of arrays / objects, deeper documents are rejected
+	static constexpr std::size_t JsonMaxDepth = 512;
+
+	// output of JsonWrite
+	class JsonSink {
+	public:
+		virtual ~JsonSink() = default;
+		// called per chunk (at most JsonChunkSize bytes except for long strings), return false to stop
+		virtual bool Write(std::string_view chunk) = 0;
+	};
+
+	class JsonStringSink final : public JsonSink {
+	public:
+		explicit JsonStringSink(std::string& str) noexcept : str{ str } {}
+		virtual bool Write(std::string_view chunk) override {
+			str.append(chunk);
+			return true;
+		}
+	private:
+		std::string& str;
+	};
+
+	class JsonOStreamSink final : public JsonSink {
+	public:
+		explicit JsonOStreamSink(std::ostream& os) noexcept : os{ os } {}
+		virtual bool Write(std::string_view chunk) override {
+			os.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+			return static_cast<bool>(os);
+		}
+	private:
+		std::ostream& os;
+	};
+
+	// input of JsonRead
+	class JsonSource {
+	public:
+		virtual ~JsonSource() = default;
+		// read at most size bytes into buffer, return the count, 0 at the end
+		virtual std::size_t Read(char* buffer, std::size_t size) = 0;
+	};
+
+	class JsonStringSource final : public JsonSource {
+	public:
+		explicit JsonStringSource(std::string_view str) noexcept : str{ str } {}
+		virtual std::size_t Read(char* buffer, std::size_t size) override {
+			const std::size_t n = std::min(size, str.size());
+			str.copy(buffer, n);
+			str.remove_prefix(n);
+			return n;
+		}
+	private:
+		std::string_view str;
+	};
+
+	class JsonIStreamSource final : public JsonSource {
+	public:
+		explicit JsonIStreamSource(std::istream& is) noexcept : is{ is } {}
+		virtual std::size_t Read(char* buffer, std::size_t size) override {
+			is.read(buffer, static_cast<std::streamsize>(size));
+			return static_cast<std::size_t>(is.gcount());
+		}
+	private:
+		std::istream& is;
+	};
+
+	UDRefl_ext_Serialize_API bool IsJsonSerializable(Type type);
+
+	// return false if the type isn't supported or the sink stops
+	UDRefl_ext_Serialize_API bool JsonWrite(ObjectView obj, JsonSink& sink);
+
+	// read a value into a constructed (non-const) obj, the content after the value is ignored
+	// return false if the document is invalid or doesn't match the type (obj may be partially read)
+	UDRefl_ext_Serialize_API bool JsonRead(ObjectView obj, JsonSource& source);
+
+	inline std::string JsonWriteString(ObjectView obj) {
+		std::string rst;
+		JsonStringSink sink{ rst };
+		if (!JsonWrite(obj, sink))
+			rst.clear();
+		return rst;
+	}
+
+	inline bool JsonReadString(ObjectView obj, std::string_view json) {
+		JsonStringSource source{ json };
+		return JsonRead(obj, source);
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <UDRefl/UDRefl.hpp>
+
+#if (defined(WIN32) || defined(_WIN32)) && defined(UBPA_UDREFL_SHARED)
+#ifdef UCMAKE_EXPORT_UDRefl_ext_Serialize
+#define UDRefl_ext_Serialize_API __declspec(dllexport)
+#else
+#define UDRefl_ext_Serialize_API __declspec(dllimport)
+#endif
+#else
+#define UDRefl_ext_Serialize_API extern
+#endif // (defined(WIN32) || defined(_WIN32)) && defined(UBPA_UDREFL_SHARED)
+
+namespace Ubpa::UDRefl::ext {
+	// compact binary format (native byte order, no type info, no padding)
+	// - fields (include the fields of bases) in the order of their offsets, nested types are flattened
+	// - trivial types without fields : raw bytes
+	// - containers (see ContainerVTable) : std::uint64_t count + elements
+	//
+	// a plan is compiled on the first use of a type and cached (thread-safe)
+	// - adjacent trivially copyable fields are merged into one memcpy
+	// - containers of trivially copyable elements are memcpy-ed as a whole if contiguous
+	// - types must not be changed (fields, bases, ...) after their first use
+	//
+	// unsupported : virtual bases / fields, reference fields, pointers, types without fields which aren't trivial or containers
+
+	static constexpr std::size_t SerializeError = static_cast<std::size_t>(-1);
+
+	struct SerializePlanInfo {
+		bool valid{ false };
+		std::size_t num_memcpy{ 0 };    // merged runs of trivially copyable fields
+		std::size_t num_container{ 0 }; // container fields
+	};
+
+	UDRefl_ext_Serialize_API SerializePlanInfo GetSerializePlanInfo(Type type);
+	UDRefl_ext_Serialize_API bool IsSerializable(Type type);
+
+	// the size of BinaryWrite's result, SerializeError if the type isn't serializable
+	UDRefl_ext_Serialize_API std::size_t BinarySize(ObjectView obj);
+
+	// write obj into buffer, no allocation
+	// return the written size, or SerializeError if the buffer is too small or the type isn't serializable
+	UDRefl_ext_Serialize_API std::size_t BinaryWrite(ObjectView obj, std::span<std::byte> buffer);
+
+	// read into a constructed (non-const) obj
+	// return the read size, or SerializeError if the buffer is corrupted or the type isn't serializable
+	UDRefl_ext_Serialize_API std::size_t BinaryRead(ObjectView obj, std::span<const std::byte> buffer);
+
+	// parallel binary format of contiguous containers (e.g. std::vector), the elements are supported by BinaryWrite
+	// - std::uint64_t count + std::uint64_t num_chunks
+	// - index : { std::uint64_t count, std::uint64_t size } per chunk
+	// - chunks : the elements of each chunk in the binary format, concatenated
+	// chunks (at most 256, at least 1024 elements each) are encoded / decoded independently,
+	// on num_threads threads (include the caller, 0 : std::thread::hardware_concurrency())
+	// - writing computes the sizes of chunks in parallel, then writes every chunk at its offset
+	// - reading resizes the container once (value-initialized elements), then reads every chunk in place
+	// elements are read / written concurrently, they mustn't share mutable states
+
+	// the size of ParallelBinaryWrite's result, SerializeError if the container isn't supported
+	UDRefl_ext_Serialize_API std::size_t ParallelBinarySize(ObjectView container, std::size_t num_threads = 0);
+
+	// write the container into buffer
+	// return the written size, or SerializeError if the buffer is too small or the container isn't supported
+	UDRefl_ext_Serialize_API std::size_t ParallelBinaryWrite(ObjectView container, std::span<std::byte> buffer, std::size_t num_threads = 0);
+
+	// read into a constructed (non-const) resizable container, or a fixed size container of the same size
+	// return the read size, or SerializeError if the buffer is corrupted or the container isn't supported
+	UDRefl_ext_Serialize_API std::size_t ParallelBinaryRead(ObjectView container, std::span<const std::byte> buffer, std::size_t num_threads = 0);
+
+	// tagged binary format, tolerant to the changes of types (fields added / removed / reordered)
+	// - types with fields : std::uint32_t count + fields { std::uint64_t NameID, varint size, value }
+	//   (the fields of bases are members of the same object)
+	//   the size is a LEB128 varint, minimal for raw-byte fields (1 byte below 128 bytes),
+	//   5 bytes for the other fields (patched after writing the value, < 32 GiB)
+	// - trivial types without fields : raw bytes
+	// - containers : std::uint64_t count (+ std::uint64_t element size if elements are raw bytes) + elements
+	//
+	// reading matches the fields by NameID (a hash table in the plan, the order of the writer is tried first)
+	// - unknown fields are skipped by their sizes
+	// - missing fields and the fields whose raw size changed are value-initialized (trivial types),
+	//   or destructed and default-constructed (kept if there is no default constructor)
+
+	UDRefl_ext_Serialize_API bool IsTaggedSerializable(Type type);
+
+	// the size of TaggedWrite's result, SerializeError if the type isn't serializable
+	UDRefl_ext_Serialize_API std::size_t TaggedSize(ObjectView obj);
+
+	// write obj into buffer, no allocation
+	// return the written size, or SerializeError if the buffer is too small or the type isn't serializable
+	UDRefl_ext_Serialize_API std::size_t TaggedWrite(ObjectView obj, std::span<std::byte> buffer);
+
+	// read into a constructed (non-const) obj
+	// return the read size, or SerializeError if the buffer is corrupted or the type isn't serializable
+	UDRefl_ext_Serialize_API std::size_t TaggedRead(ObjectView obj, std::span<const std::byte> buffer);
+}
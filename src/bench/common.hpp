@@ -0,0 +1,46 @@
+#pragma once
+
+#include <UDRefl/UDRefl.hpp>
+
+#include <benchmark/benchmark.h>
+
+// each file registers its types into Mngr, called by main before running
+void RegisterFieldBench();
+void RegisterMethodBench();
+void RegisterObjectBench();
+void RegisterContentionBench();
+#ifdef UBPA_UDREFL_BENCH_EXT_SERIALIZE
+void RegisterSerializeBench();
+#endif
+
+// field count
+
+struct Fields1 {
+	float f0;
+};
+
+struct Fields4 {
+	float f0, f1, f2, f3;
+};
+
+struct Fields16 {
+	float f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15;
+};
+
+// inheritance
+
+// single : S2 -> S1 -> S0
+struct S0 { float s0; };
+struct S1 : S0 { float s1; };
+struct S2 : S1 { float s2; };
+
+// multiple : M2 -> { M0, M1 }
+struct M0 { float m0; };
+struct M1 { float m1; };
+struct M2 : M0, M1 { float m2; };
+
+// virtual : V3 -> { V1, V2 } -> virtual V0
+struct V0 { float v0; };
+struct V1 : virtual V0 { float v1; };
+struct V2 : virtual V0 { float v2; };
+struct V3 : V1, V2 { float v3; };
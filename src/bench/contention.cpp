@@ -0,0 +1,133 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+// contention and scaling of the shared paths (IDRegistry::smutex, ReflMngr's synchronized pool resources)
+// - each benchmark runs from 1 to hardware_concurrency threads (real time)
+// - an iteration is a batch of BatchSize operations, only its first operation is timed, so the clock stays out of the others
+// - items_per_second : throughput of all threads
+// - p99_ns : 99th percentile of the latency of the sampled single operations (include the clock overhead),
+//   the samples of all threads are merged
+// run only these with --benchmark_filter=BM_MT
+
+namespace {
+	struct Accumulator {
+		float v;
+		float add(float x) const { return v + x; }
+	};
+
+	constexpr Name add_name{ "add" };
+	constexpr Name v_name{ "v" };
+
+	constexpr std::size_t BatchSize = 64;
+
+	// latency samples of all threads of a run, the last thread to finish takes the percentile
+	struct LatencySamples {
+		std::mutex mutex;
+		std::vector<double> samples;
+		int finished{ 0 };
+	} latency_samples;
+
+	template<typename Op>
+	void MeasureContended(benchmark::State& state, Op&& op) {
+		std::vector<double> latencies;
+		latencies.reserve(1 << 16);
+		for (auto _ : state) {
+			auto begin = std::chrono::steady_clock::now();
+			op();
+			auto end = std::chrono::steady_clock::now();
+			latencies.push_back(std::chrono::duration<double, std::nano>(end - begin).count());
+			for (std::size_t i = 1; i < BatchSize; i++)
+				op();
+		}
+		state.SetItemsProcessed(state.iterations() * BatchSize);
+
+		// the counter is summed over threads, only the last thread reports it
+		double p99 = 0.;
+		{
+			std::lock_guard lock{ latency_samples.mutex };
+			auto& samples = latency_samples.samples;
+			samples.insert(samples.end(), latencies.begin(), latencies.end());
+			if (++latency_samples.finished == state.threads()) {
+				if (!samples.empty()) {
+					auto target = samples.begin() + static_cast<std::ptrdiff_t>(samples.size() * 99 / 100);
+					std::nth_element(samples.begin(), target, samples.end());
+					p99 = *target;
+				}
+				samples.clear();
+				latency_samples.finished = 0;
+			}
+		}
+		state.counters["p99_ns"] = p99;
+	}
+
+	void BM_MT_Invoke(benchmark::State& state) {
+		Accumulator acc{ 1.f };
+		ObjectView obj{ acc };
+		float x = 2.f;
+		MeasureContended(state, [&] {
+			benchmark::DoNotOptimize(obj.Invoke(add_name, TempArgsView{ x }));
+		});
+	}
+
+	void BM_MT_Var(benchmark::State& state) {
+		Accumulator acc{ 1.f };
+		ObjectView obj{ acc };
+		MeasureContended(state, [&] {
+			benchmark::DoNotOptimize(obj.Var(v_name));
+		});
+	}
+
+	void BM_MT_MakeShared(benchmark::State& state) {
+		MeasureContended(state, [] {
+			benchmark::DoNotOptimize(Mngr.MakeShared(Type_of<Accumulator>));
+		});
+	}
+
+	void BM_MT_AddConst(benchmark::State& state) {
+		Accumulator acc{ 1.f };
+		ObjectView obj{ acc };
+		MeasureContended(state, [&] {
+			benchmark::DoNotOptimize(obj.AddConst());
+		});
+	}
+
+	void BM_MT_Viewof_Type(benchmark::State& state) {
+		const TypeID ID = Type_of<Accumulator>.GetID();
+		MeasureContended(state, [&] {
+			benchmark::DoNotOptimize(Mngr.tregistry.Viewof(ID));
+		});
+	}
+
+	void BM_MT_Viewof_Name(benchmark::State& state) {
+		const NameID ID = add_name.GetID();
+		MeasureContended(state, [&] {
+			benchmark::DoNotOptimize(Mngr.nregistry.Viewof(ID));
+		});
+	}
+
+	int MaxThreads() {
+		return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+	}
+
+	BENCHMARK(BM_MT_Invoke)->ThreadRange(1, MaxThreads())->UseRealTime();
+	BENCHMARK(BM_MT_Var)->ThreadRange(1, MaxThreads())->UseRealTime();
+	BENCHMARK(BM_MT_MakeShared)->ThreadRange(1, MaxThreads())->UseRealTime();
+	BENCHMARK(BM_MT_AddConst)->ThreadRange(1, MaxThreads())->UseRealTime();
+	BENCHMARK(BM_MT_Viewof_Type)->ThreadRange(1, MaxThreads())->UseRealTime();
+	BENCHMARK(BM_MT_Viewof_Name)->ThreadRange(1, MaxThreads())->UseRealTime();
+}
+
+void RegisterContentionBench() {
+	Mngr.RegisterType<Accumulator>();
+	Mngr.AddField<&Accumulator::v>(v_name);
+	Mngr.AddMethod<&Accumulator::add>(add_name);
+}
@@ -0,0 +1,147 @@
+#include "common.hpp"
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace {
+	Fields1 fields1{};
+	Fields4 fields4{};
+	Fields16 fields16{};
+	S2 s2{};
+	M2 m2{};
+	V3 v3{};
+
+	// native
+
+	void BM_Var_Native_Fields1(benchmark::State& state) {
+		Fields1* obj = &fields1;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(&obj->f0);
+		}
+	}
+	BENCHMARK(BM_Var_Native_Fields1);
+
+	void BM_Var_Native_Fields16(benchmark::State& state) {
+		Fields16* obj = &fields16;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(&obj->f15);
+		}
+	}
+	BENCHMARK(BM_Var_Native_Fields16);
+
+	void BM_Var_Native_Virtual(benchmark::State& state) {
+		V3* obj = &v3;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(&obj->v0);
+		}
+	}
+	BENCHMARK(BM_Var_Native_Virtual);
+
+	// reflection
+
+	void BM_Var(benchmark::State& state, ObjectView obj, Name name) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(obj.Var(name));
+		}
+	}
+	// field count (the last field)
+	BENCHMARK_CAPTURE(BM_Var, Fields1, ObjectView{ fields1 }, Name{ "f0" });
+	BENCHMARK_CAPTURE(BM_Var, Fields4, ObjectView{ fields4 }, Name{ "f3" });
+	BENCHMARK_CAPTURE(BM_Var, Fields16, ObjectView{ fields16 }, Name{ "f15" });
+	// inheritance (a field of the root base)
+	BENCHMARK_CAPTURE(BM_Var, Single, ObjectView{ s2 }, Name{ "s0" });
+	BENCHMARK_CAPTURE(BM_Var, Multiple, ObjectView{ m2 }, Name{ "m1" });
+	BENCHMARK_CAPTURE(BM_Var, Virtual, ObjectView{ v3 }, Name{ "v0" });
+
+	// GetVars
+
+	void BM_GetVars_Native_Fields16(benchmark::State& state) {
+		Fields16* obj = &fields16;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			float sum = obj->f0 + obj->f1 + obj->f2 + obj->f3
+				+ obj->f4 + obj->f5 + obj->f6 + obj->f7
+				+ obj->f8 + obj->f9 + obj->f10 + obj->f11
+				+ obj->f12 + obj->f13 + obj->f14 + obj->f15;
+			benchmark::DoNotOptimize(sum);
+		}
+	}
+	BENCHMARK(BM_GetVars_Native_Fields16);
+
+	void BM_GetVars(benchmark::State& state, ObjectView obj) {
+		for (auto _ : state) {
+			float sum = 0.f;
+			for (const auto& [name, var] : obj.GetVars())
+				sum += var.As<float>();
+			benchmark::DoNotOptimize(sum);
+		}
+	}
+	BENCHMARK_CAPTURE(BM_GetVars, Fields1, ObjectView{ fields1 });
+	BENCHMARK_CAPTURE(BM_GetVars, Fields4, ObjectView{ fields4 });
+	BENCHMARK_CAPTURE(BM_GetVars, Fields16, ObjectView{ fields16 });
+	BENCHMARK_CAPTURE(BM_GetVars, Single, ObjectView{ s2 });
+	BENCHMARK_CAPTURE(BM_GetVars, Multiple, ObjectView{ m2 });
+	BENCHMARK_CAPTURE(BM_GetVars, Virtual, ObjectView{ v3 });
+}
+
+void RegisterFieldBench() {
+	Mngr.RegisterType<Fields1>();
+	Mngr.AddField<&Fields1::f0>("f0");
+
+	Mngr.RegisterType<Fields4>();
+	Mngr.AddField<&Fields4::f0>("f0");
+	Mngr.AddField<&Fields4::f1>("f1");
+	Mngr.AddField<&Fields4::f2>("f2");
+	Mngr.AddField<&Fields4::f3>("f3");
+
+	Mngr.RegisterType<Fields16>();
+	Mngr.AddField<&Fields16::f0>("f0");
+	Mngr.AddField<&Fields16::f1>("f1");
+	Mngr.AddField<&Fields16::f2>("f2");
+	Mngr.AddField<&Fields16::f3>("f3");
+	Mngr.AddField<&Fields16::f4>("f4");
+	Mngr.AddField<&Fields16::f5>("f5");
+	Mngr.AddField<&Fields16::f6>("f6");
+	Mngr.AddField<&Fields16::f7>("f7");
+	Mngr.AddField<&Fields16::f8>("f8");
+	Mngr.AddField<&Fields16::f9>("f9");
+	Mngr.AddField<&Fields16::f10>("f10");
+	Mngr.AddField<&Fields16::f11>("f11");
+	Mngr.AddField<&Fields16::f12>("f12");
+	Mngr.AddField<&Fields16::f13>("f13");
+	Mngr.AddField<&Fields16::f14>("f14");
+	Mngr.AddField<&Fields16::f15>("f15");
+
+	Mngr.RegisterType<S0>();
+	Mngr.AddField<&S0::s0>("s0");
+	Mngr.RegisterType<S1>();
+	Mngr.AddBases<S1, S0>();
+	Mngr.AddField<&S1::s1>("s1");
+	Mngr.RegisterType<S2>();
+	Mngr.AddBases<S2, S1>();
+	Mngr.AddField<&S2::s2>("s2");
+
+	Mngr.RegisterType<M0>();
+	Mngr.AddField<&M0::m0>("m0");
+	Mngr.RegisterType<M1>();
+	Mngr.AddField<&M1::m1>("m1");
+	Mngr.RegisterType<M2>();
+	Mngr.AddBases<M2, M0, M1>();
+	Mngr.AddField<&M2::m2>("m2");
+
+	Mngr.RegisterType<V0>();
+	Mngr.AddField<&V0::v0>("v0");
+	Mngr.RegisterType<V1>();
+	Mngr.AddBases<V1, V0>();
+	Mngr.AddField<&V1::v1>("v1");
+	Mngr.RegisterType<V2>();
+	Mngr.AddBases<V2, V0>();
+	Mngr.AddField<&V2::v2>("v2");
+	Mngr.RegisterType<V3>();
+	Mngr.AddBases<V3, V1, V2>();
+	Mngr.AddField<&V3::v3>("v3");
+}
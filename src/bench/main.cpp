@@ -0,0 +1,37 @@
+#include "common.hpp"
+
+#include <string_view>
+#include <vector>
+
+// usage: UDRefl_bench [google benchmark flags]
+// the results are written to UDRefl_bench.json (JSON) unless --benchmark_out is given
+int main(int argc, char** argv) {
+	RegisterFieldBench();
+	RegisterMethodBench();
+	RegisterObjectBench();
+	RegisterContentionBench();
+#ifdef UBPA_UDREFL_BENCH_EXT_SERIALIZE
+	RegisterSerializeBench();
+#endif
+
+	std::vector<char*> args(argv, argv + argc);
+	bool has_out = false;
+	for (int i = 1; i < argc; i++) {
+		if (std::string_view{ argv[i] }.starts_with("--benchmark_out="))
+			has_out = true;
+	}
+	char default_out[] = "--benchmark_out=UDRefl_bench.json";
+	char default_out_format[] = "--benchmark_out_format=json";
+	if (!has_out) {
+		args.push_back(default_out);
+		args.push_back(default_out_format);
+	}
+
+	int args_size = static_cast<int>(args.size());
+	benchmark::Initialize(&args_size, args.data());
+	if (benchmark::ReportUnrecognizedArguments(args_size, args.data()))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
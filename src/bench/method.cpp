@@ -0,0 +1,122 @@
+#include "common.hpp"
+
+#include <array>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace {
+	struct Calc {
+		float v;
+		float add(float x) const { return v + x; }
+	};
+
+	template<std::size_t I>
+	struct Tag { float value; };
+
+	// N overloads of "f", the I-th takes Tag<I>
+	template<std::size_t N>
+	struct Overloads { float v; };
+
+	constexpr Name add_name{ "add" };
+	constexpr Name f_name{ "f" };
+
+	Calc calc{ 1.f };
+	Overloads<1> overloads1{ 1.f };
+	Overloads<4> overloads4{ 1.f };
+	Overloads<16> overloads16{ 1.f };
+
+	template<std::size_t N, std::size_t... Is>
+	void RegisterOverloads(std::index_sequence<Is...>) {
+		Mngr.RegisterType<Overloads<N>>();
+		(Mngr.RegisterType<Tag<Is>>(), ...);
+		(Mngr.AddMemberMethod(f_name, [](const Overloads<N>& obj, const Tag<Is>& tag) { return obj.v + tag.value; }), ...);
+	}
+
+	// native
+
+	void BM_Invoke_Native(benchmark::State& state) {
+		Calc* obj = &calc;
+		float x = 2.f;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(x);
+			benchmark::DoNotOptimize(obj->add(x));
+		}
+	}
+	BENCHMARK(BM_Invoke_Native);
+
+	// reflection
+
+	void BM_BInvoke(benchmark::State& state) {
+		ObjectView obj{ calc };
+		float x = 2.f;
+		float result;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj.BInvoke(add_name, &result, TempArgsView{ x }));
+			benchmark::DoNotOptimize(result);
+		}
+	}
+	BENCHMARK(BM_BInvoke);
+
+	void BM_MInvoke(benchmark::State& state) {
+		ObjectView obj{ calc };
+		float x = 2.f;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(obj.MInvoke(add_name, std::pmr::get_default_resource(), TempArgsView{ x }));
+	}
+	BENCHMARK(BM_MInvoke);
+
+	void BM_Invoke_Typed(benchmark::State& state) {
+		ObjectView obj{ calc };
+		float x = 2.f;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(obj.Invoke<float>(add_name, TempArgsView{ x }));
+	}
+	BENCHMARK(BM_Invoke_Typed);
+
+	// overload count (call the last registered overload)
+
+	Tag<0> tag0{ 2.f };
+	Tag<3> tag3{ 2.f };
+	Tag<15> tag15{ 2.f };
+
+	void BM_BInvoke_Overloads(benchmark::State& state, ObjectView obj, ObjectView arg) {
+		void* argptr_buffer[] = { arg.GetPtr() };
+		Type argTypes[] = { arg.GetType() };
+		float result;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj.BInvoke(f_name, &result, ArgsView{ argptr_buffer, argTypes }));
+			benchmark::DoNotOptimize(result);
+		}
+	}
+	BENCHMARK_CAPTURE(BM_BInvoke_Overloads, 1, ObjectView{ overloads1 }, ObjectView{ tag0 });
+	BENCHMARK_CAPTURE(BM_BInvoke_Overloads, 4, ObjectView{ overloads4 }, ObjectView{ tag3 });
+	BENCHMARK_CAPTURE(BM_BInvoke_Overloads, 16, ObjectView{ overloads16 }, ObjectView{ tag15 });
+
+	// IsCompatible
+
+	void BM_IsCompatible(benchmark::State& state, std::array<Type, 2> paramTypes, std::array<Type, 2> argTypes) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(Mngr.IsCompatible(paramTypes, argTypes));
+	}
+	BENCHMARK_CAPTURE(BM_IsCompatible, Same,
+		std::array{ Type_of<float>, Type_of<const Calc&> },
+		std::array{ Type_of<float>, Type_of<const Calc&> });
+	BENCHMARK_CAPTURE(BM_IsCompatible, RefConvert,
+		std::array{ Type_of<float>, Type_of<const Calc&> },
+		std::array{ Type_of<float&>, Type_of<Calc&> });
+	BENCHMARK_CAPTURE(BM_IsCompatible, PtrConvert,
+		std::array{ Type_of<const float*>, Type_of<const Calc*> },
+		std::array{ Type_of<float*>, Type_of<Calc*> });
+}
+
+void RegisterMethodBench() {
+	Mngr.RegisterType<Calc>();
+	Mngr.AddField<&Calc::v>("v");
+	Mngr.AddMethod<&Calc::add>(add_name);
+
+	RegisterOverloads<1>(std::make_index_sequence<1>{});
+	RegisterOverloads<4>(std::make_index_sequence<4>{});
+	RegisterOverloads<16>(std::make_index_sequence<16>{});
+}
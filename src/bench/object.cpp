@@ -0,0 +1,161 @@
+#include "common.hpp"
+
+#include <memory>
+#include <variant>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace {
+	struct Vec {
+		float x, y, z;
+		Vec() : x{ 0.f }, y{ 0.f }, z{ 0.f } {}
+		Vec(float x, float y, float z) : x{ x }, y{ y }, z{ z } {}
+	};
+
+	struct Buffer {
+		std::vector<float> data;
+	};
+
+	S2 s2{};
+	M2 m2{};
+	V3 v3{};
+
+	// message variant with 40 alternatives
+	template<std::size_t N>
+	struct Alt { std::size_t id = N; };
+
+	template<std::size_t... Ns>
+	std::variant<Alt<Ns>...> make_message_variant(std::index_sequence<Ns...>);
+	using Message = decltype(make_message_variant(std::make_index_sequence<40>{}));
+
+	Message last_message{ std::in_place_index<39> };
+
+	// MakeShared
+
+	void BM_MakeShared_Native(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(std::make_shared<Vec>());
+	}
+	BENCHMARK(BM_MakeShared_Native);
+
+	void BM_MakeShared_Native_Args(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(std::make_shared<Vec>(1.f, 2.f, 3.f));
+	}
+	BENCHMARK(BM_MakeShared_Native_Args);
+
+	void BM_MakeShared_Native_NonTrivial(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(std::make_shared<Buffer>());
+	}
+	BENCHMARK(BM_MakeShared_Native_NonTrivial);
+
+	void BM_MakeShared(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(Mngr.MakeShared(Type_of<Vec>));
+	}
+	BENCHMARK(BM_MakeShared);
+
+	void BM_MakeShared_Args(benchmark::State& state) {
+		float x = 1.f, y = 2.f, z = 3.f;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(Mngr.MakeShared(Type_of<Vec>, TempArgsView{ x, y, z }));
+	}
+	BENCHMARK(BM_MakeShared_Args);
+
+	void BM_MakeShared_NonTrivial(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(Mngr.MakeShared(Type_of<Buffer>));
+	}
+	BENCHMARK(BM_MakeShared_NonTrivial);
+
+	// cast (derived to the root base)
+
+	void BM_Cast_Native_Single(benchmark::State& state) {
+		S2* obj = &s2;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(static_cast<S0*>(obj));
+		}
+	}
+	BENCHMARK(BM_Cast_Native_Single);
+
+	void BM_Cast_Native_Multiple(benchmark::State& state) {
+		M2* obj = &m2;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(static_cast<M1*>(obj));
+		}
+	}
+	BENCHMARK(BM_Cast_Native_Multiple);
+
+	void BM_Cast_Native_Virtual(benchmark::State& state) {
+		V3* obj = &v3;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(static_cast<V0*>(obj));
+		}
+	}
+	BENCHMARK(BM_Cast_Native_Virtual);
+
+	void BM_StaticCast_DerivedToBase(benchmark::State& state, ObjectView obj, Type base) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(obj.StaticCast_DerivedToBase(base));
+		}
+	}
+	BENCHMARK_CAPTURE(BM_StaticCast_DerivedToBase, Single, ObjectView{ s2 }, Type_of<S0>);
+	BENCHMARK_CAPTURE(BM_StaticCast_DerivedToBase, Multiple, ObjectView{ m2 }, Type_of<M1>);
+	BENCHMARK_CAPTURE(BM_StaticCast_DerivedToBase, Virtual, ObjectView{ v3 }, Type_of<V0>);
+
+	void BM_StaticCast_BaseToDerived(benchmark::State& state, ObjectView obj, Type derived) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(obj);
+			benchmark::DoNotOptimize(obj.StaticCast_BaseToDerived(derived));
+		}
+	}
+	BENCHMARK_CAPTURE(BM_StaticCast_BaseToDerived, Single, ObjectView{ static_cast<S0&>(s2) }, Type_of<S2>);
+	BENCHMARK_CAPTURE(BM_StaticCast_BaseToDerived, Multiple, ObjectView{ static_cast<M1&>(m2) }, Type_of<M2>);
+
+	// Variant (the last alternative)
+
+	void BM_VariantVisitGet_Native(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(std::visit([](auto& alt) -> void* { return &alt; }, last_message));
+	}
+	BENCHMARK(BM_VariantVisitGet_Native);
+
+	void BM_VariantVisitGet(benchmark::State& state) {
+		ObjectView msg{ last_message };
+		for (auto _ : state)
+			benchmark::DoNotOptimize(msg.variant_visit_get());
+	}
+	BENCHMARK(BM_VariantVisitGet);
+
+	void BM_VariantHoldsAlternative(benchmark::State& state) {
+		ObjectView msg{ last_message };
+		for (auto _ : state)
+			benchmark::DoNotOptimize(msg.holds_alternative(Type_of<Alt<39>>));
+	}
+	BENCHMARK(BM_VariantHoldsAlternative);
+
+	template<std::size_t... Ns>
+	void RegisterAlts(std::index_sequence<Ns...>) {
+		(Mngr.RegisterType<Alt<Ns>>(), ...);
+	}
+}
+
+void RegisterObjectBench() {
+	Mngr.RegisterType<Vec>();
+	Mngr.AddConstructor<Vec, float, float, float>();
+	Mngr.AddField<&Vec::x>("x");
+	Mngr.AddField<&Vec::y>("y");
+	Mngr.AddField<&Vec::z>("z");
+
+	Mngr.RegisterType<Buffer>();
+	Mngr.AddField<&Buffer::data>("data");
+
+	RegisterAlts(std::make_index_sequence<std::variant_size_v<Message>>{});
+	Mngr.RegisterType<Message>();
+}
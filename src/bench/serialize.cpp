@@ -0,0 +1,313 @@
+#ifdef UBPA_UDREFL_BENCH_EXT_SERIALIZE
+
+#include "common.hpp"
+
+#include <UDRefl_ext/Archive.hpp>
+#include <UDRefl_ext/Diff.hpp>
+#include <UDRefl_ext/Json.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace {
+	struct Transform {
+		float position[3];
+		float rotation[4];
+		float scale[3];
+	};
+
+	struct Record {
+		std::uint32_t id;
+		Transform transform;
+		double time;
+		std::string name;
+		std::vector<float> samples;
+	};
+
+	constexpr std::size_t NumRecords = 256;
+	constexpr std::size_t NumLargeRecords = 64 * 1024;
+
+	std::vector<Record> records;
+	std::vector<Record> large_records; // parallel
+	std::vector<Fields16> pods;
+	std::vector<std::byte> buffer;
+
+	// hand-written, the same format as ext::BinaryWrite
+
+	void WriteBytes(std::byte*& cur, const void* src, std::size_t n) {
+		std::memcpy(cur, src, n);
+		cur += n;
+	}
+
+	void ReadBytes(const std::byte*& cur, void* dst, std::size_t n) {
+		std::memcpy(dst, cur, n);
+		cur += n;
+	}
+
+	void WriteRecords(std::byte*& cur, const std::vector<Record>& rs) {
+		const std::uint64_t count = rs.size();
+		WriteBytes(cur, &count, sizeof(count));
+		for (const auto& r : rs) {
+			WriteBytes(cur, &r.id, sizeof(r.id));
+			WriteBytes(cur, &r.transform, sizeof(r.transform));
+			WriteBytes(cur, &r.time, sizeof(r.time));
+			const std::uint64_t name_size = r.name.size();
+			WriteBytes(cur, &name_size, sizeof(name_size));
+			WriteBytes(cur, r.name.data(), r.name.size());
+			const std::uint64_t samples_size = r.samples.size();
+			WriteBytes(cur, &samples_size, sizeof(samples_size));
+			WriteBytes(cur, r.samples.data(), r.samples.size() * sizeof(float));
+		}
+	}
+
+	void ReadRecords(const std::byte*& cur, std::vector<Record>& rs) {
+		std::uint64_t count;
+		ReadBytes(cur, &count, sizeof(count));
+		rs.clear();
+		rs.reserve(count);
+		for (std::uint64_t i = 0; i < count; i++) {
+			auto& r = rs.emplace_back();
+			ReadBytes(cur, &r.id, sizeof(r.id));
+			ReadBytes(cur, &r.transform, sizeof(r.transform));
+			ReadBytes(cur, &r.time, sizeof(r.time));
+			std::uint64_t name_size;
+			ReadBytes(cur, &name_size, sizeof(name_size));
+			r.name.resize(name_size);
+			ReadBytes(cur, r.name.data(), name_size);
+			std::uint64_t samples_size;
+			ReadBytes(cur, &samples_size, sizeof(samples_size));
+			r.samples.resize(samples_size);
+			ReadBytes(cur, r.samples.data(), samples_size * sizeof(float));
+		}
+	}
+
+	// nested records
+
+	void BM_SerializeWrite_Native(benchmark::State& state) {
+		for (auto _ : state) {
+			std::byte* cur = buffer.data();
+			WriteRecords(cur, records);
+			benchmark::DoNotOptimize(cur);
+		}
+		state.SetBytesProcessed(state.iterations() * ext::BinarySize(ObjectView{ records }));
+	}
+	BENCHMARK(BM_SerializeWrite_Native);
+
+	void BM_SerializeWrite(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::BinaryWrite(ObjectView{ records }, buffer));
+		state.SetBytesProcessed(state.iterations() * ext::BinarySize(ObjectView{ records }));
+	}
+	BENCHMARK(BM_SerializeWrite);
+
+	void BM_SerializeRead_Native(benchmark::State& state) {
+		std::byte* end = buffer.data();
+		WriteRecords(end, records);
+		std::vector<Record> dst;
+		for (auto _ : state) {
+			const std::byte* cur = buffer.data();
+			ReadRecords(cur, dst);
+			benchmark::DoNotOptimize(dst.data());
+		}
+		state.SetBytesProcessed(state.iterations() * (end - buffer.data()));
+	}
+	BENCHMARK(BM_SerializeRead_Native);
+
+	void BM_SerializeRead(benchmark::State& state) {
+		const std::size_t size = ext::BinaryWrite(ObjectView{ records }, buffer);
+		std::vector<Record> dst;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::BinaryRead(ObjectView{ dst }, std::span{ buffer }.first(size)));
+		state.SetBytesProcessed(state.iterations() * size);
+	}
+	BENCHMARK(BM_SerializeRead);
+
+	// trivially copyable elements, a single memcpy
+
+	void BM_SerializeWritePOD_Native(benchmark::State& state) {
+		for (auto _ : state) {
+			std::byte* cur = buffer.data();
+			const std::uint64_t count = pods.size();
+			WriteBytes(cur, &count, sizeof(count));
+			WriteBytes(cur, pods.data(), pods.size() * sizeof(Fields16));
+			benchmark::DoNotOptimize(cur);
+		}
+		state.SetBytesProcessed(state.iterations() * pods.size() * sizeof(Fields16));
+	}
+	BENCHMARK(BM_SerializeWritePOD_Native);
+
+	void BM_SerializeWritePOD(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::BinaryWrite(ObjectView{ pods }, buffer));
+		state.SetBytesProcessed(state.iterations() * pods.size() * sizeof(Fields16));
+	}
+	BENCHMARK(BM_SerializeWritePOD);
+
+	// JSON
+
+	class DiscardSink final : public ext::JsonSink {
+	public:
+		virtual bool Write(std::string_view chunk) override {
+			size += chunk.size();
+			return true;
+		}
+		std::size_t size{ 0 };
+	};
+
+	void BM_JsonWrite(benchmark::State& state) {
+		DiscardSink sink;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::JsonWrite(ObjectView{ records }, sink));
+		state.SetBytesProcessed(static_cast<std::int64_t>(sink.size));
+	}
+	BENCHMARK(BM_JsonWrite);
+
+	void BM_JsonRead(benchmark::State& state) {
+		const std::string json = ext::JsonWriteString(ObjectView{ records });
+		std::vector<Record> dst;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::JsonReadString(ObjectView{ dst }, json));
+		state.SetBytesProcessed(state.iterations() * json.size());
+	}
+	BENCHMARK(BM_JsonRead);
+
+	// tagged, version-tolerant
+
+	void BM_TaggedWrite(benchmark::State& state) {
+		std::vector<std::byte> tagged(ext::TaggedSize(ObjectView{ records }));
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::TaggedWrite(ObjectView{ records }, tagged));
+		state.SetBytesProcessed(state.iterations() * ext::BinarySize(ObjectView{ records }));
+	}
+	BENCHMARK(BM_TaggedWrite);
+
+	void BM_TaggedRead(benchmark::State& state) {
+		std::vector<std::byte> tagged(ext::TaggedSize(ObjectView{ records }));
+		ext::TaggedWrite(ObjectView{ records }, tagged);
+		std::vector<Record> dst;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::TaggedRead(ObjectView{ dst }, tagged));
+		state.SetBytesProcessed(state.iterations() * ext::BinarySize(ObjectView{ records }));
+		// compare the time with BM_SerializeRead
+		state.counters["size_vs_binary"] = static_cast<double>(tagged.size()) / ext::BinarySize(ObjectView{ records });
+	}
+	BENCHMARK(BM_TaggedRead);
+
+	// zero-copy archive, load + access the last record vs BinaryRead
+
+	void BM_ArchiveWrite(benchmark::State& state) {
+		std::size_t size = 0;
+		for (auto _ : state) {
+			auto archive = ext::ArchiveWrite(ObjectView{ records });
+			size = archive.size();
+			benchmark::DoNotOptimize(archive.data());
+		}
+		state.SetBytesProcessed(state.iterations() * size);
+	}
+	BENCHMARK(BM_ArchiveWrite);
+
+	void BM_ArchiveLoad(benchmark::State& state) {
+		const std::vector<std::byte> archive = ext::ArchiveWrite(ObjectView{ records });
+		const bool verify = state.range(0) != 0;
+		for (auto _ : state) {
+			ObjectView root = ext::ArchiveLoad(Type_of<std::vector<Record>>, archive, verify);
+			ObjectSpan elements = ext::ArchiveElements(root);
+			benchmark::DoNotOptimize(elements[elements.Size() - 1].Var("time").GetPtr());
+		}
+		state.SetBytesProcessed(state.iterations() * archive.size());
+	}
+	BENCHMARK(BM_ArchiveLoad)->Arg(0)->Arg(1);
+
+	// parallel, the argument is the number of threads
+
+	void BM_ParallelWrite(benchmark::State& state) {
+		const auto num_threads = static_cast<std::size_t>(state.range(0));
+		std::vector<std::byte> large_buffer(ext::ParallelBinarySize(ObjectView{ large_records }));
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::ParallelBinaryWrite(ObjectView{ large_records }, large_buffer, num_threads));
+		state.SetBytesProcessed(state.iterations() * large_buffer.size());
+	}
+	BENCHMARK(BM_ParallelWrite)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+	void BM_ParallelRead(benchmark::State& state) {
+		const auto num_threads = static_cast<std::size_t>(state.range(0));
+		std::vector<std::byte> large_buffer(ext::ParallelBinarySize(ObjectView{ large_records }));
+		ext::ParallelBinaryWrite(ObjectView{ large_records }, large_buffer);
+		std::vector<Record> dst;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::ParallelBinaryRead(ObjectView{ dst }, large_buffer, num_threads));
+		state.SetBytesProcessed(state.iterations() * large_buffer.size());
+	}
+	BENCHMARK(BM_ParallelRead)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+	// diff / patch, a field of every 16th record changed vs the whole binary
+
+	void BM_Diff(benchmark::State& state) {
+		std::vector<Record> next = records;
+		for (std::size_t i = 0; i < next.size(); i += 16)
+			next[i].transform.position[1] += 1.f;
+		std::vector<std::byte> patch;
+		for (auto _ : state) {
+			ext::Diff(ObjectView{ records }, ObjectView{ next }, patch);
+			benchmark::DoNotOptimize(patch.data());
+		}
+		state.counters["patch_bytes"] = static_cast<double>(patch.size());
+		state.counters["binary_bytes"] = static_cast<double>(ext::BinarySize(ObjectView{ next }));
+	}
+	BENCHMARK(BM_Diff);
+
+	void BM_Apply(benchmark::State& state) {
+		std::vector<Record> next = records;
+		for (std::size_t i = 0; i < next.size(); i += 16)
+			next[i].transform.position[1] += 1.f;
+		const std::vector<std::byte> patch = ext::Diff(ObjectView{ records }, ObjectView{ next });
+		std::vector<Record> dst = records;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::Apply(ObjectView{ dst }, patch));
+	}
+	BENCHMARK(BM_Apply);
+
+	void BM_SerializeSize(benchmark::State& state) {
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ext::BinarySize(ObjectView{ records }));
+	}
+	BENCHMARK(BM_SerializeSize);
+}
+
+void RegisterSerializeBench() {
+	Mngr.RegisterType<Transform>();
+	Mngr.AddField<&Transform::position>("position");
+	Mngr.AddField<&Transform::rotation>("rotation");
+	Mngr.AddField<&Transform::scale>("scale");
+
+	Mngr.RegisterType<Record>();
+	Mngr.AddField<&Record::id>("id");
+	Mngr.AddField<&Record::transform>("transform");
+	Mngr.AddField<&Record::time>("time");
+	Mngr.AddField<&Record::name>("name");
+	Mngr.AddField<&Record::samples>("samples");
+
+	Mngr.RegisterType<std::vector<Record>>();
+	Mngr.RegisterType<std::vector<Fields16>>();
+
+	records.resize(NumRecords);
+	for (std::size_t i = 0; i < NumRecords; i++) {
+		auto& r = records[i];
+		r.id = static_cast<std::uint32_t>(i);
+		r.transform = { { 1.f, 2.f, 3.f }, { 0.f, 0.f, 0.f, 1.f }, { 1.f, 1.f, 1.f } };
+		r.time = static_cast<double>(i) * 0.5;
+		r.name = "record_" + std::to_string(i);
+		r.samples.assign(16, static_cast<float>(i));
+	}
+	pods.resize(4 * NumRecords);
+	large_records.resize(NumLargeRecords);
+	for (std::size_t i = 0; i < NumLargeRecords; i++)
+		large_records[i] = records[i % NumRecords];
+
+	buffer.resize(std::max(ext::BinarySize(ObjectView{ records }), ext::BinarySize(ObjectView{ pods })));
+}
+
+#endif // UBPA_UDREFL_BENCH_EXT_SERIALIZE
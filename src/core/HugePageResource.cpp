@@ -0,0 +1,203 @@
+#include <UDRefl/HugePageResource.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using namespace Ubpa::UDRefl;
+
+namespace Ubpa::UDRefl::details {
+	static constexpr std::size_t PageSize = 4096;
+	static constexpr std::size_t SlabSize = 64 * 1024;
+
+	static constexpr std::size_t RoundUp(std::size_t n, std::size_t alignment) noexcept {
+		return (n + (alignment - 1)) & ~(alignment - 1);
+	}
+
+	// largest power of 2 which divides n
+	static constexpr std::size_t LowBit(std::size_t n) noexcept {
+		return n & (~n + 1);
+	}
+
+	static void* MapMemory(std::size_t size) noexcept {
+#if defined(_WIN32)
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+		flags |= MAP_NORESERVE;
+#endif
+		void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+		return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+	}
+
+	static void UnmapMemory(void* ptr, std::size_t size) noexcept {
+#if defined(_WIN32)
+		VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+		munmap(ptr, size);
+#endif
+	}
+}
+
+HugePageResource::HugePageResource(std::size_t chunk_size)
+	: chunk_size{ details::RoundUp(chunk_size > 0 ? chunk_size : DefaultChunkSize, HugePageSize) } {}
+
+HugePageResource::~HugePageResource() {
+	Clear();
+}
+
+void HugePageResource::Clear() noexcept {
+	std::lock_guard lock{ mutex };
+
+	for (const auto& chunk : chunks)
+		details::UnmapMemory(chunk.ptr, chunk.size);
+	for (const auto& [ptr, large] : larges)
+		details::UnmapMemory(large.ptr, large.size);
+
+	chunks.clear();
+	larges.clear();
+	classes = {};
+	chunk_cursor = nullptr;
+	chunk_end = nullptr;
+
+	stats.reserved_bytes = 0;
+	stats.allocated_bytes = 0;
+	stats.num_chunks = 0;
+	stats.num_large_blocks = 0;
+}
+
+HugePageResource::Stats HugePageResource::GetStats() const {
+	std::lock_guard lock{ mutex };
+	return stats;
+}
+
+void* HugePageResource::CarveSlab(std::size_t bytes, std::size_t alignment) {
+	std::byte* ptr = reinterpret_cast<std::byte*>(details::RoundUp(reinterpret_cast<std::size_t>(chunk_cursor), alignment));
+	if (!chunk_cursor || ptr + bytes > chunk_end) {
+		// the rest of current chunk is wasted, but it's never touched (so never committed)
+#if defined(_WIN32)
+		void* chunk = details::MapMemory(chunk_size);
+		if (!chunk)
+			throw std::bad_alloc{};
+		chunks.push_back({ chunk, chunk_size });
+#else
+		// over-map to align the chunk to a huge page
+		const std::size_t map_size = chunk_size + HugePageSize;
+		void* raw = details::MapMemory(map_size);
+		if (!raw)
+			throw std::bad_alloc{};
+		std::byte* raw_begin = static_cast<std::byte*>(raw);
+		std::byte* chunk_begin = reinterpret_cast<std::byte*>(details::RoundUp(reinterpret_cast<std::size_t>(raw_begin), HugePageSize));
+		std::byte* chunk_last = chunk_begin + chunk_size;
+		if (chunk_begin != raw_begin)
+			details::UnmapMemory(raw_begin, static_cast<std::size_t>(chunk_begin - raw_begin));
+		if (chunk_last != raw_begin + map_size)
+			details::UnmapMemory(chunk_last, static_cast<std::size_t>(raw_begin + map_size - chunk_last));
+		void* chunk = chunk_begin;
+		chunks.push_back({ chunk, chunk_size });
+#ifdef MADV_HUGEPAGE
+		if (madvise(chunk, chunk_size, MADV_HUGEPAGE) == 0)
+			++stats.num_huge_page_advised;
+#endif
+#endif
+		stats.reserved_bytes += chunk_size;
+		++stats.num_chunks;
+
+		chunk_cursor = static_cast<std::byte*>(chunk);
+		chunk_end = chunk_cursor + chunk_size;
+		ptr = chunk_cursor;
+	}
+	chunk_cursor = ptr + bytes;
+	return ptr;
+}
+
+void* HugePageResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	const std::size_t size = details::RoundUp(std::max<std::size_t>(bytes, 1), std::max(alignment, Granularity));
+
+	std::lock_guard lock{ mutex };
+
+	void* ptr;
+	if (size > MaxSmallSize) {
+		// map directly
+		const std::size_t map_alignment = std::max(alignment, details::PageSize);
+		const std::size_t map_size = details::RoundUp(size, details::PageSize) + (map_alignment - details::PageSize);
+		void* raw = details::MapMemory(map_size);
+		if (!raw)
+			throw std::bad_alloc{};
+		ptr = reinterpret_cast<void*>(details::RoundUp(reinterpret_cast<std::size_t>(raw), map_alignment));
+		larges.emplace(ptr, Block{ raw, map_size });
+		stats.reserved_bytes += map_size;
+		stats.allocated_bytes += map_size;
+		++stats.num_large_blocks;
+	}
+	else {
+		auto& sizeclass = classes[size / Granularity - 1];
+		if (sizeclass.freelist) {
+			FreeNode* node = sizeclass.freelist;
+			sizeclass.freelist = node->next;
+			ptr = node;
+			++stats.num_reused_blocks;
+		}
+		else {
+			// slabs are page-aligned, so every block (slab + i * size) is aligned to LowBit(size) >= alignment
+			if (!sizeclass.slab_cursor || sizeclass.slab_cursor + size > sizeclass.slab_end) {
+				const std::size_t slab_size = std::max(details::SlabSize, details::RoundUp(16 * size, details::PageSize));
+				sizeclass.slab_cursor = static_cast<std::byte*>(CarveSlab(slab_size, details::PageSize));
+				sizeclass.slab_end = sizeclass.slab_cursor + slab_size;
+			}
+			assert(details::LowBit(size) >= alignment);
+			ptr = sizeclass.slab_cursor;
+			sizeclass.slab_cursor += size;
+		}
+		stats.allocated_bytes += size;
+	}
+
+	++stats.num_allocations;
+	if (stats.allocated_bytes > stats.peak_allocated_bytes)
+		stats.peak_allocated_bytes = stats.allocated_bytes;
+
+	return ptr;
+}
+
+void HugePageResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+	assert(p);
+
+	const std::size_t size = details::RoundUp(std::max<std::size_t>(bytes, 1), std::max(alignment, Granularity));
+
+	std::lock_guard lock{ mutex };
+
+	if (size > MaxSmallSize) {
+		auto target = larges.find(p);
+		assert(target != larges.end());
+		details::UnmapMemory(target->second.ptr, target->second.size);
+		stats.reserved_bytes -= target->second.size;
+		stats.allocated_bytes -= target->second.size;
+		--stats.num_large_blocks;
+		larges.erase(target);
+	}
+	else {
+		auto& sizeclass = classes[size / Granularity - 1];
+		FreeNode* node = static_cast<FreeNode*>(p);
+		node->next = sizeclass.freelist;
+		sizeclass.freelist = node;
+		stats.allocated_bytes -= size;
+	}
+
+	++stats.num_deallocations;
+}
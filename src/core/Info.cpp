@@ -0,0 +1,14 @@
+#include <UDRefl/Info.hpp>
+
+using namespace Ubpa::UDRefl;
+
+UDRefl_core_API const AttrSet& Ubpa::UDRefl::EmptyAttrSet() noexcept {
+	static const AttrSet attrs;
+	return attrs;
+}
+
+UDRefl_core_API std::size_t Ubpa::UDRefl::GetAttrSlotIndex(Type type) noexcept {
+	if (type == Type_of<ContainerType>)
+		return AttrSlot<ContainerType>::index;
+	return NumAttrSlots;
+}
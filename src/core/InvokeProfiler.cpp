@@ -0,0 +1,195 @@
+#include "InvokeProfiler.hpp"
+
+#include <UDRefl/ReflMngr.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+#include <mutex>
+#include <unordered_map>
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+InvokeStats& InvokeStats::operator+=(const InvokeStats& rhs) noexcept {
+	calls += rhs.calls;
+	failures += rhs.failures;
+	time_ns += rhs.time_ns;
+	overloads_tried += rhs.overloads_tried;
+	for (std::size_t i = 0; i < NumInvokePhase; i++)
+		phase_hits[i] += rhs.phase_hits[i];
+	copied_args += rhs.copied_args;
+	pointer_array_args += rhs.pointer_array_args;
+	derived_args += rhs.derived_args;
+	return *this;
+}
+
+InvokeStats InvokeReport::Total() const noexcept {
+	InvokeStats total;
+	for (const auto& entry : entries)
+		total += entry.stats;
+	return total;
+}
+
+void InvokeReport::WriteCSV(std::ostream& os) const {
+	os << "type,method,calls,failures,time_ns,overloads_tried,exact,exact_const,convert,convert_const,copied_args,pointer_array_args,derived_args\n";
+	for (const auto& [type, method, stats] : entries) {
+		// names may contain ',' (e.g. std::map<int, float>)
+		os << '"' << type.GetName() << "\",\"" << method.GetView() << '"'
+			<< ',' << stats.calls
+			<< ',' << stats.failures
+			<< ',' << stats.time_ns
+			<< ',' << stats.overloads_tried;
+		for (const auto& hits : stats.phase_hits)
+			os << ',' << hits;
+		os << ',' << stats.copied_args
+			<< ',' << stats.pointer_array_args
+			<< ',' << stats.derived_args
+			<< '\n';
+	}
+}
+
+std::ostream& Ubpa::UDRefl::operator<<(std::ostream& os, const InvokeReport& report) {
+	os << std::left
+		<< std::setw(48) << "type::method" << std::right
+		<< std::setw(10) << "calls"
+		<< std::setw(10) << "failures"
+		<< std::setw(14) << "time(us)"
+		<< std::setw(12) << "avg(ns)"
+		<< std::setw(12) << "overloads"
+		<< std::setw(10) << "converts"
+		<< '\n';
+	auto print_row = [&](std::string_view name, const InvokeStats& stats) {
+		os << std::left << std::setw(48) << name << std::right
+			<< std::setw(10) << stats.calls
+			<< std::setw(10) << stats.failures
+			<< std::setw(14) << stats.time_ns / 1000
+			<< std::setw(12) << (stats.calls ? stats.time_ns / stats.calls : 0)
+			<< std::setw(12) << stats.overloads_tried
+			<< std::setw(10) << stats.copied_args + stats.pointer_array_args + stats.derived_args
+			<< '\n';
+	};
+	for (const auto& [type, method, stats] : report.entries) {
+		std::string name;
+		name.append(type.GetName());
+		name.append("::");
+		name.append(method.GetView());
+		print_row(name, stats);
+	}
+	print_row("[total]", report.Total());
+	return os;
+}
+
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+namespace Ubpa::UDRefl::details {
+	struct InvokeKey {
+		TypeID type;
+		NameID method;
+		bool operator==(const InvokeKey&) const noexcept = default;
+	};
+
+	struct InvokeKeyHash {
+		std::size_t operator()(const InvokeKey& key) const noexcept {
+			return key.type.GetValue() ^ (key.method.GetValue() * 0x9e3779b97f4a7c15ull);
+		}
+	};
+
+	using InvokeStatsMap = std::unordered_map<InvokeKey, InvokeStats, InvokeKeyHash>;
+
+	// the counters of a thread, only the owner thread writes
+	// the mutex is uncontended except merging / resetting
+	struct ThreadInvokeProfile {
+		ThreadInvokeProfile();
+		~ThreadInvokeProfile();
+
+		std::mutex mutex;
+		InvokeStatsMap stats;
+	};
+
+	struct InvokeProfiles {
+		std::mutex mutex;
+		std::vector<ThreadInvokeProfile*> threads;
+		InvokeStatsMap retired; // counters of exited threads
+
+		static InvokeProfiles& Instance() {
+			static InvokeProfiles instance;
+			return instance;
+		}
+	};
+
+	ThreadInvokeProfile::ThreadInvokeProfile() {
+		auto& profiles = InvokeProfiles::Instance();
+		std::lock_guard lock{ profiles.mutex };
+		profiles.threads.push_back(this);
+	}
+
+	ThreadInvokeProfile::~ThreadInvokeProfile() {
+		auto& profiles = InvokeProfiles::Instance();
+		std::lock_guard lock{ profiles.mutex };
+		for (const auto& [key, value] : stats)
+			profiles.retired[key] += value;
+		profiles.threads.erase(std::find(profiles.threads.begin(), profiles.threads.end(), this));
+	}
+
+	void InvokeProfilerRecord(TypeID type, NameID method, const InvokeStats& stats) {
+		thread_local ThreadInvokeProfile profile;
+		std::lock_guard lock{ profile.mutex };
+		profile.stats[{ type, method }] += stats;
+	}
+
+	InvokeReport InvokeProfilerMerge() {
+		InvokeStatsMap merged;
+		{
+			auto& profiles = InvokeProfiles::Instance();
+			std::lock_guard lock{ profiles.mutex };
+			merged = profiles.retired;
+			for (auto* thread : profiles.threads) {
+				std::lock_guard thread_lock{ thread->mutex };
+				for (const auto& [key, value] : thread->stats)
+					merged[key] += value;
+			}
+		}
+
+		InvokeReport report;
+		report.entries.reserve(merged.size());
+		for (const auto& [key, value] : merged) {
+			report.entries.push_back({
+				Type{ Mngr.tregistry.Viewof(key.type), key.type },
+				Name{ Mngr.nregistry.Viewof(key.method), key.method },
+				value
+			});
+		}
+		std::sort(report.entries.begin(), report.entries.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.stats.time_ns > rhs.stats.time_ns;
+		});
+		return report;
+	}
+
+	void InvokeProfilerReset() {
+		auto& profiles = InvokeProfiles::Instance();
+		std::lock_guard lock{ profiles.mutex };
+		profiles.retired.clear();
+		for (auto* thread : profiles.threads) {
+			std::lock_guard thread_lock{ thread->mutex };
+			thread->stats.clear();
+		}
+	}
+}
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+
+InvokeReport ReflMngr::GetInvokeReport() const {
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+	return details::InvokeProfilerMerge();
+#else
+	return {};
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+}
+
+void ReflMngr::ResetInvokeReport() {
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+	details::InvokeProfilerReset();
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+}
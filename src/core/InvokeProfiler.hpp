@@ -0,0 +1,68 @@
+#pragma once
+
+#include "InvokeUtil.hpp"
+
+#include <UDRefl/InvokeReport.hpp>
+
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+#include <chrono>
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+
+namespace Ubpa::UDRefl::details {
+	constexpr InvokePhase GetInvokePhase(bool is_priority, MethodFlag filter) noexcept {
+		if (is_priority)
+			return filter == MethodFlag::Const ? InvokePhase::ExactConst : InvokePhase::Exact;
+		else
+			return filter == MethodFlag::Const ? InvokePhase::ConvertConst : InvokePhase::Convert;
+	}
+
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+	// add stats to the thread-local counters of (type, method)
+	void InvokeProfilerRecord(TypeID type, NameID method, const InvokeStats& stats);
+	InvokeReport InvokeProfilerMerge();
+	void InvokeProfilerReset();
+
+	// a profiled invocation (BInvoke / MInvoke / Construct)
+	// the stats are collected locally and flushed into the thread-local counters in the destructor
+	class InvokeProfileScope {
+	public:
+		InvokeProfileScope(Type type, Name method) noexcept :
+			type{ type.GetID() }, method{ method.GetID() }, begin{ std::chrono::steady_clock::now() } {}
+
+		~InvokeProfileScope() {
+			auto end = std::chrono::steady_clock::now();
+			stats.calls = 1;
+			stats.failures = hit ? 0 : 1;
+			stats.time_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+			InvokeProfilerRecord(type, method, stats);
+		}
+
+		InvokeProfileScope(const InvokeProfileScope&) = delete;
+		InvokeProfileScope& operator=(const InvokeProfileScope&) = delete;
+
+		void TryOverload() noexcept { ++stats.overloads_tried; }
+
+		void Hit(InvokePhase phase, const NewArgsGuard& guard) noexcept {
+			hit = true;
+			++stats.phase_hits[static_cast<std::size_t>(phase)];
+			stats.copied_args += guard.GetNumCopiedArgs();
+			stats.pointer_array_args += guard.GetNumPointerArrayArgs();
+			stats.derived_args += guard.GetNumDerivedArgs();
+		}
+
+	private:
+		TypeID type;
+		NameID method;
+		std::chrono::steady_clock::time_point begin;
+		InvokeStats stats;
+		bool hit{ false };
+	};
+#else
+	class InvokeProfileScope {
+	public:
+		constexpr InvokeProfileScope(Type, Name) noexcept {}
+		constexpr void TryOverload() noexcept {}
+		constexpr void Hit(InvokePhase, const NewArgsGuard&) noexcept {}
+	};
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+}
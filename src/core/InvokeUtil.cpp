@@ -390,10 +390,18 @@ details::NewArgsGuard::NewArgsGuard(
 		new_argptr_buffer[i] = arg_buffer;
 		
 		// copy
-		if (info.mode == ArgInfo::ArgMode::PointerOrArray)
+		if (info.mode == ArgInfo::ArgMode::PointerOrArray) {
 			buffer_as<void*>(arg_buffer) = orig_argptr_buffer[i];
-		else if (info.mode == ArgInfo::ArgMode::Derived)
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+			++num_pointer_array_args;
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+		}
+		else if (info.mode == ArgInfo::ArgMode::Derived) {
 			buffer_as<void*>(arg_buffer) = args[i].StaticCast_DerivedToBase(info.GetType()).GetPtr();
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+			++num_derived_args;
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+		}
 		else {
 			bool success = RefConstruct(
 				ObjectView{ info.GetType(), arg_buffer },
@@ -401,6 +409,9 @@ details::NewArgsGuard::NewArgsGuard(
 			);
 			assert(success);
 			nonptr_arg_infos[idx_nonptr_args++] = info;
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+			++num_copied_args;
+#endif // UBPA_UDREFL_ENABLE_PROFILER
 		}
 
 		++idx_copiedargs;
@@ -116,7 +116,19 @@ namespace Ubpa::UDRefl::details {
 			return new_args;
 		}
 
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+		// for the invoke profiler
+		std::uint8_t GetNumCopiedArgs() const noexcept { return num_copied_args; }
+		std::uint8_t GetNumPointerArrayArgs() const noexcept { return num_pointer_array_args; }
+		std::uint8_t GetNumDerivedArgs() const noexcept { return num_derived_args; }
+#endif // UBPA_UDREFL_ENABLE_PROFILER
+
 	private:
+#ifdef UBPA_UDREFL_ENABLE_PROFILER
+		std::uint8_t num_copied_args{ 0 };
+		std::uint8_t num_pointer_array_args{ 0 };
+		std::uint8_t num_derived_args{ 0 };
+#endif // UBPA_UDREFL_ENABLE_PROFILER
 		bool is_compatible{ false };
 		BufferGuard buffer;
 		std::span<ArgInfo> nonptr_arg_infos;
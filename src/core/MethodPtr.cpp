@@ -1,12 +1,63 @@
 #include <UDRefl/MethodPtr.hpp>
 
+#include <mutex>
+#include <unordered_set>
+
 using namespace Ubpa::UDRefl;
 
+namespace Ubpa::UDRefl::details {
+	struct ParamListHash {
+		std::size_t operator()(const ParamList& paramList) const noexcept {
+			std::size_t rst = paramList.size();
+			for (const auto& type : paramList)
+				rst ^= std::hash<Type>{}(type) + 0x9e3779b9 + (rst << 6) + (rst >> 2);
+			return rst;
+		}
+	};
+
+	struct ParamListPool {
+		std::mutex mutex;
+		std::unordered_set<ParamList, ParamListHash> paramLists; // node-based, elements never move
+		std::size_t bytes{ 0 };
+	};
+
+	static ParamListPool& GetParamListPool() {
+		static ParamListPool pool;
+		return pool;
+	}
+}
+
+UDRefl_core_API const ParamList& Ubpa::UDRefl::EmptyParamList() noexcept {
+	static const ParamList paramList;
+	return paramList;
+}
+
+UDRefl_core_API const ParamList* Ubpa::UDRefl::InternParamList(ParamList paramList) {
+	if (paramList.empty())
+		return nullptr;
+
+	auto& pool = details::GetParamListPool();
+	std::lock_guard lock{ pool.mutex };
+	auto [iter, success] = pool.paramLists.insert(std::move(paramList));
+	if (success) {
+		const_cast<ParamList&>(*iter).shrink_to_fit();
+		pool.bytes += 2 * sizeof(void*) + sizeof(ParamList) + iter->capacity() * sizeof(Type);
+	}
+	return &*iter;
+}
+
+UDRefl_core_API std::size_t Ubpa::UDRefl::GetInternedParamListBytes() noexcept {
+	auto& pool = details::GetParamListPool();
+	std::lock_guard lock{ pool.mutex };
+	return pool.bytes + pool.paramLists.bucket_count() * sizeof(void*);
+}
+
 MethodPtr::MethodPtr(Func func, MethodFlag flag, Type result_type, ParamList paramList)
-	: func{ std::move(func) }, flag{ flag }, result_type{ result_type }, paramList{ std::move(paramList) }
+	: func{ std::move(func) }, flag{ flag }, result_type{ result_type }, paramList{ InternParamList(std::move(paramList)) }
 { assert(enum_single(flag)); }
 
 bool MethodPtr::IsMatch(std::span<const Type> argTypes) const noexcept {
+	const auto& paramList = GetParamList();
 	const std::size_t n = paramList.size();
 	if (argTypes.size() != n)
 		return false;
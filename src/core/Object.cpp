@@ -1,6 +1,7 @@
 #include <UDRefl/Object.hpp>
 
 #include <UDRefl/ReflMngr.hpp>
+#include <UDRefl/ContainerView.hpp>
 
 #include <UDRefl/ranges/ObjectTree.hpp>
 #include <UDRefl/ranges/FieldRange.hpp>
@@ -132,16 +133,24 @@ VarRange ObjectView::GetVars(FieldFlag flag) const {
 	return { *this, flag };
 }
 
-ContainerType ObjectView::get_container_type() const {
-	auto* typeinfo = Mngr.GetTypeInfo(type);
-	if (!typeinfo)
-		return ContainerType::None;
+ContainerView ObjectView::AsContainer() const {
+	const TypeInfo* typeinfo = Mngr.GetTypeInfo(type);
+	if (!typeinfo || !typeinfo->container_vtable)
+		return {};
+	const ContainerVTable* vtable = typeinfo->container_vtable;
+	Type element_type = vtable->element_type;
+	if (element_type && type.RemoveReference().IsConst())
+		element_type = Mngr.tregistry.RegisterAddConst(element_type);
+	return { *this, vtable, element_type };
+}
 
-	auto target = typeinfo->attrs.find(Type_of<ContainerType>);
-	if(target == typeinfo->attrs.end())
-		return ContainerType::None;
+ObjectSpan ObjectView::GetContiguousElements() const {
+	return AsContainer().GetContiguousElements();
+}
 
-	return target->As<ContainerType>();
+ContainerType ObjectView::get_container_type() const {
+	const ContainerType* container_type = Mngr.GetTypeAttr<ContainerType>(type);
+	return container_type ? *container_type : ContainerType::None;
 }
 
 
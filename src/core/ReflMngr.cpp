@@ -1,5 +1,8 @@
 #include <UDRefl/ReflMngr.hpp>
+#include <UDRefl/ContainerView.hpp>
+#include <UDRefl/ScopedObjectArena.hpp>
 
+#include "InvokeProfiler.hpp"
 #include "InvokeUtil.hpp"
 
 #include "ReflMngrInitUtil/ReflMngrInitUtil.hpp"
@@ -9,6 +12,7 @@
 
 #include <USmallFlat/small_vector.hpp>
 
+#include <algorithm>
 #include <string>
 
 using namespace Ubpa;
@@ -56,6 +60,54 @@ namespace Ubpa::UDRefl::details {
 
 		return {};
 	}
+
+	// the caller makes sure the entry isn't in the index yet, so it's O(1)
+	template<typename Entry>
+	static void AddAttrIndexEntry(std::unordered_map<Type, std::vector<Entry>>& index, Type attr_type, const Entry& entry) {
+		index[attr_type].push_back(entry);
+	}
+
+	// O(n) in the number of entries of attr_type, keeps the order of the others
+	template<typename Entry>
+	static void EraseAttrIndexEntry(std::unordered_map<Type, std::vector<Entry>>& index, Type attr_type, const Entry& entry) {
+		auto target = index.find(attr_type);
+		if (target == index.end())
+			return;
+		auto& entries = target->second;
+		auto iter = std::find(entries.begin(), entries.end(), entry);
+		if (iter != entries.end())
+			entries.erase(iter);
+	}
+
+	// overloads share the entry { type, name } of the method attr index,
+	// it's already indexed if another overload (except) has an attr of attr_type
+	static bool IsMethodAttrIndexed(const TypeInfo& typeinfo, Name name,
+		std::unordered_multimap<Name, MethodInfo>::const_iterator except, Type attr_type)
+	{
+		auto [begin_iter, end_iter] = typeinfo.methodinfos.equal_range(name);
+		for (auto iter = begin_iter; iter != end_iter; ++iter) {
+			if (iter != except && iter->second.attrs.Get().contains(attr_type))
+				return true;
+		}
+		return false;
+	}
+
+	template<typename Entry>
+	static std::span<const Entry> GetAttrIndexEntries(const std::unordered_map<Type, std::vector<Entry>>& index, Type attr_type) {
+		auto target = index.find(attr_type);
+		if (target == index.end())
+			return {};
+		return target->second;
+	}
+
+	// objects in an arena are destructed by the arena, so the SharedObject only holds a view
+	// the control block is allocated from the arena too
+	static SharedObject MakeArenaShared(ObjectView obj, ScopedObjectArena* arena) {
+		return {
+			obj.GetType(),
+			SharedBuffer{ obj.GetPtr(), [](void*) {}, std::pmr::polymorphic_allocator<std::byte>{ arena } }
+		};
+	}
 }
 
 ReflMngr::ReflMngr() :
@@ -100,6 +152,16 @@ SharedObject ReflMngr::GetTypeAttr(Type type, Type attr_type) const {
 }
 
 SharedObject ReflMngr::GetFieldAttr(Type type, Name field_name, Type attr_type) const {
+	// fast path : the field is declared in the type, skip the ObjectTree DFS
+	if (TypeInfo* typeinfo = GetTypeInfo(type)) {
+		auto ftarget = typeinfo->fieldinfos.find(field_name);
+		if (ftarget != typeinfo->fieldinfos.end()) {
+			const auto& attrs = ftarget->second.attrs;
+			auto target = attrs.find(attr_type);
+			return target != attrs.end() ? *target : SharedObject{};
+		}
+	}
+
 	for (const auto& [typeinfo, baseobj] : ObjectTree{ type }) {
 		if (!typeinfo)
 			continue;
@@ -120,6 +182,16 @@ SharedObject ReflMngr::GetFieldAttr(Type type, Name field_name, Type attr_type)
 }
 
 SharedObject ReflMngr::GetMethodAttr(Type type, Name method_name, Type attr_type) const {
+	// fast path : the method is declared in the type, skip the ObjectTree DFS
+	if (TypeInfo* typeinfo = GetTypeInfo(type)) {
+		auto mtarget = typeinfo->methodinfos.find(method_name);
+		if (mtarget != typeinfo->methodinfos.end()) {
+			const auto& attrs = mtarget->second.attrs;
+			auto target = attrs.find(attr_type);
+			return target != attrs.end() ? *target : SharedObject{};
+		}
+	}
+
 	for (const auto& [typeinfo, baseobj] : ObjectTree{ type }) {
 		if (!typeinfo)
 			continue;
@@ -139,6 +211,54 @@ SharedObject ReflMngr::GetMethodAttr(Type type, Name method_name, Type attr_type
 	return {};
 }
 
+TypeHandle ReflMngr::GetTypeHandle(Type type) const {
+	if (!type.Valid())
+		return {};
+
+	std::shared_lock rlock{ handle_mutex }; // read typerecords
+	auto target = typerecords.find(type.GetID());
+	if (target != typerecords.end())
+		return TypeHandle{ &target->second };
+	rlock.unlock();
+
+	Type new_type = { tregistry.Register(type.GetID(), type.GetName()), type.GetID() };
+
+	std::lock_guard wlock{ handle_mutex }; // write typerecords
+	auto [new_target, success] = typerecords.try_emplace(type.GetID(), new_type, GetTypeInfo(new_type));
+	if (success && new_type != new_type.RemoveCVRef())
+		typerecord_aliases.emplace(new_type.RemoveCVRef().GetID(), &new_target->second);
+	return TypeHandle{ &new_target->second };
+}
+
+NameHandle ReflMngr::GetNameHandle(Name name) const {
+	if (!name.Valid())
+		return {};
+
+	std::shared_lock rlock{ handle_mutex }; // read namerecords
+	auto target = namerecords.find(name.GetID());
+	if (target != namerecords.end())
+		return NameHandle{ &target->second };
+	rlock.unlock();
+
+	Name new_name = { nregistry.Register(name.GetID(), name.GetView()), name.GetID() };
+
+	std::lock_guard wlock{ handle_mutex }; // write namerecords
+	auto [new_target, success] = namerecords.try_emplace(name.GetID(), NameRecord{ new_name });
+	return NameHandle{ &new_target->second };
+}
+
+std::span<const Type> ReflMngr::GetTypesWithAttr(Type attr_type) const {
+	return details::GetAttrIndexEntries(typeattr_index, attr_type);
+}
+
+std::span<const MemberAttrEntry> ReflMngr::GetFieldsWithAttr(Type attr_type) const {
+	return details::GetAttrIndexEntries(fieldattr_index, attr_type);
+}
+
+std::span<const MemberAttrEntry> ReflMngr::GetMethodsWithAttr(Type attr_type) const {
+	return details::GetAttrIndexEntries(methodattr_index, attr_type);
+}
+
 void ReflMngr::SetTemporaryResource(std::shared_ptr<std::pmr::memory_resource> rsrc) {
 	assert(rsrc.get());
 	temporary_resource = std::move(rsrc);
@@ -150,6 +270,11 @@ void ReflMngr::SetObjectResource(std::shared_ptr<std::pmr::memory_resource> rsrc
 }
 
 void ReflMngr::Clear() noexcept {
+	// attr indices
+	typeattr_index.clear();
+	fieldattr_index.clear();
+	methodattr_index.clear();
+
 	// field attrs
 	for (auto& [type, typeinfo] : typeinfos) {
 		for (auto& [field, fieldinfo] : typeinfo.fieldinfos)
@@ -157,8 +282,9 @@ void ReflMngr::Clear() noexcept {
 	}
 
 	// type attrs
-	for (auto& [ID, typeinfo] : typeinfos)
+	for (auto& [ID, typeinfo] : typeinfos) {
 		typeinfo.attrs.clear();
+	}
 
 	// type dynamic field
 	for (auto& [type, typeinfo] : typeinfos) {
@@ -172,6 +298,12 @@ void ReflMngr::Clear() noexcept {
 		}
 	}
 
+	{ // handles outlive typeinfos
+		std::lock_guard wlock{ handle_mutex }; // write typerecords
+		for (auto& [ID, record] : typerecords)
+			record.typeinfo.store(nullptr, std::memory_order_release);
+	}
+
 	typeinfos.clear();
 }
 
@@ -179,6 +311,86 @@ ReflMngr::~ReflMngr() {
 	Clear();
 }
 
+MemoryStats ReflMngr::GetMemoryStats() const {
+	// node of unordered_(multi)map : next + hash + value
+	constexpr auto hash_node_size = [](std::size_t value_size) { return 2 * sizeof(void*) + value_size; };
+	// element of flat AttrSet
+	constexpr std::size_t attr_node_size = sizeof(Attr);
+	// shared object : control block + object
+	auto shared_size = [this](Type type) -> std::size_t {
+		const auto* info = GetTypeInfo(type);
+		return 4 * sizeof(void*) + (info ? info->size : 0);
+	};
+	auto attrs_size = [&](const AttrSet& attrs) {
+		std::size_t bytes = 0;
+		for (const auto& attr : attrs)
+			bytes += attr_node_size + (attr.GetBuffer() ? shared_size(attr.GetType()) : 0);
+		return bytes;
+	};
+	// non-empty CompactAttrSet owns an AttrSet
+	auto compact_attrs_size = [&](const CompactAttrSet& attrs) {
+		return attrs.empty() ? 0 : sizeof(AttrSet) + attrs_size(attrs);
+	};
+
+	MemoryStats stats;
+	stats.name_arena = nregistry.GetArenaBytes() + tregistry.GetArenaBytes();
+	stats.param_lists = GetInternedParamListBytes();
+
+	auto index_size = [&](const auto& index) {
+		using Entry = typename std::decay_t<decltype(index)>::mapped_type::value_type;
+		std::size_t bytes = index.bucket_count() * sizeof(void*);
+		for (const auto& [attr_type, entries] : index)
+			bytes += hash_node_size(sizeof(std::pair<const Type, std::vector<Entry>>)) + entries.capacity() * sizeof(Entry);
+		return bytes;
+	};
+	stats.attr_indices = index_size(typeattr_index) + index_size(fieldattr_index) + index_size(methodattr_index);
+	stats.typeinfos = typeinfos.bucket_count() * sizeof(void*);
+	stats.types.reserve(typeinfos.size());
+
+	for (const auto& [type, typeinfo] : typeinfos) {
+		MemoryStats::TypeStats typestats;
+
+		typestats.typeinfo = hash_node_size(sizeof(std::pair<const Type, TypeInfo>))
+			+ typeinfo.baseinfos.bucket_count() * sizeof(void*)
+			+ typeinfo.baseinfos.size() * hash_node_size(sizeof(std::pair<const Type, BaseInfo>));
+
+		typestats.fields = typeinfo.fieldinfos.bucket_count() * sizeof(void*);
+		for (const auto& [name, fieldinfo] : typeinfo.fieldinfos) {
+			const std::size_t node_size = hash_node_size(sizeof(std::pair<const Name, FieldInfo>));
+			switch (fieldinfo.fieldptr.GetFieldFlag())
+			{
+			case FieldFlag::DynamicShared:
+				typestats.dynamic_fields += node_size + shared_size(fieldinfo.fieldptr.GetType());
+				break;
+			case FieldFlag::DynamicBuffer:
+				typestats.dynamic_fields += node_size;
+				break;
+			default:
+				typestats.fields += node_size;
+				break;
+			}
+			typestats.attrs += compact_attrs_size(fieldinfo.attrs);
+		}
+
+		typestats.methods = typeinfo.methodinfos.bucket_count() * sizeof(void*);
+		for (const auto& [name, methodinfo] : typeinfo.methodinfos) {
+			typestats.methods += hash_node_size(sizeof(std::pair<const Name, MethodInfo>));
+			typestats.attrs += compact_attrs_size(methodinfo.attrs);
+		}
+
+		typestats.attrs += attrs_size(typeinfo.attrs);
+
+		stats.typeinfos += typestats.typeinfo;
+		stats.fields += typestats.fields;
+		stats.methods += typestats.methods;
+		stats.attrs += typestats.attrs;
+		stats.dynamic_fields += typestats.dynamic_fields;
+		stats.types.emplace(type, typestats);
+	}
+
+	return stats;
+}
+
 bool ReflMngr::ContainsVirtualBase(Type type) const {
 	auto* info = GetTypeInfo(type);
 	if (!info)
@@ -198,7 +410,16 @@ Type ReflMngr::RegisterType(Type type, size_t size, size_t alignment, bool is_po
 	if (target != typeinfos.end())
 		return {};
 	Type new_type = { tregistry.Register(type.GetID(), type.GetName()),type.GetID() };
-	typeinfos.emplace_hint(target, new_type, TypeInfo{ size,alignment,is_polymorphic,is_trivial });
+	auto new_target = typeinfos.emplace_hint(target, new_type, TypeInfo{ size,alignment,is_polymorphic,is_trivial });
+	{ // update the interned records (include the cvref variants)
+		std::lock_guard wlock{ handle_mutex }; // write typerecords
+		auto rtarget = typerecords.find(new_type.GetID());
+		if (rtarget != typerecords.end())
+			rtarget->second.typeinfo.store(&new_target->second, std::memory_order_release);
+		auto [begin_iter, end_iter] = typerecord_aliases.equal_range(new_type.GetID());
+		for (auto iter = begin_iter; iter != end_iter; ++iter)
+			iter->second->typeinfo.store(&new_target->second, std::memory_order_release);
+	}
 	if (is_trivial)
 		AddTrivialCopyConstructor(type);
 	return new_type;
@@ -210,14 +431,31 @@ Type ReflMngr::RegisterType(
 	std::span<const Type> field_types,
 	std::span<const Name> field_names,
 	bool is_trivial)
+{
+	return RegisterType(type, bases, field_types, field_names, {}, FieldLayoutPolicy::Declared, 1, is_trivial);
+}
+
+Type ReflMngr::RegisterType(
+	Type type,
+	std::span<const Type> bases,
+	std::span<const Type> field_types,
+	std::span<const Name> field_names,
+	std::span<const AttrSet> field_attrs,
+	FieldLayoutPolicy layout_policy,
+	size_t min_alignment,
+	bool is_trivial)
 {
 	assert(field_types.size() == field_names.size());
+	assert(field_attrs.empty() || field_attrs.size() == field_names.size());
+	assert(min_alignment > 0 && (min_alignment & (min_alignment - 1)) == 0);
 
 	if (typeinfos.contains(type))
 		return {};
 
+	TraceScope trace{ TraceEvent::RegisterType, type };
+
 	std::size_t size = 0;
-	std::size_t alignment = 1;
+	std::size_t alignment = min_alignment;
 
 	const size_t num_field = field_types.size();
 
@@ -242,20 +480,64 @@ Type ReflMngr::RegisterType(
 			alignment = baseinfo.alignment;
 	}
 
-	std::pmr::vector<std::size_t> field_offsets(temporary_resource.get());
-	field_offsets.resize(num_field);
+	std::pmr::vector<const TypeInfo*> ftinfos(temporary_resource.get());
+	ftinfos.resize(num_field);
 
 	for (size_t i = 0; i < num_field; ++i) {
-		const auto& field_type = field_types[i];
-		auto fttarget = typeinfos.find(field_type);
+		auto fttarget = typeinfos.find(field_types[i]);
 		if (fttarget == typeinfos.end())
 			return {};
 		const auto& ftinfo = fttarget->second;
 		if (!ftinfo.is_trivial)
 			is_trivial = false;
 		assert(ftinfo.alignment > 0 && (ftinfo.alignment & (ftinfo.alignment - 1)) == 0);
+		ftinfos[i] = &ftinfo;
+	}
+
+	// placement order of fields
+	std::pmr::vector<std::size_t> order(temporary_resource.get());
+	order.resize(num_field);
+	for (size_t i = 0; i < num_field; ++i)
+		order[i] = i;
+
+	auto is_cold = [&](std::size_t i) {
+		if (field_attrs.empty())
+			return false;
+		auto target = field_attrs[i].find(Type_of<FieldTemperature>);
+		return target != field_attrs[i].end() && target->As<FieldTemperature>() == FieldTemperature::Cold;
+	};
+
+	auto alignment_greater = [&](std::size_t lhs, std::size_t rhs) {
+		return ftinfos[lhs]->alignment > ftinfos[rhs]->alignment;
+	};
+
+	auto first_cold = order.end();
+	switch (layout_policy)
+	{
+	case FieldLayoutPolicy::Declared:
+		break;
+	case FieldLayoutPolicy::AlignmentDescending:
+		std::stable_sort(order.begin(), order.end(), alignment_greater);
+		break;
+	case FieldLayoutPolicy::HotCold:
+		first_cold = std::stable_partition(order.begin(), order.end(), [&](std::size_t i) { return !is_cold(i); });
+		std::stable_sort(order.begin(), first_cold, alignment_greater);
+		std::stable_sort(first_cold, order.end(), alignment_greater);
+		break;
+	default:
+		assert(false);
+		break;
+	}
+
+	std::pmr::vector<std::size_t> field_offsets(temporary_resource.get());
+	field_offsets.resize(num_field);
+
+	for (auto cursor = order.begin(); cursor != order.end(); ++cursor) {
+		const auto& ftinfo = *ftinfos[*cursor];
+		if (cursor == first_cold)
+			size = (size + (min_alignment - 1)) & ~(min_alignment - 1);
 		size = (size + (ftinfo.alignment - 1)) & ~(ftinfo.alignment - 1);
-		field_offsets[i] = size;
+		field_offsets[*cursor] = size;
 		size += ftinfo.size;
 		if (ftinfo.alignment > alignment)
 			alignment = ftinfo.alignment;
@@ -283,7 +565,7 @@ Type ReflMngr::RegisterType(
 		AddField(
 			type,
 			field_names[i],
-			FieldInfo{ { field_types[i], field_offsets[i] } }
+			FieldInfo{ { field_types[i], field_offsets[i] }, field_attrs.empty() ? AttrSet{} : field_attrs[i] }
 		);
 	}
 
@@ -301,7 +583,12 @@ Name ReflMngr::AddField(Type type, Name field_name, FieldInfo fieldinfo) {
 		return {};
 
 	Name new_field_name = { nregistry.Register(field_name.GetID(), field_name.GetView()), field_name.GetID() };
-	typeinfo->fieldinfos.emplace_hint(ftarget, new_field_name, std::move(fieldinfo));
+	auto new_ftarget = typeinfo->fieldinfos.emplace_hint(ftarget, new_field_name, std::move(fieldinfo));
+	if (!new_ftarget->second.attrs.empty()) {
+		const MemberAttrEntry entry{ typeinfos.find(type)->first, new_field_name };
+		for (const auto& attr : new_ftarget->second.attrs)
+			details::AddAttrIndexEntry(fieldattr_index, attr.GetType(), entry);
+	}
 
 	return new_field_name;
 }
@@ -319,7 +606,14 @@ Name ReflMngr::AddMethod(Type type, Name method_name, MethodInfo methodinfo) {
 			return {};
 	}
 	Name new_method_name = { nregistry.Register(method_name.GetID(), method_name.GetView()), method_name.GetID() };
-	typeinfo->methodinfos.emplace(new_method_name, std::move(methodinfo));
+	auto new_mtarget = typeinfo->methodinfos.emplace(new_method_name, std::move(methodinfo));
+	if (!new_mtarget->second.attrs.empty()) {
+		const MemberAttrEntry entry{ typeinfos.find(type)->first, new_method_name };
+		for (const auto& attr : new_mtarget->second.attrs) {
+			if (!details::IsMethodAttrIndexed(*typeinfo, new_method_name, new_mtarget, attr.GetType()))
+				details::AddAttrIndexEntry(methodattr_index, attr.GetType(), entry);
+		}
+	}
 	return new_method_name;
 }
 
@@ -365,6 +659,46 @@ Name ReflMngr::AddTrivialCopyConstructor(Type type) {
 	);
 }
 
+Name ReflMngr::AddTrivialMoveConstructor(Type type) {
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
+		return {};
+	auto& typeinfo = target->second;
+	return AddMethod(
+		type,
+		NameIDRegistry::Meta::ctor,
+		MethodInfo{ {
+			[size = typeinfo.size](void* obj, void*, ArgsView args) {
+				memcpy(obj, args[0].GetPtr(), size);
+			},
+			MethodFlag::Variable,
+			{}, // result type
+			{ tregistry.RegisterAddRValueReference(type) } // paramlist
+		} }
+	);
+}
+
+Name ReflMngr::AddTrivialCopyAssignment(Type type) {
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
+		return {};
+	auto& typeinfo = target->second;
+	return AddMethod(
+		type,
+		NameIDRegistry::Meta::operator_assignment,
+		MethodInfo{ {
+			[size = typeinfo.size](void* obj, void* result_buffer, ArgsView args) {
+				memcpy(obj, args[0].GetPtr(), size);
+				if (result_buffer)
+					buffer_as<void*>(result_buffer) = obj;
+			},
+			MethodFlag::Variable,
+			tregistry.RegisterAddLValueReference(type), // result type
+			{ tregistry.RegisterAddConstLValueReference(type) } // paramlist
+		} }
+	);
+}
+
 Name ReflMngr::AddZeroDefaultConstructor(Type type) {
 	auto target = typeinfos.find(type);
 	if (target == typeinfos.end() || target->second.is_polymorphic || ContainsVirtualBase(type))
@@ -386,6 +720,58 @@ Name ReflMngr::AddZeroDefaultConstructor(Type type) {
 	);
 }
 
+bool ReflMngr::AddContainerVTable(Type type, const ContainerVTable* vtable) {
+	assert(vtable);
+	auto* typeinfo = GetTypeInfo(type);
+	if (!typeinfo)
+		return false;
+
+	typeinfo->container_vtable = vtable;
+	return true;
+}
+
+bool ReflMngr::AddContainerVTableMethods(Type type) {
+	auto* typeinfo = GetTypeInfo(type);
+	if (!typeinfo || !typeinfo->container_vtable)
+		return false;
+
+	const ContainerVTable* vtable = typeinfo->container_vtable;
+
+	if (vtable->empty) {
+		AddMethod(
+			type,
+			NameIDRegistry::Meta::container_empty,
+			MethodInfo{ {
+				[vtable](void* obj, void* result_buffer, ArgsView) {
+					bool rst = vtable->empty(obj);
+					if (result_buffer)
+						buffer_as<bool>(result_buffer) = rst;
+				},
+				MethodFlag::Const,
+				Type_of<bool>
+			} }
+		);
+	}
+
+	if (vtable->size) {
+		AddMethod(
+			type,
+			NameIDRegistry::Meta::container_size,
+			MethodInfo{ {
+				[vtable](void* obj, void* result_buffer, ArgsView) {
+					std::size_t rst = vtable->size(obj);
+					if (result_buffer)
+						buffer_as<std::size_t>(result_buffer) = rst;
+				},
+				MethodFlag::Const,
+				Type_of<std::size_t>
+			} }
+		);
+	}
+
+	return true;
+}
+
 Name ReflMngr::AddDefaultConstructor(Type type) {
 	if (IsConstructible(type))
 		return {};
@@ -494,44 +880,87 @@ Type ReflMngr::AddBase(Type derived, Type base, BaseInfo baseinfo) {
 }
 
 bool ReflMngr::AddTypeAttr(Type type, Attr attr) {
-	auto* typeinfo = GetTypeInfo(type);
-	if (!typeinfo)
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
 		return false;
-	auto& attrs = typeinfo->attrs;
-	auto atarget = attrs.find(attr);
-	if (atarget != attrs.end())
+	auto& typeinfo = target->second;
+	auto [atarget, success] = typeinfo.attrs.insert(std::move(attr));
+	if (!success)
 		return false;
-	attrs.emplace_hint(atarget, std::move(attr));
+	details::AddAttrIndexEntry(typeattr_index, atarget->GetType(), target->first);
 	return true;
 }
 
 bool ReflMngr::AddFieldAttr(Type type, Name name, Attr attr) {
-	auto* typeinfo = GetTypeInfo(type);
-	if (!typeinfo)
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
 		return false;
-	auto ftarget = typeinfo->fieldinfos.find(name);
-	if (ftarget == typeinfo->fieldinfos.end())
+	auto& typeinfo = target->second;
+	auto ftarget = typeinfo.fieldinfos.find(name);
+	if (ftarget == typeinfo.fieldinfos.end())
 		return false;
-	auto& attrs = ftarget->second.attrs;
-	auto atarget = attrs.find(attr);
-	if (atarget != attrs.end())
+	auto [atarget, success] = ftarget->second.attrs.GetMutable().insert(std::move(attr));
+	if (!success)
 		return false;
-	attrs.emplace_hint(atarget, std::move(attr));
+	details::AddAttrIndexEntry(fieldattr_index, atarget->GetType(), MemberAttrEntry{ target->first, ftarget->first });
 	return true;
 }
 
 bool ReflMngr::AddMethodAttr(Type type, Name name, Attr attr) {
-	auto* typeinfo = GetTypeInfo(type);
-	if (!typeinfo)
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
+		return false;
+	auto& typeinfo = target->second;
+	auto mtarget = typeinfo.methodinfos.find(name);
+	if (mtarget == typeinfo.methodinfos.end())
+		return false;
+	auto [atarget, success] = mtarget->second.attrs.GetMutable().insert(std::move(attr));
+	if (!success)
 		return false;
-	auto mtarget = typeinfo->methodinfos.find(name);
-	if (mtarget == typeinfo->methodinfos.end())
+	if (!details::IsMethodAttrIndexed(typeinfo, mtarget->first, mtarget, atarget->GetType()))
+		details::AddAttrIndexEntry(methodattr_index, atarget->GetType(), MemberAttrEntry{ target->first, mtarget->first });
+	return true;
+}
+
+bool ReflMngr::RemoveTypeAttr(Type type, Type attr_type) {
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
 		return false;
-	auto& attrs = mtarget->second.attrs;
-	auto atarget = attrs.find(attr);
-	if (atarget != attrs.end())
+	if (target->second.attrs.erase(attr_type) == 0)
 		return false;
-	attrs.emplace_hint(atarget, std::move(attr));
+	details::EraseAttrIndexEntry(typeattr_index, attr_type, target->first);
+	return true;
+}
+
+bool ReflMngr::RemoveFieldAttr(Type type, Name name, Type attr_type) {
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
+		return false;
+	auto& typeinfo = target->second;
+	auto ftarget = typeinfo.fieldinfos.find(name);
+	if (ftarget == typeinfo.fieldinfos.end() || !ftarget->second.attrs.Get().contains(attr_type))
+		return false;
+	ftarget->second.attrs.GetMutable().erase(attr_type);
+	details::EraseAttrIndexEntry(fieldattr_index, attr_type, MemberAttrEntry{ target->first, ftarget->first });
+	return true;
+}
+
+bool ReflMngr::RemoveMethodAttr(Type type, Name name, Type attr_type) {
+	auto target = typeinfos.find(type);
+	if (target == typeinfos.end())
+		return false;
+	auto& typeinfo = target->second;
+	auto [begin_iter, end_iter] = typeinfo.methodinfos.equal_range(name);
+	bool removed = false;
+	for (auto iter = begin_iter; iter != end_iter; ++iter) {
+		if (iter->second.attrs.Get().contains(attr_type)) {
+			iter->second.attrs.GetMutable().erase(attr_type);
+			removed = true;
+		}
+	}
+	if (!removed)
+		return false;
+	details::EraseAttrIndexEntry(methodattr_index, attr_type, MemberAttrEntry{ target->first, begin_iter->first });
 	return true;
 }
 
@@ -544,6 +973,9 @@ SharedObject ReflMngr::MMakeShared(Type type, std::pmr::memory_resource* rsrc, A
 	if (!obj.GetType().Valid())
 		return {};
 
+	if (auto* arena = ScopedObjectArena::FromResource(rsrc))
+		return details::MakeArenaShared(obj, arena);
+
 	return { obj, [rsrc, type](void* ptr) {
 		Mngr.MDelete({type, ptr}, rsrc);
 	} };
@@ -842,6 +1274,9 @@ Type ReflMngr::BInvoke(
 	if (!obj.GetPtr())
 		flag = enum_within(flag, MethodFlag::Static);
 
+	details::InvokeProfileScope profile{ obj.GetType(), method_name };
+	TraceScope trace{ TraceEvent::Invoke, obj.GetType(), method_name };
+
 	auto binvoke = [&](bool is_priority, MethodFlag filter) -> Type {
 		if (!enum_contain_any(flag, filter))
 			return {};
@@ -858,12 +1293,14 @@ Type ReflMngr::BInvoke(
 				if (!enum_contain_any(newflag, iter->second.methodptr.GetMethodFlag()))
 					continue;
 
+				profile.TryOverload();
 				details::NewArgsGuard guard{
 					is_priority, temp_args_rsrc,
 					iter->second.methodptr.GetParamList(), args
 				};
 				if (!guard.IsCompatible())
 					continue;
+				profile.Hit(details::GetInvokePhase(is_priority, filter), guard);
 				iter->second.methodptr.Invoke(baseobj.GetPtr(), result_buffer, guard.GetArgsView());
 				return iter->second.methodptr.GetResultType();
 			}
@@ -918,6 +1355,9 @@ SharedObject ReflMngr::MInvoke(
 	if (!obj.GetPtr())
 		flag = enum_within(flag, MethodFlag::Static);
 
+	details::InvokeProfileScope profile{ obj.GetType(), method_name };
+	TraceScope trace{ TraceEvent::Invoke, obj.GetType(), method_name };
+
 	auto minvoke = [&](bool is_priority, MethodFlag filter) -> SharedObject {
 		if (!enum_contain_any(flag, filter))
 			return {};
@@ -934,6 +1374,7 @@ SharedObject ReflMngr::MInvoke(
 				if (!enum_contain_any(newflag, iter->second.methodptr.GetMethodFlag()))
 					continue;
 
+				profile.TryOverload();
 				details::NewArgsGuard guard{
 					is_priority, temp_args_rsrc,
 					iter->second.methodptr.GetParamList(), args
@@ -941,6 +1382,7 @@ SharedObject ReflMngr::MInvoke(
 
 				if (!guard.IsCompatible())
 					continue;
+				profile.Hit(details::GetInvokePhase(is_priority, filter), guard);
 
 				const auto& methodptr = iter->second.methodptr;
 				const auto& rst_type = methodptr.GetResultType();
@@ -972,6 +1414,10 @@ SharedObject ReflMngr::MInvoke(
 						return {};
 					void* result_buffer = rst_rsrc->allocate(result_typeinfo->size, result_typeinfo->alignment);
 					iter->second.methodptr.Invoke(baseobj.GetPtr(), result_buffer, guard.GetArgsView());
+					if (auto* arena = ScopedObjectArena::FromResource(rst_rsrc)) {
+						arena->Track({ rst_type, result_buffer });
+						return details::MakeArenaShared({ rst_type, result_buffer }, arena);
+					}
 					return {
 						{rst_type, result_buffer},
 						[rst_type, rst_rsrc](void* ptr) { Mngr.MDelete({ rst_type, ptr }, rst_rsrc); }
@@ -1000,6 +1446,8 @@ ObjectView ReflMngr::MNew(Type type, std::pmr::memory_resource* rsrc, ArgsView a
 	if (!IsConstructible(type, args.Types()))
 		return {};
 
+	TraceScope trace{ TraceEvent::MNew, type };
+
 	const auto& typeinfo = typeinfos.at(type);
 
 	void* buffer = rsrc->allocate(std::max<std::size_t>(1, typeinfo.size), typeinfo.alignment);
@@ -1011,12 +1459,20 @@ ObjectView ReflMngr::MNew(Type type, std::pmr::memory_resource* rsrc, ArgsView a
 	bool success = Construct(obj, args);
 	assert(success);
 
+	if (auto* arena = ScopedObjectArena::FromResource(rsrc))
+		arena->Track(obj);
+
 	return obj;
 }
 
 bool ReflMngr::MDelete(ObjectView obj, std::pmr::memory_resource* rsrc) const {
 	assert(rsrc);
 
+	if (ScopedObjectArena::FromResource(rsrc))
+		return true; // the arena destructs it
+
+	TraceScope trace{ TraceEvent::MDelete, obj.GetType() };
+
 	Destruct(obj);
 
 	const auto& typeinfo = typeinfos.at(obj.GetType());
@@ -1034,6 +1490,14 @@ bool ReflMngr::Delete(ObjectView obj) const {
 	return MDelete(obj, object_resource.get());
 }
 
+bool ReflMngr::AppendRange(ObjectView container, ObjectSpan src, bool move) const {
+	return container.AsContainer().AppendRange(src, move);
+}
+
+bool ReflMngr::AssignRange(ObjectView container, ObjectSpan src, bool move) const {
+	return container.AsContainer().AssignRange(src, move);
+}
+
 SharedObject ReflMngr::MakeShared(Type type, ArgsView args) const {
 	return MMakeShared(type, object_resource.get(), args);
 }
@@ -1095,15 +1559,19 @@ bool ReflMngr::Construct(ObjectView obj, ArgsView args) const {
 	const auto& typeinfo = target->second;
 	if (args.Types().empty() && typeinfo.is_trivial)
 		return true; // trivial ctor
+	details::InvokeProfileScope profile{ obj.GetType(), NameIDRegistry::Meta::ctor };
+	TraceScope trace{ TraceEvent::Construct, obj.GetType(), NameIDRegistry::Meta::ctor };
 	auto [begin_iter, end_iter] = typeinfo.methodinfos.equal_range(NameIDRegistry::Meta::ctor);
 	for (auto iter = begin_iter; iter != end_iter; ++iter) {
 		if (iter->second.methodptr.GetMethodFlag() == MethodFlag::Variable) {
+			profile.TryOverload();
 			details::NewArgsGuard guard{
 				false, temporary_resource.get(),
 				iter->second.methodptr.GetParamList(), args
 			};
 			if (!guard.IsCompatible())
 				continue;
+			profile.Hit(InvokePhase::Convert, guard);
 			iter->second.methodptr.Invoke(obj.GetPtr(), nullptr, guard.GetArgsView());
 			return true;
 		}
@@ -1119,6 +1587,8 @@ bool ReflMngr::Destruct(ObjectView obj) const {
 	if (typeinfo.is_trivial)
 		return true;// trivial ctor
 	auto [begin_iter, end_iter] = typeinfo.methodinfos.equal_range(NameIDRegistry::Meta::dtor);
+	if (begin_iter == end_iter)
+		return true; // trivial dtor
 	for (auto iter = begin_iter; iter != end_iter; ++iter) {
 		if (iter->second.methodptr.GetMethodFlag() == MethodFlag::Variable
 			&& IsCompatible(iter->second.methodptr.GetParamList(), {}))
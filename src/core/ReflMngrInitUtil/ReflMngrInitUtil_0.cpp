@@ -26,4 +26,8 @@ void Ubpa::UDRefl::details::ReflMngrInitUtil_0(ReflMngr& mngr) {
 	mngr.AddField<ContainerType::UnorderedSet>("UnorderedSet");
 	mngr.AddField<ContainerType::Variant>("Variant");
 	mngr.AddField<ContainerType::Vector>("Vector");
+
+	mngr.RegisterType<FieldTemperature>();
+	mngr.AddField<FieldTemperature::Hot>("Hot");
+	mngr.AddField<FieldTemperature::Cold>("Cold");
 }
@@ -0,0 +1,100 @@
+#include <UDRefl/ScopedObjectArena.hpp>
+
+#include <UDRefl/ReflMngr.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace Ubpa::UDRefl::details {
+	// live arenas, FromResource neither trusts the resources' is_equal nor uses RTTI
+	struct ArenaRegistry {
+		std::atomic<std::size_t> num{ 0 }; // skip the lookup if there is no arena
+		std::shared_mutex mutex;
+		std::unordered_set<const std::pmr::memory_resource*> arenas;
+
+		static ArenaRegistry& Instance() {
+			static ArenaRegistry instance;
+			return instance;
+		}
+
+		void Insert(const std::pmr::memory_resource* arena) {
+			std::lock_guard lock{ mutex };
+			arenas.insert(arena);
+			num.store(arenas.size(), std::memory_order_release);
+		}
+
+		void Erase(const std::pmr::memory_resource* arena) {
+			std::lock_guard lock{ mutex };
+			arenas.erase(arena);
+			num.store(arenas.size(), std::memory_order_release);
+		}
+
+		bool Contains(const std::pmr::memory_resource* rsrc) {
+			if (num.load(std::memory_order_acquire) == 0)
+				return false;
+			std::shared_lock lock{ mutex };
+			return arenas.contains(rsrc);
+		}
+	};
+}
+
+ScopedObjectArena::ScopedObjectArena(std::pmr::memory_resource* upstream) :
+	buffer{ upstream },
+	entries{ upstream }
+{
+	details::ArenaRegistry::Instance().Insert(this);
+}
+
+ScopedObjectArena::ScopedObjectArena(std::size_t initial_size, std::pmr::memory_resource* upstream) :
+	buffer{ initial_size, upstream },
+	entries{ upstream }
+{
+	details::ArenaRegistry::Instance().Insert(this);
+}
+
+ScopedObjectArena::~ScopedObjectArena() {
+	Release();
+	details::ArenaRegistry::Instance().Erase(this);
+}
+
+bool ScopedObjectArena::Track(ObjectView obj) {
+	assert(obj.GetPtr());
+	const auto* typeinfo = Mngr.GetTypeInfo(obj.GetType());
+	if (!typeinfo || typeinfo->is_trivial)
+		return false;
+
+	auto [begin_iter, end_iter] = typeinfo->methodinfos.equal_range(NameIDRegistry::Meta::dtor);
+	for (auto iter = begin_iter; iter != end_iter; ++iter) {
+		if (iter->second.methodptr.GetMethodFlag() == MethodFlag::Variable
+			&& iter->second.methodptr.GetParamList().empty())
+		{
+			entries.push_back({ &iter->second.methodptr, obj.GetPtr() });
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ScopedObjectArena::Release() {
+	for (auto iter = entries.rbegin(); iter != entries.rend(); ++iter)
+		iter->dtor->Invoke(iter->ptr, nullptr, {});
+	entries.clear();
+	entries.shrink_to_fit();
+	buffer.release();
+}
+
+void* ScopedObjectArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+	return buffer.allocate(bytes, alignment);
+}
+
+ScopedObjectArena* ScopedObjectArena::FromResource(std::pmr::memory_resource* rsrc) noexcept {
+	if (!rsrc || !details::ArenaRegistry::Instance().Contains(rsrc))
+		return nullptr;
+	return static_cast<ScopedObjectArena*>(rsrc);
+}
@@ -0,0 +1,239 @@
+#include <UDRefl/Trace.hpp>
+
+#include <UDRefl/ReflMngr.hpp>
+
+#include <ostream>
+
+#ifdef UBPA_UDREFL_ENABLE_TRACE
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif // UBPA_UDREFL_ENABLE_TRACE
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+#ifdef UBPA_UDREFL_ENABLE_TRACE
+namespace Ubpa::UDRefl::details {
+	struct TraceEventRecord {
+		std::uint64_t begin;
+		std::uint64_t end;
+		TypeID type;
+		NameID name;
+		TraceEvent event;
+	};
+
+	// a seqlock slot, WriteTrace may read it while the owner thread overwrites it
+	// - seq is 2 * index + 1 while writing the index-th event, 2 * index + 2 when it is done
+	// - the fields are relaxed atomics, the reader rechecks seq after loading them
+	struct TraceSlot {
+		std::atomic<std::uint64_t> seq{ 0 };
+		std::atomic<std::uint64_t> begin{ 0 };
+		std::atomic<std::uint64_t> end{ 0 };
+		std::atomic<std::uint64_t> type{ 0 };
+		std::atomic<std::uint64_t> name{ 0 };
+		std::atomic<TraceEvent> event{ TraceEvent::Invoke };
+
+		void Store(std::uint64_t index, const TraceEventRecord& record) noexcept {
+			seq.store(2 * index + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			begin.store(record.begin, std::memory_order_relaxed);
+			end.store(record.end, std::memory_order_relaxed);
+			type.store(record.type.GetValue(), std::memory_order_relaxed);
+			name.store(record.name.GetValue(), std::memory_order_relaxed);
+			event.store(record.event, std::memory_order_relaxed);
+			seq.store(2 * index + 2, std::memory_order_release);
+		}
+
+		// false if the index-th event is being written or has been overwritten
+		bool Load(std::uint64_t index, TraceEventRecord& record) const noexcept {
+			if (seq.load(std::memory_order_acquire) != 2 * index + 2)
+				return false;
+			record.begin = begin.load(std::memory_order_relaxed);
+			record.end = end.load(std::memory_order_relaxed);
+			record.type = TypeID{ type.load(std::memory_order_relaxed) };
+			record.name = NameID{ name.load(std::memory_order_relaxed) };
+			record.event = event.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return seq.load(std::memory_order_relaxed) == 2 * index + 2;
+		}
+	};
+
+	// single producer (the owner thread), read by WriteTrace
+	struct TraceRingBuffer {
+		TraceRingBuffer(std::uint64_t session, std::uint64_t origin, std::uint32_t tid, std::size_t capacity) :
+			session{ session }, origin{ origin }, tid{ tid }, slots(capacity) {}
+
+		const std::uint64_t session;
+		const std::uint64_t origin; // StartTrace time of the session
+		const std::uint32_t tid;
+		std::vector<TraceSlot> slots;
+		std::atomic<std::uint64_t> head{ 0 }; // number of recorded events
+	};
+
+	struct Tracer {
+		std::atomic<bool> recording{ false };
+		std::atomic<std::uint64_t> session{ 0 };
+
+		std::mutex mutex; // buffers, capacity, origin, next_tid
+		std::vector<std::shared_ptr<TraceRingBuffer>> buffers;
+		std::size_t capacity{ 0 };
+		std::uint64_t origin{ 0 };
+		std::uint32_t next_tid{ 0 };
+
+		static Tracer& Instance() {
+			static Tracer instance;
+			return instance;
+		}
+	};
+
+	static void WriteJSONString(std::ostream& os, std::string_view str) {
+		os << '"';
+		for (char c : str) {
+			switch (c)
+			{
+			case '"': os << "\\\""; break;
+			case '\\': os << "\\\\"; break;
+			case '\n': os << "\\n"; break;
+			default: os << c; break;
+			}
+		}
+		os << '"';
+	}
+
+	// the trace-event format uses microseconds, keep the nanoseconds as decimals
+	static void WriteMicroseconds(std::ostream& os, std::uint64_t ns) {
+		const auto fraction = ns % 1000;
+		os << ns / 1000 << '.' << fraction / 100 << fraction / 10 % 10 << fraction % 10;
+	}
+
+	static std::string_view TraceEventName(TraceEvent event) noexcept {
+		switch (event)
+		{
+		case TraceEvent::Invoke: return "Invoke";
+		case TraceEvent::Construct: return "Construct";
+		case TraceEvent::MNew: return "MNew";
+		case TraceEvent::MDelete: return "MDelete";
+		case TraceEvent::RegisterType: return "RegisterType";
+		default: return "Unknown";
+		}
+	}
+
+	bool TraceIsRecording() noexcept {
+		return Tracer::Instance().recording.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t TraceNow() noexcept {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	void TraceRecord(TraceEvent event, TypeID type, NameID name, std::uint64_t begin, std::uint64_t end) noexcept {
+		auto& tracer = Tracer::Instance();
+		thread_local std::shared_ptr<TraceRingBuffer> buffer;
+
+		// the scope may be opened before StopTrace
+		if (!tracer.recording.load(std::memory_order_acquire))
+			return;
+
+		const std::uint64_t session = tracer.session.load(std::memory_order_acquire);
+		if (!buffer || buffer->session != session) {
+			std::lock_guard lock{ tracer.mutex };
+			if (tracer.capacity == 0)
+				return;
+			// StartTrace may happen after the load
+			buffer = std::make_shared<TraceRingBuffer>(tracer.session.load(std::memory_order_relaxed),
+				tracer.origin, tracer.next_tid++, tracer.capacity);
+			tracer.buffers.push_back(buffer);
+		}
+
+		// the scope may be opened before StartTrace of the session
+		if (begin < buffer->origin)
+			return;
+
+		const std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+		buffer->slots[head % buffer->slots.size()].Store(head, { begin, end, type, name, event });
+		buffer->head.store(head + 1, std::memory_order_release);
+	}
+}
+
+void ReflMngr::StartTrace(std::size_t capacity_per_thread) {
+	assert(capacity_per_thread > 0);
+	auto& tracer = details::Tracer::Instance();
+	std::lock_guard lock{ tracer.mutex };
+	tracer.buffers.clear();
+	tracer.capacity = capacity_per_thread;
+	tracer.origin = details::TraceNow();
+	tracer.next_tid = 0;
+	tracer.session.fetch_add(1, std::memory_order_acq_rel);
+	tracer.recording.store(true, std::memory_order_release);
+}
+
+void ReflMngr::StopTrace() {
+	details::Tracer::Instance().recording.store(false, std::memory_order_release);
+}
+
+void ReflMngr::WriteTrace(std::ostream& os) const {
+	auto& tracer = details::Tracer::Instance();
+	std::lock_guard lock{ tracer.mutex };
+
+	os << "{\"traceEvents\":[";
+	bool first = true;
+	auto next = [&]() -> std::ostream& {
+		if (!first)
+			os << ",";
+		first = false;
+		return os << "\n";
+	};
+
+	for (const auto& buffer : tracer.buffers) {
+		next() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+			<< ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+
+		const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+		const std::uint64_t capacity = buffer->slots.size();
+		const std::uint64_t num = std::min(head, capacity);
+		for (std::uint64_t i = head - num; i < head; i++) {
+			// scopes still open at StopTrace may be overwriting the slot, skip it
+			details::TraceEventRecord e;
+			if (!buffer->slots[i % capacity].Load(i, e))
+				continue;
+			const auto type = tregistry.Viewof(e.type);
+
+			next() << "{\"name\":";
+			if (e.event == TraceEvent::Invoke || e.event == TraceEvent::Construct) {
+				std::string name{ type };
+				name.append("::");
+				name.append(nregistry.Viewof(e.name));
+				details::WriteJSONString(os, name);
+			}
+			else
+				details::WriteJSONString(os, type);
+			os << ",\"cat\":\"" << details::TraceEventName(e.event) << "\""
+				<< ",\"ph\":\"X\",\"ts\":";
+			details::WriteMicroseconds(os, e.begin - buffer->origin);
+			os << ",\"dur\":";
+			details::WriteMicroseconds(os, e.end - e.begin);
+			os << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+		}
+	}
+
+	os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+#else
+namespace Ubpa::UDRefl::details {
+	bool TraceIsRecording() noexcept { return false; }
+	std::uint64_t TraceNow() noexcept { return 0; }
+	void TraceRecord(TraceEvent, TypeID, NameID, std::uint64_t, std::uint64_t) noexcept {}
+}
+
+void ReflMngr::StartTrace(std::size_t) {}
+void ReflMngr::StopTrace() {}
+
+void ReflMngr::WriteTrace(std::ostream& os) const {
+	os << "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}\n";
+}
+#endif // UBPA_UDREFL_ENABLE_TRACE
@@ -9,7 +9,7 @@ void Ubpa::UDRefl::ext::details::Bootstrap_helper_reflmngr_0() {
 	Mngr.AddField<&ReflMngr::tregistry>("tregistry");
 	Mngr.AddStaticMethod(Type_of<ReflMngr>, "Instance", &ReflMngr::Instance);
 	Mngr.AddMethod<&ReflMngr::GetTypeInfo>("GetTypeInfo");
-	Mngr.AddMethod<&ReflMngr::GetTypeAttr>("GetTypeAttr");
+	Mngr.AddMethod<MemFuncOf<ReflMngr, SharedObject(Type, Type)const>::get(&ReflMngr::GetTypeAttr)>("GetTypeAttr");
 	Mngr.AddMethod<&ReflMngr::GetFieldAttr>("GetFieldAttr");
 	Mngr.AddMethod<&ReflMngr::GetMethodAttr>("GetMethodAttr");
 	Mngr.AddMethod<&ReflMngr::Clear>("Clear");
@@ -25,6 +25,9 @@ void Ubpa::UDRefl::ext::details::Bootstrap_helper_reflmngr_0() {
 	Mngr.AddMethod<&ReflMngr::AddTypeAttr>("AddTypeAttr");
 	Mngr.AddMethod<&ReflMngr::AddFieldAttr>("AddFieldAttr");
 	Mngr.AddMethod<&ReflMngr::AddMethodAttr>("AddMethodAttr");
+	Mngr.AddMethod<&ReflMngr::RemoveTypeAttr>("RemoveTypeAttr");
+	Mngr.AddMethod<&ReflMngr::RemoveFieldAttr>("RemoveFieldAttr");
+	Mngr.AddMethod<&ReflMngr::RemoveMethodAttr>("RemoveMethodAttr");
 	Mngr.AddMethod<&ReflMngr::AddTrivialDefaultConstructor>("AddTrivialDefaultConstructor");
 	Mngr.AddMethod<&ReflMngr::AddTrivialCopyConstructor>("AddTrivialCopyConstructor");
 	Mngr.AddMethod<&ReflMngr::AddZeroDefaultConstructor>("AddZeroDefaultConstructor");
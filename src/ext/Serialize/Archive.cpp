@@ -0,0 +1,712 @@
+#include <UDRefl_ext/Archive.hpp>
+
+#include "SerializePlan.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_set>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	struct ArchivePlan;
+
+	enum class ArchiveKind : std::uint8_t {
+		Bytes,   // memcpy
+		Object,  // members
+		Span,    // ArchiveSpan<E>
+		Pointer  // ArchivePtr<E>
+	};
+
+	struct ArchiveMember {
+		NameID name; // invalid for bases
+		std::size_t offset;
+		std::size_t archived_offset;
+		const ArchivePlan* plan;
+	};
+
+	struct ArchivePlan {
+		SerializePlanState state{ SerializePlanState::Compiling };
+		ArchiveKind kind{ ArchiveKind::Bytes };
+		Type archived;       // set before compiling members (recursive types)
+		Type const_archived; // type of views
+		std::size_t size{ 0 };      // of the archived type
+		std::size_t alignment{ 1 }; // of the archived type
+		std::uint64_t fingerprint{ 0 }; // layout of the archived type (not recursive)
+
+		// Object : members in the order of offsets
+		// Bytes : members for fingerprints only
+		std::vector<ArchiveMember> members;
+
+		// Span
+		const ContainerVTable* vtable{ nullptr };
+
+		// Span : elements, Pointer : pointee
+		const ArchivePlan* element_plan{ nullptr };
+
+		bool Valid() const noexcept { return state == SerializePlanState::Valid; }
+	};
+
+	static constexpr std::size_t RoundUp(std::size_t n, std::size_t alignment) noexcept {
+		return (n + (alignment - 1)) & ~(alignment - 1);
+	}
+
+	static constexpr std::uint64_t HashCombine(std::uint64_t seed, std::uint64_t value) noexcept {
+		// splitmix64
+		std::uint64_t x = seed + 0x9e3779b97f4a7c15 + value;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+		return x ^ (x >> 31);
+	}
+
+	// archived span / pointer types -> plans (any of the containers / pointers with the same archived type)
+	struct ArchiveRefs {
+		std::shared_mutex mutex;
+		std::unordered_map<TypeID, const ArchivePlan*> plans;
+	};
+
+	static ArchiveRefs& GetArchiveRefs() {
+		static ArchiveRefs refs;
+		return refs;
+	}
+
+	static const ArchivePlan* FindArchiveRef(Type archived) {
+		auto& refs = GetArchiveRefs();
+		std::shared_lock lock{ refs.mutex };
+		auto target = refs.plans.find(archived.RemoveCVRef().GetID());
+		return target != refs.plans.end() ? target->second : nullptr;
+	}
+
+	// pointers inside trivial types make them archived as objects
+	static bool ContainsPointer(Type type) {
+		if (type.IsPointer())
+			return true;
+		const TypeInfo* info = Mngr.GetTypeInfo(type.RemoveConst());
+		if (!info)
+			return false;
+		std::vector<LayoutMember> members;
+		if (!GetLayoutMembers(*info, members))
+			return true; // unsupported anyway
+		return std::any_of(members.begin(), members.end(),
+			[](const LayoutMember& member) { return ContainsPointer(member.type); });
+	}
+
+	// false if the type isn't supported, members are got for Bytes and Object
+	static bool GetArchiveKind(Type type, const TypeInfo& info, std::vector<LayoutMember>& members, ArchiveKind& kind) {
+		if (type.IsPointer())
+			kind = ArchiveKind::Pointer;
+		else if (!GetLayoutMembers(info, members))
+			return false;
+		else if (info.is_trivial && !ContainsPointer(type))
+			kind = ArchiveKind::Bytes;
+		else if (!members.empty())
+			kind = ArchiveKind::Object;
+		else if (const ContainerVTable* vtable = info.container_vtable;
+			vtable && vtable->element_type && vtable->size && (vtable->data || vtable->for_each))
+		{
+			kind = ArchiveKind::Span;
+		}
+		else
+			return false;
+		return std::none_of(members.begin(), members.end(),
+			[](const LayoutMember& member) { return member.type.IsReference(); });
+	}
+
+	static bool GetArchivedName(Type type, std::string& name) {
+		const TypeInfo* info = Mngr.GetTypeInfo(type);
+		std::vector<LayoutMember> members;
+		ArchiveKind kind;
+		if (!info || !GetArchiveKind(type, *info, members, kind))
+			return false;
+		switch (kind)
+		{
+		case ArchiveKind::Bytes:
+			name += type.GetName();
+			return true;
+		case ArchiveKind::Object:
+			name += "Ubpa::UDRefl::ext::Archived<";
+			name += type.GetName();
+			break;
+		case ArchiveKind::Span:
+			name += "Ubpa::UDRefl::ext::ArchiveSpan<";
+			if (!GetArchivedName(info->container_vtable->element_type.RemoveConst(), name))
+				return false;
+			break;
+		case ArchiveKind::Pointer:
+			name += "Ubpa::UDRefl::ext::ArchivePtr<";
+			if (!GetArchivedName(type.RemovePointer().RemoveConst(), name))
+				return false;
+			break;
+		}
+		name += '>';
+		return true;
+	}
+
+	// register the archived type of type, recursive through the members only (never cyclic),
+	// ArchiveSpan<E> / ArchivePtr<E> just need the name of E
+	static Type RegisterArchivedType(Type type) {
+		const TypeInfo* info = Mngr.GetTypeInfo(type);
+		std::vector<LayoutMember> members;
+		ArchiveKind kind;
+		if (!info || !GetArchiveKind(type, *info, members, kind))
+			return {};
+		if (kind == ArchiveKind::Bytes)
+			return type;
+
+		std::string name;
+		if (!GetArchivedName(type, name))
+			return {};
+		const Type archived = Mngr.tregistry.Register(name);
+		if (Mngr.GetTypeInfo(archived))
+			return archived;
+
+		std::vector<Type> bases;
+		std::vector<Type> field_types;
+		std::vector<Name> field_names;
+		switch (kind)
+		{
+		case ArchiveKind::Span:
+			bases.push_back(Type_of<ArchiveSpan>);
+			break;
+		case ArchiveKind::Pointer:
+			bases.push_back(Type_of<ArchivePtr>);
+			break;
+		default:
+			for (const auto& member : members) {
+				const Type member_archived = RegisterArchivedType(member.type.RemoveConst());
+				if (!member_archived)
+					return {};
+				if (member.name) {
+					field_types.push_back(member_archived);
+					field_names.push_back(member.name);
+				}
+				else
+					bases.push_back(member_archived);
+			}
+			break;
+		}
+		return Mngr.RegisterType(archived, bases, field_types, field_names, true);
+	}
+
+	static bool CompileArchivePlan(PlanCache<ArchivePlan>& cache, Type type, const TypeInfo& info, ArchivePlan& plan) {
+		static const bool registered = [] {
+			Mngr.RegisterType<ArchivePtr>();
+			Mngr.AddField<&ArchivePtr::offset>("offset");
+			Mngr.RegisterType<ArchiveSpan>();
+			Mngr.AddField<&ArchiveSpan::offset>("offset");
+			Mngr.AddField<&ArchiveSpan::size>("size");
+			return true;
+		}();
+		(void)registered;
+
+		std::vector<LayoutMember> members;
+		if (!GetArchiveKind(type, info, members, plan.kind))
+			return false;
+		// before compiling the other plans, a recursive type's plan is used with its archived type only
+		plan.archived = RegisterArchivedType(type);
+		if (!plan.archived)
+			return false;
+		const TypeInfo& archived_info = *Mngr.GetTypeInfo(plan.archived);
+		plan.const_archived = Mngr.tregistry.RegisterAddConst(plan.archived);
+		plan.size = archived_info.size;
+		plan.alignment = archived_info.alignment;
+
+		auto get_plan = [&](Type member_type) -> const ArchivePlan* {
+			const ArchivePlan* member_plan = cache.GetLocked(member_type.RemoveConst());
+			return member_plan && member_plan->state != SerializePlanState::Invalid ? member_plan : nullptr;
+		};
+
+		switch (plan.kind)
+		{
+		case ArchiveKind::Span:
+			plan.vtable = info.container_vtable;
+			plan.element_plan = get_plan(plan.vtable->element_type);
+			if (!plan.element_plan)
+				return false;
+			break;
+		case ArchiveKind::Pointer:
+			plan.element_plan = get_plan(type.RemovePointer());
+			if (!plan.element_plan)
+				return false;
+			break;
+		default:
+		{
+			// offsets are computed on a fake address (see GetLayoutMembers)
+			void* const fake = reinterpret_cast<void*>(std::uintptr_t{ 1 } << 16);
+			for (const auto& member : members) {
+				const ArchivePlan* member_plan = get_plan(member.type);
+				if (!member_plan)
+					return false;
+				std::size_t archived_offset = member.offset;
+				if (plan.kind == ArchiveKind::Object) {
+					void* member_ptr = member.name ?
+						archived_info.fieldinfos.at(member.name).fieldptr.Var(fake).GetPtr()
+						: archived_info.baseinfos.at(member_plan->archived).StaticCast_DerivedToBase(fake);
+					archived_offset = static_cast<std::size_t>(static_cast<std::byte*>(member_ptr) - static_cast<std::byte*>(fake));
+				}
+				plan.members.push_back({ member.name.GetID(), member.offset, archived_offset, member_plan });
+			}
+			break;
+		}
+		}
+
+		std::uint64_t fingerprint = HashCombine(plan.archived.GetID().GetValue(), static_cast<std::uint64_t>(plan.kind));
+		fingerprint = HashCombine(fingerprint, plan.size);
+		fingerprint = HashCombine(fingerprint, plan.alignment);
+		for (const auto& member : plan.members) {
+			fingerprint = HashCombine(fingerprint, member.name.GetValue());
+			fingerprint = HashCombine(fingerprint, member.archived_offset);
+			fingerprint = HashCombine(fingerprint, member.plan->archived.GetID().GetValue());
+		}
+		plan.fingerprint = fingerprint;
+
+		if (plan.kind == ArchiveKind::Span || plan.kind == ArchiveKind::Pointer) {
+			auto& refs = GetArchiveRefs();
+			std::unique_lock lock{ refs.mutex };
+			refs.plans.emplace(plan.archived.GetID(), &plan);
+		}
+
+		return true;
+	}
+
+	static const ArchivePlan* GetArchivePlan(Type type) {
+		static PlanCache<ArchivePlan> cache{ &CompileArchivePlan };
+		return cache.Get(type);
+	}
+
+	struct ArchiveLayout {
+		bool valid{ false };
+		std::uint64_t fingerprint{ 0 };
+		std::size_t alignment{ 1 };
+	};
+
+	// fingerprint of all the archived types reachable from root, in a deterministic order
+	static ArchiveLayout ComputeArchiveLayout(const ArchivePlan& root) {
+		ArchiveLayout layout;
+		std::vector<const ArchivePlan*> stack{ &root };
+		std::unordered_set<const ArchivePlan*> visited{ &root };
+		auto visit = [&](const ArchivePlan* plan) {
+			if (visited.insert(plan).second)
+				stack.push_back(plan);
+		};
+		while (!stack.empty()) {
+			const ArchivePlan* plan = stack.back();
+			stack.pop_back();
+			if (!plan->Valid())
+				return {};
+			layout.fingerprint = HashCombine(layout.fingerprint, plan->fingerprint);
+			layout.alignment = std::max(layout.alignment, plan->alignment);
+			for (const auto& member : plan->members)
+				visit(member.plan);
+			if (plan->element_plan)
+				visit(plan->element_plan);
+		}
+		layout.valid = true;
+		return layout;
+	}
+
+	// cached, plans are immutable after compiling
+	static ArchiveLayout GetArchiveLayout(const ArchivePlan& root) {
+		static std::shared_mutex mutex;
+		static std::unordered_map<const ArchivePlan*, ArchiveLayout> layouts;
+		{
+			std::shared_lock lock{ mutex };
+			auto target = layouts.find(&root);
+			if (target != layouts.end())
+				return target->second;
+		}
+		const ArchiveLayout layout = ComputeArchiveLayout(root);
+		if (layout.valid) {
+			std::unique_lock lock{ mutex };
+			layouts.emplace(&root, layout);
+		}
+		return layout;
+	}
+
+	//
+	// write
+	//////////
+
+	class ArchiveWriter {
+	public:
+		std::vector<std::byte> bytes;
+
+		// zero-filled
+		std::size_t Allocate(std::size_t size, std::size_t alignment) {
+			const std::size_t offset = RoundUp(bytes.size(), alignment);
+			bytes.resize(offset + size);
+			return offset;
+		}
+
+		std::size_t WriteRoot(const ArchivePlan& plan, const void* obj) {
+			const std::size_t root = Allocate(plan.size, plan.alignment);
+			pointees.emplace(std::pair{ obj, &plan }, root); // pointers to the root
+			return Write(plan, obj, root) && WritePointees() ? root : static_cast<std::size_t>(-1);
+		}
+
+	private:
+		bool Write(const ArchivePlan& plan, const void* obj, std::size_t offset);
+
+		// pointees are written after the object (iteratively, for long linked lists)
+		bool WritePointees() {
+			while (!pending.empty()) {
+				const Pending pointee = pending.back();
+				pending.pop_back();
+				if (!Write(*pointee.plan, pointee.obj, pointee.offset))
+					return false;
+			}
+			return true;
+		}
+
+		template<typename Ref>
+		void Store(std::size_t offset, const Ref& ref) {
+			std::memcpy(bytes.data() + offset, &ref, sizeof(Ref));
+		}
+
+		struct Pending {
+			const ArchivePlan* plan;
+			const void* obj;
+			std::size_t offset;
+		};
+		std::vector<Pending> pending;
+		// (address, plan) -> offset of the archived pointee
+		std::map<std::pair<const void*, const ArchivePlan*>, std::size_t> pointees;
+	};
+
+	bool ArchiveWriter::Write(const ArchivePlan& plan, const void* obj, std::size_t offset) {
+		switch (plan.kind)
+		{
+		case ArchiveKind::Bytes:
+			std::memcpy(bytes.data() + offset, obj, plan.size);
+			return true;
+		case ArchiveKind::Object:
+			for (const auto& member : plan.members) {
+				if (!Write(*member.plan, forward_offset(obj, member.offset), offset + member.archived_offset))
+					return false;
+			}
+			return true;
+		case ArchiveKind::Span:
+		{
+			const ArchivePlan& element_plan = *plan.element_plan;
+			if (!element_plan.Valid())
+				return false;
+			void* container = const_cast<void*>(obj);
+			const std::size_t count = plan.vtable->size(container);
+			if (count == 0)
+				return true;
+			const std::size_t elements = Allocate(count * element_plan.size, element_plan.alignment);
+			if (element_plan.kind == ArchiveKind::Bytes && plan.vtable->data)
+				std::memcpy(bytes.data() + elements, plan.vtable->data(container), count * element_plan.size);
+			else {
+				std::size_t i = 0;
+				bool success = ForEachElement(plan.vtable, container, [&](void* element) {
+					return i < count && Write(element_plan, element, elements + i++ * element_plan.size);
+				});
+				if (!success || i != count)
+					return false;
+			}
+			Store(offset, ArchiveSpan{ static_cast<std::int64_t>(elements - offset), count });
+			return true;
+		}
+		case ArchiveKind::Pointer:
+		{
+			const void* pointee = *static_cast<const void* const*>(obj);
+			if (!pointee)
+				return true;
+			const ArchivePlan& pointee_plan = *plan.element_plan;
+			if (!pointee_plan.Valid())
+				return false;
+			auto [target, inserted] = pointees.try_emplace({ pointee, &pointee_plan }, 0);
+			if (inserted) {
+				target->second = Allocate(pointee_plan.size, pointee_plan.alignment);
+				pending.push_back({ &pointee_plan, pointee, target->second });
+			}
+			Store(offset, ArchivePtr{ static_cast<std::int64_t>(target->second) - static_cast<std::int64_t>(offset) });
+			return true;
+		}
+		default:
+			assert(false);
+			return false;
+		}
+	}
+
+	//
+	// verify
+	///////////
+
+	// out-of-line regions (root, elements, pointees) of a valid archive never overlap,
+	// so every byte is checked once
+	class ArchiveVerifier {
+	public:
+		explicit ArchiveVerifier(std::span<const std::byte> archive) noexcept : archive{ archive } {}
+
+		bool Verify(const ArchivePlan& root, std::size_t root_offset) {
+			if (!Claim(0, sizeof(ArchiveHeader)) || !Claim(root_offset, root.size))
+				return false;
+			pointees.insert({ root_offset, &root });
+			stack.push_back({ &root, root_offset });
+			while (!stack.empty()) {
+				const Item item = stack.back();
+				stack.pop_back();
+				if (!VerifyItem(*item.plan, item.offset))
+					return false;
+			}
+			return true;
+		}
+
+	private:
+		struct Item {
+			const ArchivePlan* plan;
+			std::size_t offset;
+		};
+
+		// [begin, begin + size) is in the archive and doesn't overlap the claimed regions
+		bool Claim(std::size_t begin, std::size_t size) {
+			if (begin > archive.size() || size > archive.size() - begin)
+				return false;
+			const std::size_t end = begin + size;
+			auto next = regions.upper_bound(begin);
+			if (next != regions.end() && next->first < end)
+				return false;
+			if (next != regions.begin() && std::prev(next)->second > begin)
+				return false;
+			regions.emplace_hint(next, begin, end);
+			return true;
+		}
+
+		// the target of a relative reference at offset, SIZE_MAX if it's out of the archive or misaligned
+		std::size_t Target(std::size_t offset, std::int64_t relative, std::size_t alignment) const noexcept {
+			// relative is untrusted, check the range before adding it
+			if (offset >= archive.size() || relative < -static_cast<std::int64_t>(offset)
+				|| relative >= static_cast<std::int64_t>(archive.size() - offset))
+			{
+				return static_cast<std::size_t>(-1);
+			}
+			const auto target = static_cast<std::size_t>(static_cast<std::int64_t>(offset) + relative);
+			if (target % alignment != 0)
+				return static_cast<std::size_t>(-1);
+			return target;
+		}
+
+		void Push(const ArchivePlan& plan, std::size_t offset) {
+			if (plan.kind != ArchiveKind::Bytes)
+				stack.push_back({ &plan, offset });
+		}
+
+		bool VerifyItem(const ArchivePlan& plan, std::size_t offset) {
+			switch (plan.kind)
+			{
+			case ArchiveKind::Object:
+				for (const auto& member : plan.members)
+					Push(*member.plan, offset + member.archived_offset);
+				return true;
+			case ArchiveKind::Span:
+			{
+				ArchiveSpan span;
+				std::memcpy(&span, archive.data() + offset, sizeof(ArchiveSpan));
+				if (span.offset == 0)
+					return span.size == 0;
+				const ArchivePlan& element_plan = *plan.element_plan;
+				const std::size_t elements = Target(offset, span.offset, element_plan.alignment);
+				if (elements == static_cast<std::size_t>(-1) || span.size == 0
+					|| span.size > (archive.size() - elements) / std::max<std::size_t>(element_plan.size, 1)
+					|| !Claim(elements, static_cast<std::size_t>(span.size) * element_plan.size))
+				{
+					return false;
+				}
+				if (element_plan.kind != ArchiveKind::Bytes) {
+					for (std::size_t i = 0; i < span.size; i++)
+						stack.push_back({ &element_plan, elements + i * element_plan.size });
+				}
+				return true;
+			}
+			case ArchiveKind::Pointer:
+			{
+				ArchivePtr ptr;
+				std::memcpy(&ptr, archive.data() + offset, sizeof(ArchivePtr));
+				if (ptr.offset == 0)
+					return true;
+				const ArchivePlan& pointee_plan = *plan.element_plan;
+				const std::size_t pointee = Target(offset, ptr.offset, pointee_plan.alignment);
+				if (pointee == static_cast<std::size_t>(-1))
+					return false;
+				// shared pointees are checked once
+				if (!pointees.insert({ pointee, &pointee_plan }).second)
+					return true;
+				if (!Claim(pointee, pointee_plan.size))
+					return false;
+				Push(pointee_plan, pointee);
+				return true;
+			}
+			default: // Bytes
+				return true;
+			}
+		}
+
+		std::span<const std::byte> archive;
+		std::vector<Item> stack;
+		std::map<std::size_t, std::size_t> regions; // begin -> end
+		std::set<std::pair<std::size_t, const ArchivePlan*>> pointees;
+	};
+}
+
+Type Ubpa::UDRefl::ext::ArchivedType(Type type) {
+	const ArchivePlan* plan = GetArchivePlan(type);
+	if (!plan || !plan->Valid())
+		return {};
+	return plan->archived;
+}
+
+std::vector<std::byte> Ubpa::UDRefl::ext::ArchiveWrite(ObjectView obj) {
+	if (!obj.GetPtr())
+		return {};
+	const ArchivePlan* plan = GetArchivePlan(obj.GetType());
+	if (!plan)
+		return {};
+	const ArchiveLayout layout = GetArchiveLayout(*plan);
+	if (!layout.valid)
+		return {};
+
+	ArchiveWriter writer;
+	writer.Allocate(sizeof(ArchiveHeader), alignof(ArchiveHeader));
+	const std::size_t root = writer.WriteRoot(*plan, obj.GetPtr());
+	if (root == static_cast<std::size_t>(-1))
+		return {};
+
+	const ArchiveHeader header{
+		.magic = ArchiveMagic,
+		.version = ArchiveVersion,
+		.alignment = static_cast<std::uint32_t>(layout.alignment),
+		.type = obj.GetType().RemoveCVRef().GetID().GetValue(),
+		.fingerprint = layout.fingerprint,
+		.root = root,
+		.size = writer.bytes.size()
+	};
+	std::memcpy(writer.bytes.data(), &header, sizeof(ArchiveHeader));
+	return std::move(writer.bytes);
+}
+
+ObjectView Ubpa::UDRefl::ext::ArchiveLoad(Type type, std::span<const std::byte> archive, bool verify) {
+	if (archive.size() < sizeof(ArchiveHeader))
+		return {};
+	ArchiveHeader header;
+	std::memcpy(&header, archive.data(), sizeof(ArchiveHeader));
+	if (header.magic != ArchiveMagic || header.version != ArchiveVersion
+		|| header.type != type.RemoveCVRef().GetID().GetValue() || header.size > archive.size())
+	{
+		return {};
+	}
+
+	const ArchivePlan* plan = GetArchivePlan(type);
+	if (!plan)
+		return {};
+	const ArchiveLayout layout = GetArchiveLayout(*plan);
+	if (!layout.valid || header.fingerprint != layout.fingerprint || header.alignment != layout.alignment)
+		return {};
+
+	archive = archive.first(static_cast<std::size_t>(header.size));
+	if (reinterpret_cast<std::uintptr_t>(archive.data()) % layout.alignment != 0
+		|| header.root % plan->alignment != 0 || header.root > archive.size() || archive.size() - header.root < plan->size)
+	{
+		return {};
+	}
+	const auto root = static_cast<std::size_t>(header.root);
+	if (verify && !ArchiveVerifier{ archive }.Verify(*plan, root))
+		return {};
+
+	return { plan->const_archived, const_cast<std::byte*>(archive.data() + root) };
+}
+
+ObjectSpan Ubpa::UDRefl::ext::ArchiveElements(ObjectView span) {
+	const ArchivePlan* plan = FindArchiveRef(span.GetType());
+	if (!span.GetPtr() || !plan || plan->kind != ArchiveKind::Span)
+		return {};
+	const auto& archived = *static_cast<const ArchiveSpan*>(span.GetPtr());
+	const ArchivePlan& element_plan = *plan->element_plan;
+	return {
+		element_plan.const_archived,
+		const_cast<void*>(archived.GetData()),
+		static_cast<std::size_t>(archived.size),
+		element_plan.size
+	};
+}
+
+ObjectView Ubpa::UDRefl::ext::ArchiveDeref(ObjectView ptr) {
+	const ArchivePlan* plan = FindArchiveRef(ptr.GetType());
+	if (!ptr.GetPtr() || !plan || plan->kind != ArchiveKind::Pointer)
+		return {};
+	const void* pointee = static_cast<const ArchivePtr*>(ptr.GetPtr())->Get();
+	if (!pointee)
+		return {};
+	return { plan->element_plan->const_archived, const_cast<void*>(pointee) };
+}
+
+std::span<const std::byte> Ubpa::UDRefl::ext::ArchiveMapFile(const std::filesystem::path& path) {
+#if defined(_WIN32)
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return {};
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return {};
+	}
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return {};
+	// the view keeps the mapping alive
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data)
+		return {};
+	return { static_cast<const std::byte*>(data), static_cast<std::size_t>(size.QuadPart) };
+#else
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return {};
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		close(fd);
+		return {};
+	}
+	const auto size = static_cast<std::size_t>(st.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping keeps the file
+	if (data == MAP_FAILED)
+		return {};
+	return { static_cast<const std::byte*>(data), size };
+#endif
+}
+
+void Ubpa::UDRefl::ext::ArchiveUnmapFile(std::span<const std::byte> bytes) {
+	if (bytes.empty())
+		return;
+#if defined(_WIN32)
+	UnmapViewOfFile(bytes.data());
+#else
+	munmap(const_cast<std::byte*>(bytes.data()), bytes.size());
+#endif
+}
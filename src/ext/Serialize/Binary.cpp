@@ -0,0 +1,205 @@
+#include "SerializePlan.hpp"
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	std::size_t BinarySizeOf(const SerializePlan& plan, void* obj) {
+		if (plan.fixed)
+			return plan.min_binary_size;
+
+		std::size_t rst = 0;
+		for (const auto& op : plan.ops) {
+			switch (op.kind)
+			{
+			case SerializeOpKind::Copy:
+				rst += op.size;
+				break;
+			case SerializeOpKind::Container:
+			{
+				const SerializePlan& element_plan = *op.element_plan;
+				if (!element_plan.Valid())
+					return SerializeError;
+				void* container = forward_offset(obj, op.offset);
+				rst += sizeof(std::uint64_t);
+				if (element_plan.fixed)
+					rst += op.vtable->size(container) * element_plan.min_binary_size;
+				else {
+					bool success = ForEachElement(op.vtable, container, [&](void* element) {
+						const std::size_t element_size = BinarySizeOf(element_plan, element);
+						if (element_size == SerializeError)
+							return false;
+						rst += element_size;
+						return true;
+					});
+					if (!success)
+						return SerializeError;
+				}
+				break;
+			}
+			default:
+				assert(false);
+				return SerializeError;
+			}
+		}
+		return rst;
+	}
+
+	bool BinaryWritePlan(const SerializePlan& plan, const void* obj, BinaryWriter& writer) {
+		for (const auto& op : plan.ops) {
+			switch (op.kind)
+			{
+			case SerializeOpKind::Copy:
+				if (!writer.Write(forward_offset(obj, op.offset), op.size))
+					return false;
+				break;
+			case SerializeOpKind::Container:
+			{
+				const SerializePlan& element_plan = *op.element_plan;
+				if (!element_plan.Valid())
+					return false;
+				// the vtable takes non-const pointers, the container isn't modified
+				void* container = const_cast<void*>(forward_offset(obj, op.offset));
+				const auto count = static_cast<std::uint64_t>(op.vtable->size(container));
+				if (!writer.Write(&count, sizeof(std::uint64_t)))
+					return false;
+				if (element_plan.IsBytes() && op.vtable->data) {
+					if (!writer.Write(op.vtable->data(container), static_cast<std::size_t>(count) * element_plan.size))
+						return false;
+				}
+				else if (!ForEachElement(op.vtable, container, [&](void* element) { return BinaryWritePlan(element_plan, element, writer); }))
+					return false;
+				break;
+			}
+			default:
+				assert(false);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool BinaryReadContainer(const SerializeOp& op, void* container, BinaryReader& reader);
+
+	bool BinaryReadPlan(const SerializePlan& plan, void* obj, BinaryReader& reader) {
+		for (const auto& op : plan.ops) {
+			switch (op.kind)
+			{
+			case SerializeOpKind::Copy:
+				if (!reader.Read(forward_offset(obj, op.offset), op.size))
+					return false;
+				break;
+			case SerializeOpKind::Container:
+				if (!BinaryReadContainer(op, forward_offset(obj, op.offset), reader))
+					return false;
+				break;
+			default:
+				assert(false);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool BinaryReadContainer(const SerializeOp& op, void* container, BinaryReader& reader) {
+		const SerializePlan& element_plan = *op.element_plan;
+		const ContainerVTable* vtable = op.vtable;
+		if (!element_plan.Valid())
+			return false;
+
+		std::uint64_t count;
+		if (!reader.Read(&count, sizeof(std::uint64_t)))
+			return false;
+		// reject corrupted counts before reserving
+		if (count > reader.Remain() / std::max<std::size_t>(element_plan.min_binary_size, 1))
+			return false;
+		const auto n = static_cast<std::size_t>(count);
+
+		if (!vtable->clear) {
+			// fixed size (e.g. std::array), read in place
+			if (n != vtable->size(container))
+				return false;
+			if (element_plan.IsBytes() && vtable->data)
+				return reader.Read(vtable->data(container), n * element_plan.size);
+			return ForEachElement(op.vtable, container, [&](void* element) { return BinaryReadPlan(element_plan, element, reader); });
+		}
+
+		if (element_plan.IsBytes() && element_plan.trivial && vtable->data && vtable->append) {
+			// resize + memcpy (see ContainerVTable::append), other bytes types are copied by emplace_back + memcpy
+			vtable->clear(container);
+			if (!vtable->append(container, const_cast<std::byte*>(reader.cur), n, false))
+				return false;
+			reader.cur += n * element_plan.size;
+			return true;
+		}
+
+		if (vtable->emplace_back) {
+			vtable->clear(container);
+			if (vtable->reserve)
+				vtable->reserve(container, n);
+			for (std::size_t i = 0; i < n; i++) {
+				if (!BinaryReadPlan(element_plan, vtable->emplace_back(container), reader))
+					return false;
+			}
+			return true;
+		}
+
+		if (vtable->append) {
+			// associative containers : read into a temporary element, then move it in
+			vtable->clear(container);
+			if (n == 0)
+				return true;
+			std::pmr::memory_resource* rsrc = Mngr.GetTemporaryResource();
+			ObjectView element = Mngr.MNew(op.element_type, rsrc);
+			if (!element.GetPtr())
+				return false;
+			bool success = true;
+			for (std::size_t i = 0; success && i < n; i++) {
+				success = BinaryReadPlan(element_plan, element.GetPtr(), reader)
+					&& vtable->append(container, element.GetPtr(), 1, true);
+			}
+			Mngr.MDelete(element, rsrc);
+			return success;
+		}
+
+		return false;
+	}
+
+	const SerializePlan* GetValidPlan(ObjectView obj) {
+		if (!obj.GetPtr())
+			return nullptr;
+		const SerializePlan* plan = GetSerializePlan(obj.GetType());
+		return plan && plan->Valid() ? plan : nullptr;
+	}
+}
+
+std::size_t Ubpa::UDRefl::ext::BinarySize(ObjectView obj) {
+	const SerializePlan* plan = GetValidPlan(obj);
+	if (!plan)
+		return SerializeError;
+	return BinarySizeOf(*plan, obj.GetPtr());
+}
+
+std::size_t Ubpa::UDRefl::ext::BinaryWrite(ObjectView obj, std::span<std::byte> buffer) {
+	const SerializePlan* plan = GetValidPlan(obj);
+	if (!plan)
+		return SerializeError;
+	BinaryWriter writer{ buffer.data(), buffer.data() + buffer.size() };
+	if (!BinaryWritePlan(*plan, obj.GetPtr(), writer))
+		return SerializeError;
+	return static_cast<std::size_t>(writer.cur - buffer.data());
+}
+
+std::size_t Ubpa::UDRefl::ext::BinaryRead(ObjectView obj, std::span<const std::byte> buffer) {
+	if (obj.GetType().RemoveReference().IsConst())
+		return SerializeError;
+	const SerializePlan* plan = GetValidPlan(obj);
+	if (!plan)
+		return SerializeError;
+	BinaryReader reader{ buffer.data(), buffer.data() + buffer.size() };
+	if (!BinaryReadPlan(*plan, obj.GetPtr(), reader))
+		return SerializeError;
+	return static_cast<std::size_t>(reader.cur - buffer.data());
+}
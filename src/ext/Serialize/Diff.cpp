@@ -0,0 +1,412 @@
+#include "SerializePlan.hpp"
+
+#include <UDRefl_ext/Diff.hpp>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	struct DiffPlan;
+
+	enum class DiffKind : std::uint8_t {
+		Bytes,
+		Object,
+		Container
+	};
+
+	struct DiffField {
+		std::size_t offset;
+		const DiffPlan* plan;
+	};
+
+	// fields [begin, end), the bytes [offset, offset + size) are compared as a whole if size > 0
+	struct DiffRun {
+		std::size_t offset;
+		std::size_t size;
+		std::uint32_t begin;
+		std::uint32_t end;
+	};
+
+	struct DiffPlan {
+		SerializePlanState state{ SerializePlanState::Compiling };
+		DiffKind kind{ DiffKind::Bytes };
+		Type type; // without cvref
+		std::size_t size{ 0 }; // the size of the type
+		bool comparable{ false }; // trivial without padding, equal iff the bytes are equal
+		const SerializePlan* value_plan{ nullptr }; // new values of entries
+
+		// Container
+		const ContainerVTable* vtable{ nullptr };
+		Type element_type; // without const
+		const DiffPlan* element_plan{ nullptr };
+
+		// Object
+		std::vector<DiffField> fields; // path steps are their indices
+		std::vector<DiffRun> runs;
+
+		bool Valid() const noexcept { return state == SerializePlanState::Valid; }
+	};
+
+	static bool AppendDiffFields(PlanCache<DiffPlan>& cache, const std::vector<LayoutMember>& members,
+		std::size_t offset, std::vector<DiffField>& fields)
+	{
+		return ForEachLayoutField(members, offset, [&](Name, Type type, std::size_t field_offset) {
+			// the plan is Compiling if the types are mutually recursive through a container
+			// (e.g. A { std::vector<B> }, B { A }), its size is known and it isn't comparable (a container inside)
+			const DiffPlan* plan = cache.GetLocked(type);
+			if (!plan || plan->state == SerializePlanState::Invalid)
+				return false;
+			fields.push_back({ field_offset, plan });
+			return true;
+		});
+	}
+
+	static bool CompileDiffPlan(PlanCache<DiffPlan>& cache, Type type, const TypeInfo& info, DiffPlan& plan) {
+		plan.type = type;
+		plan.size = info.size;
+		plan.value_plan = GetSerializePlan(type);
+		if (!plan.value_plan || !plan.value_plan->Valid())
+			return false;
+
+		std::vector<LayoutMember> members;
+		if (!GetLayoutMembers(info, members))
+			return false;
+
+		if (!members.empty()) {
+			plan.kind = DiffKind::Object;
+			if (!AppendDiffFields(cache, members, 0, plan.fields))
+				return false;
+
+			// merge adjacent comparable fields into runs
+			std::size_t cursor = 0; // end of the last field if the fields tile the object
+			bool tiled = true;
+			for (std::size_t i = 0; i < plan.fields.size(); i++) {
+				const DiffField& field = plan.fields[i];
+				tiled = tiled && field.offset == cursor && field.plan->comparable;
+				cursor = field.offset + field.plan->size;
+				if (!field.plan->comparable) {
+					plan.runs.push_back({ field.offset, 0, static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i + 1) });
+					continue;
+				}
+				if (!plan.runs.empty() && plan.runs.back().size > 0
+					&& plan.runs.back().offset + plan.runs.back().size == field.offset)
+				{
+					plan.runs.back().size += field.plan->size;
+					plan.runs.back().end = static_cast<std::uint32_t>(i + 1);
+				}
+				else
+					plan.runs.push_back({ field.offset, field.plan->size, static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i + 1) });
+			}
+			plan.comparable = info.is_trivial && tiled && cursor == info.size;
+			return true;
+		}
+
+		if (info.is_trivial) {
+			plan.kind = DiffKind::Bytes;
+			plan.comparable = true;
+			return true;
+		}
+
+		if (const ContainerVTable* vtable = info.container_vtable;
+			vtable && vtable->element_type && vtable->size && (vtable->data || vtable->for_each))
+		{
+			plan.kind = DiffKind::Container;
+			plan.vtable = vtable;
+			plan.element_type = vtable->element_type.RemoveConst();
+			plan.element_plan = cache.GetLocked(plan.element_type);
+			return plan.element_plan && plan.element_plan->state != SerializePlanState::Invalid;
+		}
+
+		return false;
+	}
+
+	static const DiffPlan* GetDiffPlan(Type type) {
+		static PlanCache<DiffPlan> cache{ &CompileDiffPlan };
+		return cache.Get(type);
+	}
+
+	//
+	// compare
+	////////////
+
+	static bool DiffEqual(const DiffPlan& plan, const void* lhs, const void* rhs) {
+		if (!plan.Valid())
+			return false;
+		if (plan.comparable)
+			return std::memcmp(lhs, rhs, plan.size) == 0;
+
+		switch (plan.kind)
+		{
+		case DiffKind::Object:
+			for (const auto& run : plan.runs) {
+				if (run.size > 0) {
+					if (std::memcmp(forward_offset(lhs, run.offset), forward_offset(rhs, run.offset), run.size) != 0)
+						return false;
+					continue;
+				}
+				const DiffField& field = plan.fields[run.begin];
+				if (!DiffEqual(*field.plan, forward_offset(lhs, field.offset), forward_offset(rhs, field.offset)))
+					return false;
+			}
+			return true;
+		case DiffKind::Container:
+		{
+			const DiffPlan& element_plan = *plan.element_plan;
+			const ContainerVTable* vtable = plan.vtable;
+			// the vtable takes non-const pointers, the containers aren't modified
+			void* lhs_container = const_cast<void*>(lhs);
+			void* rhs_container = const_cast<void*>(rhs);
+			const std::size_t count = vtable->size(lhs_container);
+			if (count != vtable->size(rhs_container))
+				return false;
+			if (count == 0)
+				return true;
+
+			if (vtable->data) {
+				const void* lhs_data = vtable->data(lhs_container);
+				const void* rhs_data = vtable->data(rhs_container);
+				if (element_plan.comparable)
+					return std::memcmp(lhs_data, rhs_data, count * vtable->element_size) == 0;
+				for (std::size_t i = 0; i < count; i++) {
+					const std::size_t offset = i * vtable->element_size;
+					if (!DiffEqual(element_plan, forward_offset(lhs_data, offset), forward_offset(rhs_data, offset)))
+						return false;
+				}
+				return true;
+			}
+
+			// iterate both in step, unknown if the iterator isn't supported (treated as changed)
+			if (!vtable->begin)
+				return false;
+			const ContainerView lhs_view{ ObjectView{ plan.type, lhs_container }, vtable, plan.element_type };
+			const ContainerView rhs_view{ ObjectView{ plan.type, rhs_container }, vtable, plan.element_type };
+			auto rhs_iter = rhs_view.begin();
+			for (ObjectView lhs_element : lhs_view) {
+				if (!DiffEqual(element_plan, lhs_element.GetPtr(), (*rhs_iter).GetPtr()))
+					return false;
+				++rhs_iter;
+			}
+			return true;
+		}
+		default: // Bytes are comparable
+			assert(false);
+			return false;
+		}
+	}
+
+	//
+	// diff
+	/////////
+
+	static void AppendBytes(std::vector<std::byte>& patch, const void* src, std::size_t n) {
+		const auto* bytes = static_cast<const std::byte*>(src);
+		patch.insert(patch.end(), bytes, bytes + n);
+	}
+
+	class DiffWriter {
+	public:
+		explicit DiffWriter(std::vector<std::byte>& patch) noexcept : patch{ patch } {}
+
+		bool Value(const DiffPlan& plan, const void* from, const void* to) {
+			if (!plan.Valid())
+				return false;
+
+			switch (plan.kind)
+			{
+			case DiffKind::Bytes:
+				return std::memcmp(from, to, plan.size) == 0 || Entry(plan, to);
+			case DiffKind::Object:
+				for (const auto& run : plan.runs) {
+					if (run.size > 0 && std::memcmp(forward_offset(from, run.offset), forward_offset(to, run.offset), run.size) == 0)
+						continue;
+					for (std::uint32_t i = run.begin; i < run.end; i++) {
+						const DiffField& field = plan.fields[i];
+						const void* from_field = forward_offset(from, field.offset);
+						const void* to_field = forward_offset(to, field.offset);
+						if (field.plan->comparable && std::memcmp(from_field, to_field, field.plan->size) == 0)
+							continue;
+						path.push_back(i);
+						const bool success = Value(*field.plan, from_field, to_field);
+						path.pop_back();
+						if (!success)
+							return false;
+					}
+				}
+				return true;
+			case DiffKind::Container:
+				return Container(plan, from, to);
+			default:
+				assert(false);
+				return false;
+			}
+		}
+
+		std::uint64_t count{ 0 };
+
+	private:
+		bool Container(const DiffPlan& plan, const void* from, const void* to) {
+			const DiffPlan& element_plan = *plan.element_plan;
+			const ContainerVTable* vtable = plan.vtable;
+			void* from_container = const_cast<void*>(from);
+			void* to_container = const_cast<void*>(to);
+			const std::size_t from_count = vtable->size(from_container);
+			const std::size_t to_count = vtable->size(to_container);
+
+			if (!vtable->data || from_count != to_count) {
+				if (from_count == to_count && DiffEqual(plan, from, to))
+					return true;
+				return Entry(plan, to);
+			}
+
+			// element by element
+			if (to_count == 0)
+				return true;
+			const void* from_data = vtable->data(from_container);
+			const void* to_data = vtable->data(to_container);
+			if (element_plan.comparable && std::memcmp(from_data, to_data, to_count * vtable->element_size) == 0)
+				return true;
+			for (std::size_t i = 0; i < to_count; i++) {
+				const std::size_t offset = i * vtable->element_size;
+				const void* from_element = forward_offset(from_data, offset);
+				const void* to_element = forward_offset(to_data, offset);
+				if (element_plan.comparable && std::memcmp(from_element, to_element, element_plan.size) == 0)
+					continue;
+				path.push_back(i);
+				const bool success = Value(element_plan, from_element, to_element);
+				path.pop_back();
+				if (!success)
+					return false;
+			}
+			return true;
+		}
+
+		// path + the new value
+		bool Entry(const DiffPlan& plan, const void* to) {
+			const SerializePlan& value_plan = *plan.value_plan;
+			const std::uint64_t size = BinarySizeOf(value_plan, const_cast<void*>(to));
+			if (size == SerializeError)
+				return false;
+			const auto depth = static_cast<std::uint32_t>(path.size());
+			AppendBytes(patch, &depth, sizeof(std::uint32_t));
+			AppendBytes(patch, path.data(), path.size() * sizeof(std::uint64_t));
+			AppendBytes(patch, &size, sizeof(std::uint64_t));
+
+			const std::size_t value_offset = patch.size();
+			patch.resize(value_offset + static_cast<std::size_t>(size));
+			BinaryWriter writer{ patch.data() + value_offset, patch.data() + patch.size() };
+			if (!BinaryWritePlan(value_plan, to, writer))
+				return false;
+			++count;
+			return true;
+		}
+
+		std::vector<std::byte>& patch;
+		std::vector<std::uint64_t> path;
+	};
+
+	static constexpr std::size_t PatchHeaderSize = 2 * sizeof(std::uint64_t);
+
+	//
+	// apply
+	//////////
+
+	static bool ApplyEntry(const DiffPlan* plan, void* obj, BinaryReader& reader) {
+		std::uint32_t depth;
+		if (!reader.Read(&depth, sizeof(std::uint32_t)) || depth > reader.Remain() / sizeof(std::uint64_t))
+			return false;
+
+		// walk the path
+		for (std::uint32_t i = 0; i < depth; i++) {
+			std::uint64_t step;
+			if (!reader.Read(&step, sizeof(std::uint64_t)))
+				return false;
+			switch (plan->kind)
+			{
+			case DiffKind::Object:
+			{
+				if (step >= plan->fields.size())
+					return false;
+				const DiffField& field = plan->fields[static_cast<std::size_t>(step)];
+				obj = forward_offset(obj, field.offset);
+				plan = field.plan;
+				break;
+			}
+			case DiffKind::Container:
+				if (!plan->vtable->data || step >= plan->vtable->size(obj))
+					return false;
+				obj = forward_offset(plan->vtable->data(obj), static_cast<std::size_t>(step) * plan->vtable->element_size);
+				plan = plan->element_plan;
+				break;
+			default:
+				return false;
+			}
+			if (!plan->Valid())
+				return false;
+		}
+
+		std::uint64_t size;
+		if (!reader.Read(&size, sizeof(std::uint64_t)) || size > reader.Remain())
+			return false;
+		BinaryReader value_reader{ reader.cur, reader.cur + static_cast<std::size_t>(size) };
+		if (!BinaryReadPlan(*plan->value_plan, obj, value_reader) || value_reader.cur != value_reader.end)
+			return false;
+		reader.cur = value_reader.end;
+		return true;
+	}
+}
+
+bool Ubpa::UDRefl::ext::IsDiffable(Type type) {
+	const DiffPlan* plan = GetDiffPlan(type);
+	return plan && plan->Valid();
+}
+
+bool Ubpa::UDRefl::ext::Diff(ObjectView from, ObjectView to, std::vector<std::byte>& patch) {
+	patch.clear();
+	if (!from.GetPtr() || !to.GetPtr())
+		return false;
+	const Type type = to.GetType().RemoveCVRef();
+	if (from.GetType().RemoveCVRef() != type)
+		return false;
+	const DiffPlan* plan = GetDiffPlan(type);
+	if (!plan || !plan->Valid())
+		return false;
+
+	const std::uint64_t header[2] = { type.GetID().GetValue(), 0 };
+	AppendBytes(patch, header, PatchHeaderSize);
+	DiffWriter writer{ patch };
+	if (!writer.Value(*plan, from.GetPtr(), to.GetPtr())) {
+		patch.clear();
+		return false;
+	}
+	std::memcpy(patch.data() + sizeof(std::uint64_t), &writer.count, sizeof(std::uint64_t));
+	return true;
+}
+
+std::size_t Ubpa::UDRefl::ext::PatchEntryCount(std::span<const std::byte> patch) {
+	if (patch.size() < PatchHeaderSize)
+		return SerializeError;
+	std::uint64_t count;
+	std::memcpy(&count, patch.data() + sizeof(std::uint64_t), sizeof(std::uint64_t));
+	return static_cast<std::size_t>(count);
+}
+
+bool Ubpa::UDRefl::ext::Apply(ObjectView obj, std::span<const std::byte> patch) {
+	if (!obj.GetPtr() || obj.GetType().RemoveReference().IsConst())
+		return false;
+	const Type type = obj.GetType().RemoveCVRef();
+	const DiffPlan* plan = GetDiffPlan(type);
+	if (!plan || !plan->Valid())
+		return false;
+
+	BinaryReader reader{ patch.data(), patch.data() + patch.size() };
+	std::uint64_t header[2];
+	if (!reader.Read(header, PatchHeaderSize) || header[0] != type.GetID().GetValue())
+		return false;
+	for (std::uint64_t i = 0; i < header[1]; i++) {
+		if (!ApplyEntry(plan, obj.GetPtr(), reader))
+			return false;
+	}
+	return reader.cur == reader.end;
+}
@@ -0,0 +1,755 @@
+#include "SerializePlan.hpp"
+
+#include <UDRefl_ext/Json.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	struct JsonPlan;
+
+	enum class JsonKind : std::uint8_t {
+		Bool,
+		Int,
+		UInt,
+		Float,
+		Double,
+		String,
+		Array,
+		Object
+	};
+
+	struct JsonField {
+		std::string key; // rendered "\"name\":"
+		NameID id;
+		std::size_t offset;
+		const JsonPlan* plan;
+	};
+
+	struct JsonPlan {
+		SerializePlanState state{ SerializePlanState::Compiling };
+		JsonKind kind{ JsonKind::Object };
+		std::size_t size{ 0 }; // the size of the type
+
+		// Array
+		const ContainerVTable* vtable{ nullptr };
+		Type element_type; // without const
+		const JsonPlan* element_plan{ nullptr };
+
+		// Object
+		std::vector<JsonField> fields; // in the order of offsets
+		std::vector<std::pair<NameID, std::size_t>> field_index; // sorted by NameID, index of fields
+
+		bool Valid() const noexcept { return state == SerializePlanState::Valid; }
+
+		const JsonField* FindField(NameID id) const noexcept {
+			auto target = std::lower_bound(field_index.begin(), field_index.end(), id,
+				[](const std::pair<NameID, std::size_t>& lhs, NameID rhs) { return lhs.first < rhs; });
+			return target != field_index.end() && target->first == id ? &fields[target->second] : nullptr;
+		}
+	};
+
+	struct JsonScalar {
+		TypeID id;
+		JsonKind kind;
+	};
+
+	static constexpr JsonScalar JsonScalars[] = {
+		{ TypeID_of<bool>,               JsonKind::Bool   },
+		{ TypeID_of<char>,               std::is_signed_v<char> ? JsonKind::Int : JsonKind::UInt },
+		{ TypeID_of<signed char>,        JsonKind::Int    },
+		{ TypeID_of<unsigned char>,      JsonKind::UInt   },
+		{ TypeID_of<short>,              JsonKind::Int    },
+		{ TypeID_of<unsigned short>,     JsonKind::UInt   },
+		{ TypeID_of<int>,                JsonKind::Int    },
+		{ TypeID_of<unsigned int>,       JsonKind::UInt   },
+		{ TypeID_of<long>,               JsonKind::Int    },
+		{ TypeID_of<unsigned long>,      JsonKind::UInt   },
+		{ TypeID_of<long long>,          JsonKind::Int    },
+		{ TypeID_of<unsigned long long>, JsonKind::UInt   },
+		{ TypeID_of<float>,              JsonKind::Float  },
+		{ TypeID_of<double>,             JsonKind::Double },
+	};
+
+	// the escape sequence of c, empty if c doesn't need it
+	static std::string_view JsonEscape(char c, char(&buffer)[6]) noexcept {
+		switch (c)
+		{
+		case '"':  return "\\\"";
+		case '\\': return "\\\\";
+		case '\b': return "\\b";
+		case '\f': return "\\f";
+		case '\n': return "\\n";
+		case '\r': return "\\r";
+		case '\t': return "\\t";
+		default:
+		{
+			if (static_cast<unsigned char>(c) >= 0x20)
+				return {};
+			constexpr char hex[] = "0123456789abcdef";
+			buffer[0] = '\\';
+			buffer[1] = 'u';
+			buffer[2] = '0';
+			buffer[3] = '0';
+			buffer[4] = hex[(c >> 4) & 0xf];
+			buffer[5] = hex[c & 0xf];
+			return { buffer, 6 };
+		}
+		}
+	}
+
+	static void AppendJsonEscaped(std::string& out, std::string_view str) {
+		for (char c : str) {
+			char buffer[6];
+			const std::string_view escaped = JsonEscape(c, buffer);
+			if (escaped.empty())
+				out += c;
+			else
+				out += escaped;
+		}
+	}
+
+	static bool AppendJsonFields(PlanCache<JsonPlan>& cache, const std::vector<LayoutMember>& members,
+		std::size_t offset, std::vector<JsonField>& fields)
+	{
+		return ForEachLayoutField(members, offset, [&](Name name, Type type, std::size_t field_offset) {
+			const JsonPlan* plan = cache.GetLocked(type);
+			if (!plan || plan->state == SerializePlanState::Invalid)
+				return false;
+			std::string key = "\"";
+			AppendJsonEscaped(key, name.GetView());
+			key += "\":";
+			fields.push_back({ std::move(key), name.GetID(), field_offset, plan });
+			return true;
+		});
+	}
+
+	static bool CompileJsonPlan(PlanCache<JsonPlan>& cache, Type type, const TypeInfo& info, JsonPlan& plan) {
+		plan.size = info.size;
+		for (const auto& scalar : JsonScalars) {
+			if (type.GetID() == scalar.id) {
+				plan.kind = scalar.kind;
+				return true;
+			}
+		}
+		if (type == Type_of<std::string>) {
+			plan.kind = JsonKind::String;
+			return true;
+		}
+
+		std::vector<LayoutMember> members;
+		if (!GetLayoutMembers(info, members))
+			return false;
+
+		if (!members.empty()) {
+			plan.kind = JsonKind::Object;
+			if (!AppendJsonFields(cache, members, 0, plan.fields))
+				return false;
+			plan.field_index.reserve(plan.fields.size());
+			for (std::size_t i = 0; i < plan.fields.size(); i++)
+				plan.field_index.emplace_back(plan.fields[i].id, i);
+			// a shadowed field of a base comes first (lower offset), the stable sort keeps it reachable
+			std::stable_sort(plan.field_index.begin(), plan.field_index.end(),
+				[](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+			return true;
+		}
+
+		if (const ContainerVTable* vtable = info.container_vtable;
+			vtable && vtable->element_type && (vtable->data || vtable->for_each))
+		{
+			plan.kind = JsonKind::Array;
+			plan.vtable = vtable;
+			plan.element_type = vtable->element_type.RemoveConst();
+			plan.element_plan = cache.GetLocked(plan.element_type);
+			return plan.element_plan && plan.element_plan->state != SerializePlanState::Invalid;
+		}
+
+		return false;
+	}
+
+	static const JsonPlan* GetJsonPlan(Type type) {
+		static PlanCache<JsonPlan> cache{ &CompileJsonPlan };
+		return cache.Get(type);
+	}
+
+	//
+	// write
+	//////////
+
+	class JsonWriter {
+	public:
+		explicit JsonWriter(JsonSink& sink) noexcept : sink{ sink } {}
+
+		bool Ok() const noexcept { return ok; }
+
+		// space of n (<= JsonChunkSize) bytes, then Commit the used ones
+		char* Reserve(std::size_t n) {
+			assert(n <= JsonChunkSize);
+			if (JsonChunkSize - pos < n)
+				Flush();
+			return chunk + pos;
+		}
+		void Commit(std::size_t n) noexcept { pos += n; }
+
+		void Put(char c) {
+			*Reserve(1) = c;
+			++pos;
+		}
+
+		void Put(std::string_view str) {
+			if (JsonChunkSize - pos < str.size()) {
+				Flush();
+				if (str.size() > JsonChunkSize) {
+					if (ok)
+						ok = sink.Write(str);
+					return;
+				}
+			}
+			std::memcpy(chunk + pos, str.data(), str.size());
+			pos += str.size();
+		}
+
+		bool Flush() {
+			if (pos > 0 && ok)
+				ok = sink.Write({ chunk, pos });
+			pos = 0;
+			return ok;
+		}
+
+	private:
+		JsonSink& sink;
+		std::size_t pos{ 0 };
+		bool ok{ true };
+		char chunk[JsonChunkSize];
+	};
+
+	static void JsonPutString(JsonWriter& writer, std::string_view str) {
+		writer.Put('"');
+		std::size_t run = 0; // begin of the run without escapes
+		for (std::size_t i = 0; i < str.size(); i++) {
+			char buffer[6];
+			const std::string_view escaped = JsonEscape(str[i], buffer);
+			if (escaped.empty())
+				continue;
+			writer.Put(str.substr(run, i - run));
+			writer.Put(escaped);
+			run = i + 1;
+		}
+		writer.Put(str.substr(run));
+		writer.Put('"');
+	}
+
+	template<typename T>
+	static void JsonWriteNumber(JsonWriter& writer, T value) {
+		constexpr std::size_t MaxNumberSize = 64;
+		if constexpr (std::is_floating_point_v<T>) {
+			if (!std::isfinite(value)) {
+				writer.Put(std::string_view{ "null" });
+				return;
+			}
+		}
+		char* first = writer.Reserve(MaxNumberSize);
+		auto [last, ec] = std::to_chars(first, first + MaxNumberSize, value);
+		assert(ec == std::errc{});
+		writer.Commit(static_cast<std::size_t>(last - first));
+	}
+
+	template<typename T>
+	static T JsonLoad(const void* obj) noexcept {
+		T value;
+		std::memcpy(&value, obj, sizeof(T));
+		return value;
+	}
+
+	static bool JsonWriteValue(JsonWriter& writer, const JsonPlan& plan, const void* obj) {
+		if (!plan.Valid() || !writer.Ok())
+			return false;
+
+		switch (plan.kind)
+		{
+		case JsonKind::Bool:
+			writer.Put(*static_cast<const bool*>(obj) ? std::string_view{ "true" } : std::string_view{ "false" });
+			return true;
+		case JsonKind::Int:
+			switch (plan.size)
+			{
+			case 1: JsonWriteNumber(writer, JsonLoad<std::int8_t >(obj)); return true;
+			case 2: JsonWriteNumber(writer, JsonLoad<std::int16_t>(obj)); return true;
+			case 4: JsonWriteNumber(writer, JsonLoad<std::int32_t>(obj)); return true;
+			case 8: JsonWriteNumber(writer, JsonLoad<std::int64_t>(obj)); return true;
+			default: return false;
+			}
+		case JsonKind::UInt:
+			switch (plan.size)
+			{
+			case 1: JsonWriteNumber(writer, JsonLoad<std::uint8_t >(obj)); return true;
+			case 2: JsonWriteNumber(writer, JsonLoad<std::uint16_t>(obj)); return true;
+			case 4: JsonWriteNumber(writer, JsonLoad<std::uint32_t>(obj)); return true;
+			case 8: JsonWriteNumber(writer, JsonLoad<std::uint64_t>(obj)); return true;
+			default: return false;
+			}
+		case JsonKind::Float:
+			JsonWriteNumber(writer, JsonLoad<float>(obj));
+			return true;
+		case JsonKind::Double:
+			JsonWriteNumber(writer, JsonLoad<double>(obj));
+			return true;
+		case JsonKind::String:
+			JsonPutString(writer, *static_cast<const std::string*>(obj));
+			return true;
+		case JsonKind::Array:
+		{
+			const ContainerVTable* vtable = plan.vtable;
+			// the vtable takes non-const pointers, the container isn't modified
+			void* container = const_cast<void*>(obj);
+			writer.Put('[');
+			if (vtable->data) {
+				const auto* data = static_cast<const std::byte*>(vtable->data(container));
+				const std::size_t count = vtable->size(container);
+				for (std::size_t i = 0; i < count; i++) {
+					if (i > 0)
+						writer.Put(',');
+					if (!JsonWriteValue(writer, *plan.element_plan, data + i * vtable->element_size))
+						return false;
+				}
+			}
+			else {
+				struct Context {
+					JsonWriter& writer;
+					const JsonPlan& element_plan;
+					bool first;
+					bool ok;
+				} ctx{ writer, *plan.element_plan, true, true };
+				vtable->for_each(
+					container,
+					[](void* element, void* ctx) {
+						auto& context = *static_cast<Context*>(ctx);
+						if (!context.ok)
+							return;
+						if (!context.first)
+							context.writer.Put(',');
+						context.first = false;
+						context.ok = JsonWriteValue(context.writer, context.element_plan, element);
+					},
+					&ctx
+				);
+				if (!ctx.ok)
+					return false;
+			}
+			writer.Put(']');
+			return true;
+		}
+		case JsonKind::Object:
+			writer.Put('{');
+			for (std::size_t i = 0; i < plan.fields.size(); i++) {
+				const JsonField& field = plan.fields[i];
+				if (i > 0)
+					writer.Put(',');
+				writer.Put(field.key);
+				if (!JsonWriteValue(writer, *field.plan, forward_offset(obj, field.offset)))
+					return false;
+			}
+			writer.Put('}');
+			return true;
+		default:
+			assert(false);
+			return false;
+		}
+	}
+
+	//
+	// read
+	/////////
+
+	// the whole number must be consumed and in range,
+	// on errc::result_out_of_range std::from_chars leaves the value untouched
+	template<typename T>
+	static bool JsonFromChars(const char* first, const char* last, T& value) noexcept {
+		const auto [ptr, ec] = std::from_chars(first, last, value);
+		return ec == std::errc{} && ptr == last;
+	}
+
+	class JsonReader {
+	public:
+		explicit JsonReader(JsonSource& source) noexcept : source{ source } {}
+
+		// -1 at the end
+		int Peek() {
+			if (cur == end && !Refill())
+				return -1;
+			return static_cast<unsigned char>(*cur);
+		}
+
+		int PeekNonSpace() {
+			for (;;) {
+				const int c = Peek();
+				if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+					return c;
+				++cur;
+			}
+		}
+
+		// call it after Peek returns a char
+		void Skip() noexcept { ++cur; }
+
+		bool Consume(char c) {
+			if (PeekNonSpace() != static_cast<unsigned char>(c))
+				return false;
+			++cur;
+			return true;
+		}
+
+		bool ConsumeLiteral(std::string_view literal) {
+			for (char c : literal) {
+				if (Peek() != static_cast<unsigned char>(c))
+					return false;
+				++cur;
+			}
+			return true;
+		}
+
+		// the characters of a number, return the length (0 if it's too long or empty)
+		std::size_t ReadNumber(char(&buffer)[64]) {
+			std::size_t n = 0;
+			for (;;) {
+				const int c = Peek();
+				if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+					return n;
+				if (n == std::size(buffer))
+					return 0;
+				buffer[n++] = static_cast<char>(c);
+				++cur;
+			}
+		}
+
+		// the rest of a string (after the opening quote), appended to out
+		bool ReadString(std::string& out) {
+			for (;;) {
+				if (cur == end && !Refill())
+					return false;
+				const char* run = cur;
+				while (cur != end && *cur != '"' && *cur != '\\' && static_cast<unsigned char>(*cur) >= 0x20)
+					++cur;
+				out.append(run, cur);
+				if (cur == end)
+					continue;
+				const char c = *cur++;
+				if (c == '"')
+					return true;
+				if (c != '\\') // control character
+					return false;
+				const int e = Peek();
+				if (e < 0)
+					return false;
+				++cur;
+				switch (e)
+				{
+				case '"':  out += '"';  break;
+				case '\\': out += '\\'; break;
+				case '/':  out += '/';  break;
+				case 'b':  out += '\b'; break;
+				case 'f':  out += '\f'; break;
+				case 'n':  out += '\n'; break;
+				case 'r':  out += '\r'; break;
+				case 't':  out += '\t'; break;
+				case 'u':
+					if (!ReadUnicode(out))
+						return false;
+					break;
+				default:
+					return false;
+				}
+			}
+		}
+
+		// the NameID of an object member's key
+		bool ReadKey(NameID& id) {
+			if (!Consume('"'))
+				return false;
+			// fast path : hash the key in the chunk
+			const char* last = std::find_if(cur, end, [](char c) { return c == '"' || c == '\\'; });
+			if (last != end && *last == '"') {
+				id = NameID{ std::string_view{ cur, static_cast<std::size_t>(last - cur) } };
+				cur = last + 1;
+				return true;
+			}
+			scratch.clear();
+			if (!ReadString(scratch))
+				return false;
+			id = NameID{ std::string_view{ scratch } };
+			return true;
+		}
+
+		bool SkipValue(std::size_t depth) {
+			if (depth > JsonMaxDepth)
+				return false;
+			switch (PeekNonSpace())
+			{
+			case '{':
+				++cur;
+				if (Consume('}'))
+					return true;
+				for (;;) {
+					NameID id;
+					if (!ReadKey(id) || !Consume(':') || !SkipValue(depth + 1))
+						return false;
+					if (Consume(','))
+						continue;
+					return Consume('}');
+				}
+			case '[':
+				++cur;
+				if (Consume(']'))
+					return true;
+				for (;;) {
+					if (!SkipValue(depth + 1))
+						return false;
+					if (Consume(','))
+						continue;
+					return Consume(']');
+				}
+			case '"':
+				++cur;
+				scratch.clear();
+				return ReadString(scratch);
+			case 't':
+				return ConsumeLiteral("true");
+			case 'f':
+				return ConsumeLiteral("false");
+			case 'n':
+				return ConsumeLiteral("null");
+			default:
+			{
+				char buffer[64];
+				const std::size_t n = ReadNumber(buffer);
+				double value;
+				return n > 0 && JsonFromChars(buffer, buffer + n, value);
+			}
+			}
+		}
+
+	private:
+		bool Refill() {
+			const std::size_t n = source.Read(chunk, JsonChunkSize);
+			cur = chunk;
+			end = chunk + n;
+			return n > 0;
+		}
+
+		bool ReadHex4(std::uint32_t& value) {
+			value = 0;
+			for (int i = 0; i < 4; i++) {
+				const int c = Peek();
+				std::uint32_t digit;
+				if (c >= '0' && c <= '9')
+					digit = static_cast<std::uint32_t>(c - '0');
+				else if (c >= 'a' && c <= 'f')
+					digit = static_cast<std::uint32_t>(c - 'a' + 10);
+				else if (c >= 'A' && c <= 'F')
+					digit = static_cast<std::uint32_t>(c - 'A' + 10);
+				else
+					return false;
+				++cur;
+				value = (value << 4) | digit;
+			}
+			return true;
+		}
+
+		// \uXXXX (after 'u'), a surrogate pair is combined, encoded in UTF-8
+		bool ReadUnicode(std::string& out) {
+			std::uint32_t cp;
+			if (!ReadHex4(cp))
+				return false;
+			if (cp >= 0xD800 && cp <= 0xDBFF) {
+				std::uint32_t low;
+				if (!ConsumeLiteral("\\u") || !ReadHex4(low) || low < 0xDC00 || low > 0xDFFF)
+					return false;
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+			}
+			else if (cp >= 0xDC00 && cp <= 0xDFFF)
+				return false;
+
+			if (cp < 0x80)
+				out += static_cast<char>(cp);
+			else if (cp < 0x800) {
+				out += static_cast<char>(0xC0 | (cp >> 6));
+				out += static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else if (cp < 0x10000) {
+				out += static_cast<char>(0xE0 | (cp >> 12));
+				out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				out += static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else {
+				out += static_cast<char>(0xF0 | (cp >> 18));
+				out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+				out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				out += static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			return true;
+		}
+
+		JsonSource& source;
+		const char* cur{ nullptr };
+		const char* end{ nullptr };
+		std::string scratch; // keys across chunks, skipped strings
+		char chunk[JsonChunkSize];
+	};
+
+	template<typename T>
+	static bool JsonReadInteger(JsonReader& reader, void* obj) {
+		using Wide = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+		char buffer[64];
+		const std::size_t n = reader.ReadNumber(buffer);
+		Wide value;
+		if (n == 0 || !JsonFromChars(buffer, buffer + n, value))
+			return false;
+		if (value < static_cast<Wide>(std::numeric_limits<T>::min()) || value > static_cast<Wide>(std::numeric_limits<T>::max()))
+			return false;
+		const auto narrow = static_cast<T>(value);
+		std::memcpy(obj, &narrow, sizeof(T));
+		return true;
+	}
+
+	template<typename T>
+	static bool JsonReadFloat(JsonReader& reader, void* obj) {
+		T value;
+		if (reader.PeekNonSpace() == 'n') {
+			if (!reader.ConsumeLiteral("null"))
+				return false;
+			value = std::numeric_limits<T>::quiet_NaN();
+		}
+		else {
+			char buffer[64];
+			const std::size_t n = reader.ReadNumber(buffer);
+			if (n == 0 || !JsonFromChars(buffer, buffer + n, value))
+				return false;
+		}
+		std::memcpy(obj, &value, sizeof(T));
+		return true;
+	}
+
+	static bool JsonReadValue(JsonReader& reader, const JsonPlan& plan, void* obj, std::size_t depth) {
+		if (!plan.Valid() || depth > JsonMaxDepth)
+			return false;
+
+		switch (plan.kind)
+		{
+		case JsonKind::Bool:
+		{
+			const int c = reader.PeekNonSpace();
+			if (c == 't' && reader.ConsumeLiteral("true"))
+				*static_cast<bool*>(obj) = true;
+			else if (c == 'f' && reader.ConsumeLiteral("false"))
+				*static_cast<bool*>(obj) = false;
+			else
+				return false;
+			return true;
+		}
+		case JsonKind::Int:
+			reader.PeekNonSpace();
+			switch (plan.size)
+			{
+			case 1: return JsonReadInteger<std::int8_t >(reader, obj);
+			case 2: return JsonReadInteger<std::int16_t>(reader, obj);
+			case 4: return JsonReadInteger<std::int32_t>(reader, obj);
+			case 8: return JsonReadInteger<std::int64_t>(reader, obj);
+			default: return false;
+			}
+		case JsonKind::UInt:
+			reader.PeekNonSpace();
+			switch (plan.size)
+			{
+			case 1: return JsonReadInteger<std::uint8_t >(reader, obj);
+			case 2: return JsonReadInteger<std::uint16_t>(reader, obj);
+			case 4: return JsonReadInteger<std::uint32_t>(reader, obj);
+			case 8: return JsonReadInteger<std::uint64_t>(reader, obj);
+			default: return false;
+			}
+		case JsonKind::Float:
+			return JsonReadFloat<float>(reader, obj);
+		case JsonKind::Double:
+			return JsonReadFloat<double>(reader, obj);
+		case JsonKind::String:
+		{
+			if (!reader.Consume('"'))
+				return false;
+			auto& str = *static_cast<std::string*>(obj);
+			str.clear();
+			return reader.ReadString(str);
+		}
+		case JsonKind::Array:
+		{
+			if (!reader.Consume('['))
+				return false;
+			ContainerFiller filler{ plan.vtable, plan.element_type, obj };
+			if (!filler.Begin())
+				return false;
+			if (reader.Consume(']'))
+				return filler.End();
+			for (;;) {
+				void* element = filler.Next();
+				if (!element || !JsonReadValue(reader, *plan.element_plan, element, depth + 1) || !filler.Commit())
+					return false;
+				if (reader.Consume(','))
+					continue;
+				return reader.Consume(']') && filler.End();
+			}
+		}
+		case JsonKind::Object:
+			if (!reader.Consume('{'))
+				return false;
+			if (reader.Consume('}'))
+				return true;
+			for (;;) {
+				NameID id;
+				if (!reader.ReadKey(id) || !reader.Consume(':'))
+					return false;
+				if (const JsonField* field = plan.FindField(id)) {
+					if (!JsonReadValue(reader, *field->plan, forward_offset(obj, field->offset), depth + 1))
+						return false;
+				}
+				else if (!reader.SkipValue(depth + 1))
+					return false;
+				if (reader.Consume(','))
+					continue;
+				return reader.Consume('}');
+			}
+		default:
+			assert(false);
+			return false;
+		}
+	}
+}
+
+bool Ubpa::UDRefl::ext::IsJsonSerializable(Type type) {
+	const JsonPlan* plan = GetJsonPlan(type);
+	return plan && plan->Valid();
+}
+
+bool Ubpa::UDRefl::ext::JsonWrite(ObjectView obj, JsonSink& sink) {
+	if (!obj.GetPtr())
+		return false;
+	const JsonPlan* plan = GetJsonPlan(obj.GetType());
+	if (!plan || !plan->Valid())
+		return false;
+	JsonWriter writer{ sink };
+	return JsonWriteValue(writer, *plan, obj.GetPtr()) && writer.Flush();
+}
+
+bool Ubpa::UDRefl::ext::JsonRead(ObjectView obj, JsonSource& source) {
+	if (!obj.GetPtr() || obj.GetType().RemoveReference().IsConst())
+		return false;
+	const JsonPlan* plan = GetJsonPlan(obj.GetType());
+	if (!plan || !plan->Valid())
+		return false;
+	JsonReader reader{ source };
+	return JsonReadValue(reader, *plan, obj.GetPtr(), 0);
+}
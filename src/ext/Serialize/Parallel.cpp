@@ -0,0 +1,219 @@
+#include "SerializePlan.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	static constexpr std::size_t ParallelMaxChunks = 256;
+	static constexpr std::size_t ParallelMinChunkLength = 1024;
+
+	struct ChunkIndex {
+		std::uint64_t count;
+		std::uint64_t size;
+	};
+
+	// run func(task) -> bool for tasks [0, num_tasks) on num_threads threads (include the caller),
+	// tasks are taken one by one, stop at the first failure
+	template<typename Func>
+	static bool ParallelFor(std::size_t num_tasks, std::size_t num_threads, Func&& func) {
+		if (num_threads == 0)
+			num_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		num_threads = std::min(num_threads, num_tasks);
+
+		std::atomic_size_t next{ 0 };
+		std::atomic_bool failed{ false };
+		auto worker = [&]() {
+			while (!failed.load(std::memory_order_relaxed)) {
+				const std::size_t task = next.fetch_add(1, std::memory_order_relaxed);
+				if (task >= num_tasks)
+					break;
+				if (!func(task))
+					failed.store(true, std::memory_order_relaxed);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		if (num_threads > 1) {
+			threads.reserve(num_threads - 1);
+			for (std::size_t i = 1; i < num_threads; i++)
+				threads.emplace_back(worker);
+		}
+		worker();
+		for (auto& thread : threads)
+			thread.join();
+		return !failed.load();
+	}
+
+	class ParallelContainer {
+	public:
+		// obj : a contiguous container, the elements are serializable
+		explicit ParallelContainer(ObjectView obj) {
+			if (!obj.GetPtr())
+				return;
+			const TypeInfo* info = Mngr.GetTypeInfo(obj.GetType().RemoveCVRef());
+			if (!info)
+				return;
+			const ContainerVTable* container_vtable = info->container_vtable;
+			if (!container_vtable || !container_vtable->data || !container_vtable->size || !container_vtable->element_type)
+				return;
+			const SerializePlan* plan = GetSerializePlan(container_vtable->element_type.RemoveConst());
+			if (!plan || !plan->Valid())
+				return;
+			vtable = container_vtable;
+			element_plan = plan;
+			container = obj.GetPtr();
+		}
+
+		bool Valid() const noexcept { return element_plan != nullptr; }
+
+		std::size_t Size() const { return vtable->size(container); }
+
+		void* Element(std::size_t i) const { return forward_offset(vtable->data(container), i * vtable->element_size); }
+
+		// the index of ParallelBinaryWrite
+		bool GetChunks(std::size_t num_threads, std::vector<ChunkIndex>& chunks) const {
+			const std::size_t count = Size();
+			const std::size_t length = std::max(ParallelMinChunkLength, (count + ParallelMaxChunks - 1) / ParallelMaxChunks);
+			chunks.resize((count + length - 1) / length);
+			for (std::size_t i = 0; i < chunks.size(); i++) {
+				chunks[i].count = std::min(length, count - i * length);
+				chunks[i].size = chunks[i].count * element_plan->min_binary_size;
+			}
+			if (element_plan->fixed)
+				return true;
+
+			return ParallelFor(chunks.size(), num_threads, [&](std::size_t i) {
+				std::uint64_t size = 0;
+				const std::size_t begin = i * length;
+				for (std::size_t j = begin; j < begin + chunks[i].count; j++) {
+					const std::size_t element_size = BinarySizeOf(*element_plan, Element(j));
+					if (element_size == SerializeError)
+						return false;
+					size += element_size;
+				}
+				chunks[i].size = size;
+				return true;
+			});
+		}
+
+		const ContainerVTable* vtable{ nullptr };
+		const SerializePlan* element_plan{ nullptr };
+		void* container{ nullptr };
+	};
+
+	static std::size_t ParallelHeaderSize(std::size_t num_chunks) noexcept {
+		return 2 * sizeof(std::uint64_t) + num_chunks * sizeof(ChunkIndex);
+	}
+}
+
+std::size_t Ubpa::UDRefl::ext::ParallelBinarySize(ObjectView obj, std::size_t num_threads) {
+	const ParallelContainer container{ obj };
+	std::vector<ChunkIndex> chunks;
+	if (!container.Valid() || !container.GetChunks(num_threads, chunks))
+		return SerializeError;
+	std::size_t rst = ParallelHeaderSize(chunks.size());
+	for (const auto& chunk : chunks)
+		rst += static_cast<std::size_t>(chunk.size);
+	return rst;
+}
+
+std::size_t Ubpa::UDRefl::ext::ParallelBinaryWrite(ObjectView obj, std::span<std::byte> buffer, std::size_t num_threads) {
+	const ParallelContainer container{ obj };
+	std::vector<ChunkIndex> chunks;
+	if (!container.Valid() || !container.GetChunks(num_threads, chunks))
+		return SerializeError;
+
+	// offsets of chunks
+	std::vector<std::size_t> offsets(chunks.size() + 1);
+	offsets[0] = ParallelHeaderSize(chunks.size());
+	for (std::size_t i = 0; i < chunks.size(); i++)
+		offsets[i + 1] = offsets[i] + static_cast<std::size_t>(chunks[i].size);
+	if (buffer.size() < offsets.back())
+		return SerializeError;
+
+	const std::uint64_t header[2] = { container.Size(), chunks.size() };
+	std::memcpy(buffer.data(), header, sizeof(header));
+	if (!chunks.empty())
+		std::memcpy(buffer.data() + sizeof(header), chunks.data(), chunks.size() * sizeof(ChunkIndex));
+
+	const SerializePlan& element_plan = *container.element_plan;
+	const std::size_t length = chunks.empty() ? 0 : static_cast<std::size_t>(chunks.front().count);
+	bool success = ParallelFor(chunks.size(), num_threads, [&](std::size_t i) {
+		BinaryWriter writer{ buffer.data() + offsets[i], buffer.data() + offsets[i + 1] };
+		const std::size_t begin = i * length;
+		const auto count = static_cast<std::size_t>(chunks[i].count);
+		if (element_plan.IsBytes())
+			return writer.Write(container.Element(begin), count * element_plan.size);
+		for (std::size_t j = begin; j < begin + count; j++) {
+			if (!BinaryWritePlan(element_plan, container.Element(j), writer))
+				return false;
+		}
+		return writer.cur == writer.end;
+	});
+	return success ? offsets.back() : SerializeError;
+}
+
+std::size_t Ubpa::UDRefl::ext::ParallelBinaryRead(ObjectView obj, std::span<const std::byte> buffer, std::size_t num_threads) {
+	if (obj.GetType().RemoveReference().IsConst())
+		return SerializeError;
+	const ParallelContainer container{ obj };
+	if (!container.Valid())
+		return SerializeError;
+
+	BinaryReader reader{ buffer.data(), buffer.data() + buffer.size() };
+	std::uint64_t header[2];
+	if (!reader.Read(header, sizeof(header)))
+		return SerializeError;
+	const auto [count, num_chunks] = header;
+	if (num_chunks > reader.Remain() / sizeof(ChunkIndex))
+		return SerializeError;
+	std::vector<ChunkIndex> chunks(static_cast<std::size_t>(num_chunks));
+	if (!reader.Read(chunks.data(), chunks.size() * sizeof(ChunkIndex)))
+		return SerializeError;
+
+	// check the index before resizing
+	const SerializePlan& element_plan = *container.element_plan;
+	const std::size_t min_size = std::max<std::size_t>(element_plan.min_binary_size, 1);
+	std::vector<std::size_t> begins(chunks.size());  // first elements
+	std::vector<std::size_t> offsets(chunks.size() + 1);
+	offsets[0] = static_cast<std::size_t>(reader.cur - buffer.data());
+	std::uint64_t total = 0;
+	for (std::size_t i = 0; i < chunks.size(); i++) {
+		const auto& chunk = chunks[i];
+		if (chunk.size > buffer.size() - offsets[i] || chunk.count > chunk.size / min_size
+			|| (element_plan.fixed && chunk.size != chunk.count * element_plan.min_binary_size))
+		{
+			return SerializeError;
+		}
+		begins[i] = static_cast<std::size_t>(total);
+		total += chunk.count;
+		offsets[i + 1] = offsets[i] + static_cast<std::size_t>(chunk.size);
+	}
+	if (total != count)
+		return SerializeError;
+
+	const auto n = static_cast<std::size_t>(count);
+	if (container.vtable->resize)
+		container.vtable->resize(container.container, n);
+	else if (container.vtable->clear || container.Size() != n) // fixed size containers (e.g. std::array) are read in place
+		return SerializeError;
+
+	bool success = ParallelFor(chunks.size(), num_threads, [&](std::size_t i) {
+		BinaryReader chunk_reader{ buffer.data() + offsets[i], buffer.data() + offsets[i + 1] };
+		const auto chunk_count = static_cast<std::size_t>(chunks[i].count);
+		if (element_plan.IsBytes())
+			return chunk_reader.Read(container.Element(begins[i]), chunk_count * element_plan.size);
+		for (std::size_t j = begins[i]; j < begins[i] + chunk_count; j++) {
+			if (!BinaryReadPlan(element_plan, container.Element(j), chunk_reader))
+				return false;
+		}
+		return chunk_reader.cur == chunk_reader.end;
+	});
+	return success ? offsets.back() : SerializeError;
+}
@@ -0,0 +1,187 @@
+#include "SerializePlan.hpp"
+
+#include <algorithm>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	bool GetLayoutMembers(const TypeInfo& info, std::vector<LayoutMember>& members) {
+		// offsets are computed by the casts / field pointers on a fake address, it's never dereferenced
+		void* const fake = reinterpret_cast<void*>(std::uintptr_t{ 1 } << 16);
+		for (const auto& [base, baseinfo] : info.baseinfos) {
+			if (baseinfo.IsVirtual())
+				return false;
+			const auto base_offset = static_cast<std::size_t>(
+				static_cast<std::byte*>(baseinfo.StaticCast_DerivedToBase(fake)) - static_cast<std::byte*>(fake));
+			members.push_back({ base_offset, base, {} });
+		}
+		for (const auto& [name, fieldinfo] : info.fieldinfos) {
+			switch (fieldinfo.fieldptr.GetFieldFlag())
+			{
+			case FieldFlag::Basic:
+			{
+				const auto field_offset = static_cast<std::size_t>(
+					static_cast<std::byte*>(fieldinfo.fieldptr.Var(fake).GetPtr()) - static_cast<std::byte*>(fake));
+				members.push_back({ field_offset, fieldinfo.fieldptr.GetType(), name });
+				break;
+			}
+			case FieldFlag::Virtual:
+				return false;
+			default: // static / dynamic fields aren't parts of the object
+				break;
+			}
+		}
+		std::stable_sort(members.begin(), members.end(),
+			[](const LayoutMember& lhs, const LayoutMember& rhs) { return lhs.offset < rhs.offset; });
+		return true;
+	}
+
+	static void AppendCopy(std::vector<SerializeOp>& ops, std::size_t offset, std::size_t size) {
+		if (size == 0)
+			return;
+		// merge adjacent runs
+		if (!ops.empty() && ops.back().kind == SerializeOpKind::Copy && ops.back().offset + ops.back().size == offset)
+			ops.back().size += size;
+		else
+			ops.push_back({
+				.kind = SerializeOpKind::Copy,
+				.offset = offset,
+				.size = size,
+				.vtable = nullptr,
+				.element_type = {},
+				.element_plan = nullptr
+			});
+	}
+
+	// flatten the layout of type at offset into ops
+	static bool AppendOps(PlanCache<SerializePlan>& cache, const TypeInfo& info, std::size_t offset, std::vector<SerializeOp>& ops) {
+		std::vector<LayoutMember> members;
+		if (!GetLayoutMembers(info, members))
+			return false;
+
+		if (!members.empty()) {
+			for (const auto& member : members) {
+				// process addresses aren't data
+				if (member.type.IsReference() || member.type.RemoveConst().IsPointer())
+					return false;
+				const TypeInfo* member_info = Mngr.GetTypeInfo(member.type.RemoveConst());
+				if (!member_info || !AppendOps(cache, *member_info, offset + member.offset, ops))
+					return false;
+			}
+			return true;
+		}
+
+		if (info.is_trivial) {
+			AppendCopy(ops, offset, info.size);
+			return true;
+		}
+
+		if (const ContainerVTable* vtable = info.container_vtable;
+			vtable && vtable->element_type && vtable->size && (vtable->data || vtable->for_each))
+		{
+			const Type element_type = vtable->element_type.RemoveConst();
+			const SerializePlan* element_plan = cache.GetLocked(element_type);
+			if (!element_plan || element_plan->state == SerializePlanState::Invalid)
+				return false;
+			ops.push_back({
+				.kind = SerializeOpKind::Container,
+				.offset = offset,
+				.size = info.size,
+				.vtable = vtable,
+				.element_type = element_type,
+				.element_plan = element_plan
+			});
+			return true;
+		}
+
+		return false;
+	}
+
+	static bool CompileSerializePlan(PlanCache<SerializePlan>& cache, Type type, const TypeInfo& info, SerializePlan& plan) {
+		if (type.IsPointer())
+			return false;
+		plan.size = info.size;
+		plan.trivial = info.is_trivial;
+		if (!AppendOps(cache, info, 0, plan.ops))
+			return false;
+		for (const auto& op : plan.ops) {
+			if (op.kind == SerializeOpKind::Copy)
+				plan.min_binary_size += op.size;
+			else {
+				plan.min_binary_size += sizeof(std::uint64_t);
+				plan.fixed = false;
+			}
+		}
+		return true;
+	}
+
+	const SerializePlan* GetSerializePlan(Type type) {
+		static PlanCache<SerializePlan> cache{ &CompileSerializePlan };
+		return cache.Get(type);
+	}
+
+	ContainerFiller::~ContainerFiller() {
+		if (temporary.GetPtr())
+			Mngr.MDelete(temporary, Mngr.GetTemporaryResource());
+	}
+
+	bool ContainerFiller::Begin() {
+		if (!vtable->clear)
+			return vtable->data && vtable->size;
+		if (!vtable->emplace_back && !vtable->append)
+			return false;
+		vtable->clear(container);
+		return true;
+	}
+
+	void* ContainerFiller::Next() {
+		if (!vtable->clear) {
+			if (count >= vtable->size(container))
+				return nullptr;
+			return forward_offset(vtable->data(container), count * vtable->element_size);
+		}
+		if (vtable->emplace_back)
+			return vtable->emplace_back(container);
+		// a fresh element each time like emplace_back, missing fields mustn't come from the previous (moved) one
+		std::pmr::memory_resource* rsrc = Mngr.GetTemporaryResource();
+		if (temporary.GetPtr())
+			Mngr.MDelete(temporary, rsrc);
+		temporary = Mngr.MNew(element_type, rsrc);
+		return temporary.GetPtr();
+	}
+
+	bool ContainerFiller::Commit() {
+		++count;
+		if (vtable->clear && !vtable->emplace_back)
+			return vtable->append(container, temporary.GetPtr(), 1, true);
+		return true;
+	}
+
+	bool ContainerFiller::End() {
+		return vtable->clear || count == vtable->size(container);
+	}
+}
+
+SerializePlanInfo Ubpa::UDRefl::ext::GetSerializePlanInfo(Type type) {
+	const auto* plan = GetSerializePlan(type);
+	if (!plan || !plan->Valid())
+		return {};
+
+	SerializePlanInfo rst;
+	rst.valid = true;
+	for (const auto& op : plan->ops) {
+		if (op.kind == SerializeOpKind::Copy)
+			++rst.num_memcpy;
+		else
+			++rst.num_container;
+	}
+	return rst;
+}
+
+bool Ubpa::UDRefl::ext::IsSerializable(Type type) {
+	const auto* plan = GetSerializePlan(type);
+	return plan && plan->Valid();
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <UDRefl_ext/Serialize.hpp>
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Ubpa::UDRefl::ext::details {
+	enum class SerializePlanState : std::uint8_t {
+		Compiling, // recursive types (e.g. a tree node with std::vector<Node>)
+		Valid,
+		Invalid
+	};
+
+	// plans of a format, compiled on the first use of types (thread-safe), addresses are stable
+	// - Plan : has a member SerializePlanState state
+	// - compiler(cache, type, info, plan) : return false if the type is unsupported,
+	//   nested plans are got by cache.GetLocked (the plan of a recursive type is still Compiling)
+	template<typename Plan>
+	class PlanCache {
+	public:
+		using Compiler = bool(*)(PlanCache& cache, Type type, const TypeInfo& info, Plan& plan);
+
+		explicit PlanCache(Compiler compiler) noexcept : compiler{ compiler } {}
+
+		// nullptr if type isn't registered
+		const Plan* Get(Type type) {
+			type = type.RemoveCVRef();
+			{
+				std::shared_lock lock{ mutex };
+				auto target = plans.find(type.GetID());
+				if (target != plans.end())
+					return target->second.get();
+			}
+			std::unique_lock lock{ mutex };
+			return GetLocked(type);
+		}
+
+		// call it in the compiler only
+		const Plan* GetLocked(Type type) {
+			type = type.RemoveCVRef();
+			auto target = plans.find(type.GetID());
+			if (target != plans.end())
+				return target->second.get();
+
+			const TypeInfo* info = Mngr.GetTypeInfo(type);
+			if (!info)
+				return nullptr;
+
+			// insert it before compiling, so recursive types find the placeholder
+			Plan* plan = plans.emplace(type.GetID(), std::make_unique<Plan>()).first->second.get();
+			if (compiler(*this, type, *info, *plan))
+				plan->state = SerializePlanState::Valid;
+			else {
+				*plan = Plan{};
+				plan->state = SerializePlanState::Invalid;
+			}
+			return plan;
+		}
+
+	private:
+		Compiler compiler;
+		std::shared_mutex mutex;
+		std::unordered_map<TypeID, std::unique_ptr<Plan>> plans;
+	};
+
+	struct LayoutMember {
+		std::size_t offset;
+		Type type;
+		Name name; // invalid for bases
+	};
+
+	// the basic fields and the non-virtual bases of a type (not recursive), sorted by offset
+	// return false if the type has virtual bases or virtual fields
+	bool GetLayoutMembers(const TypeInfo& info, std::vector<LayoutMember>& members);
+
+	// visit the fields of members at offset, the fields of bases are flattened
+	// - a base without fields (e.g. a trivial struct, a container) is a nested value named by its type,
+	//   so it isn't dropped, empty bases are skipped
+	// - func(Name name, Type type, std::size_t offset) -> bool, type is without const
+	// return false if a base has virtual bases / fields, a field is a reference, or func fails
+	template<typename Func>
+	bool ForEachLayoutField(const std::vector<LayoutMember>& members, std::size_t offset, Func&& func) {
+		for (const auto& member : members) {
+			if (member.name) {
+				if (member.type.IsReference() || !func(member.name, member.type.RemoveConst(), offset + member.offset))
+					return false;
+				continue;
+			}
+			const TypeInfo* base_info = Mngr.GetTypeInfo(member.type);
+			std::vector<LayoutMember> base_members;
+			if (!base_info || !GetLayoutMembers(*base_info, base_members))
+				return false;
+			if (!base_members.empty()) {
+				if (!ForEachLayoutField(base_members, offset + member.offset, func))
+					return false;
+			}
+			else if (base_info->size != 0) {
+				if (!func(Name{ member.type.GetName() }, member.type, offset + member.offset))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// cursors of the binary formats, bounds-checked
+	struct BinaryWriter {
+		std::byte* cur;
+		std::byte* end;
+
+		bool Write(const void* src, std::size_t n) noexcept {
+			if (static_cast<std::size_t>(end - cur) < n)
+				return false;
+			if (n > 0)
+				std::memcpy(cur, src, n);
+			cur += n;
+			return true;
+		}
+	};
+
+	struct BinaryReader {
+		const std::byte* cur;
+		const std::byte* end;
+
+		std::size_t Remain() const noexcept { return static_cast<std::size_t>(end - cur); }
+
+		bool Read(void* dst, std::size_t n) noexcept {
+			if (Remain() < n)
+				return false;
+			if (n > 0)
+				std::memcpy(dst, cur, n);
+			cur += n;
+			return true;
+		}
+	};
+
+	// func(void* element) -> bool, stop at the first failure
+	template<typename Func>
+	bool ForEachElement(const ContainerVTable* vtable, void* container, Func&& func) {
+		if (vtable->data) {
+			auto* data = static_cast<std::byte*>(vtable->data(container));
+			const std::size_t count = vtable->size(container);
+			for (std::size_t i = 0; i < count; i++) {
+				if (!func(data + i * vtable->element_size))
+					return false;
+			}
+			return true;
+		}
+
+		struct Context {
+			Func& func;
+			bool ok;
+		} ctx{ func, true };
+		vtable->for_each(
+			container,
+			[](void* element, void* ctx) {
+				auto& context = *static_cast<Context*>(ctx);
+				if (context.ok)
+					context.ok = context.func(element);
+			},
+			&ctx
+		);
+		return ctx.ok;
+	}
+
+	// binary format (see BinaryWrite)
+
+	struct SerializePlan;
+
+	enum class SerializeOpKind : std::uint8_t {
+		Copy,     // memcpy [offset, offset + size)
+		Container // std::uint64_t count + elements (element_plan)
+	};
+
+	struct SerializeOp {
+		SerializeOpKind kind;
+		std::size_t offset;
+		std::size_t size{ 0 };
+		const ContainerVTable* vtable{ nullptr };
+		Type element_type; // without const
+		const SerializePlan* element_plan{ nullptr };
+	};
+
+	struct SerializePlan {
+		SerializePlanState state{ SerializePlanState::Compiling };
+		std::size_t size{ 0 }; // the size of the type
+		bool trivial{ false }; // elements can be memcpy-ed into containers (see ContainerVTable::append)
+		std::vector<SerializeOp> ops;
+		std::size_t min_binary_size{ 0 }; // copied bytes + count of containers
+		bool fixed{ true }; // no container, the binary size is min_binary_size
+
+		bool Valid() const noexcept { return state == SerializePlanState::Valid; }
+
+		// the binary is the object's raw bytes
+		bool IsBytes() const noexcept {
+			return ops.size() == 1 && ops.front().kind == SerializeOpKind::Copy
+				&& ops.front().offset == 0 && ops.front().size == size;
+		}
+	};
+
+	const SerializePlan* GetSerializePlan(Type type);
+
+	// binary format walkers (see Binary.cpp)
+	std::size_t BinarySizeOf(const SerializePlan& plan, void* obj);
+	bool BinaryWritePlan(const SerializePlan& plan, const void* obj, BinaryWriter& writer);
+	bool BinaryReadPlan(const SerializePlan& plan, void* obj, BinaryReader& reader);
+
+	// fill a container element by element, the count is unknown beforehand
+	// - resizable containers : clear, then emplace_back, or read into a temporary element and append (move) it
+	// - fixed size contiguous containers (e.g. std::array) : overwrite in place, the count must be the size
+	class ContainerFiller {
+	public:
+		ContainerFiller(const ContainerVTable* vtable, Type element_type, void* container) noexcept :
+			vtable{ vtable }, element_type{ element_type }, container{ container } {}
+		ContainerFiller(const ContainerFiller&) = delete;
+		ContainerFiller& operator=(const ContainerFiller&) = delete;
+		~ContainerFiller();
+
+		// false if the container can't be filled
+		bool Begin();
+		// the element to read into, nullptr on failure
+		void* Next();
+		// call it after the element of Next() is read
+		bool Commit();
+		// false if the count doesn't match the fixed size
+		bool End();
+
+	private:
+		const ContainerVTable* vtable;
+		Type element_type; // without const
+		void* container;
+		std::size_t count{ 0 };
+		ObjectView temporary;
+	};
+}
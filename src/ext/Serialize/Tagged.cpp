@@ -0,0 +1,501 @@
+#include "SerializePlan.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+using namespace Ubpa::UDRefl::ext;
+using namespace Ubpa::UDRefl::ext::details;
+
+namespace Ubpa::UDRefl::ext::details {
+	struct TaggedPlan;
+
+	enum class TaggedKind : std::uint8_t {
+		Bytes,
+		Object,
+		Container
+	};
+
+	struct TaggedField {
+		NameID id;
+		std::size_t offset;
+		Type type; // without const
+		const TaggedPlan* plan;
+	};
+
+	struct TaggedPlan {
+		SerializePlanState state{ SerializePlanState::Compiling };
+		TaggedKind kind{ TaggedKind::Bytes };
+		std::size_t size{ 0 }; // the size of the type
+		bool trivial{ false };
+		bool default_constructible{ false };
+
+		// Container
+		const ContainerVTable* vtable{ nullptr };
+		Type element_type; // without const
+		const TaggedPlan* element_plan{ nullptr };
+
+		// Object
+		std::vector<TaggedField> fields; // in the order of offsets
+		// open addressing (linear probing) NameID -> index of fields + 1, 0 is empty, the size is a power of 2
+		std::vector<std::uint32_t> slots;
+
+		bool Valid() const noexcept { return state == SerializePlanState::Valid; }
+
+		const TaggedField* Find(NameID id) const noexcept {
+			const std::size_t mask = slots.size() - 1;
+			for (std::size_t i = id.GetValue() & mask; ; i = (i + 1) & mask) {
+				const std::uint32_t slot = slots[i];
+				if (slot == 0)
+					return nullptr;
+				if (fields[slot - 1].id == id)
+					return &fields[slot - 1];
+			}
+		}
+
+		// the least bytes of a value, to reject corrupted counts
+		std::size_t MinSize() const noexcept {
+			switch (kind)
+			{
+			case TaggedKind::Bytes:
+				return size;
+			case TaggedKind::Object:
+				return sizeof(std::uint32_t);
+			default:
+				return sizeof(std::uint64_t);
+			}
+		}
+	};
+
+	static bool AppendTaggedFields(PlanCache<TaggedPlan>& cache, const std::vector<LayoutMember>& members,
+		std::size_t offset, std::vector<TaggedField>& fields)
+	{
+		return ForEachLayoutField(members, offset, [&](Name name, Type type, std::size_t field_offset) {
+			const TaggedPlan* plan = cache.GetLocked(type);
+			if (!plan || plan->state == SerializePlanState::Invalid)
+				return false;
+			fields.push_back({ name.GetID(), field_offset, type, plan });
+			return true;
+		});
+	}
+
+	static bool CompileTaggedPlan(PlanCache<TaggedPlan>& cache, Type type, const TypeInfo& info, TaggedPlan& plan) {
+		if (type.IsPointer()) // process addresses aren't data
+			return false;
+		plan.size = info.size;
+		plan.trivial = info.is_trivial;
+		plan.default_constructible = info.is_trivial || Mngr.IsConstructible(type);
+
+		std::vector<LayoutMember> members;
+		if (!GetLayoutMembers(info, members))
+			return false;
+
+		if (!members.empty()) {
+			plan.kind = TaggedKind::Object;
+			if (!AppendTaggedFields(cache, members, 0, plan.fields))
+				return false;
+			plan.slots.resize(std::bit_ceil(2 * plan.fields.size() + 1), 0);
+			const std::size_t mask = plan.slots.size() - 1;
+			for (std::size_t i = 0; i < plan.fields.size(); i++) {
+				// a shadowed field of a base comes first (lower offset) and keeps the slot
+				if (plan.Find(plan.fields[i].id))
+					continue;
+				std::size_t slot = plan.fields[i].id.GetValue() & mask;
+				while (plan.slots[slot] != 0)
+					slot = (slot + 1) & mask;
+				plan.slots[slot] = static_cast<std::uint32_t>(i + 1);
+			}
+			return true;
+		}
+
+		if (info.is_trivial) {
+			plan.kind = TaggedKind::Bytes;
+			return true;
+		}
+
+		if (const ContainerVTable* vtable = info.container_vtable;
+			vtable && vtable->element_type && vtable->size && (vtable->data || vtable->for_each))
+		{
+			plan.kind = TaggedKind::Container;
+			plan.vtable = vtable;
+			plan.element_type = vtable->element_type.RemoveConst();
+			plan.element_plan = cache.GetLocked(plan.element_type);
+			return plan.element_plan && plan.element_plan->state != SerializePlanState::Invalid;
+		}
+
+		return false;
+	}
+
+	static const TaggedPlan* GetTaggedPlan(Type type) {
+		static PlanCache<TaggedPlan> cache{ &CompileTaggedPlan };
+		return cache.Get(type);
+	}
+
+	//
+	// field sizes : LEB128 varints
+	/////////////////////////////////
+
+	// the sizes of Object / Container fields are patched after writing the values,
+	// they take TaggedPaddedSizeBytes (redundant 0x80 continuation bytes), so the size must be < 2^35
+	static constexpr std::size_t TaggedPaddedSizeBytes = 5;
+	static constexpr std::uint64_t TaggedMaxPaddedSize = std::uint64_t{ 1 } << (7 * TaggedPaddedSizeBytes);
+
+	static constexpr std::size_t VarintSize(std::uint64_t value) noexcept {
+		std::size_t n = 1;
+		for (; value >= 0x80; value >>= 7)
+			++n;
+		return n;
+	}
+
+	// the bytes of a field header (NameID + size), the size of Bytes fields is known by the plan
+	static std::size_t TaggedFieldHeaderSize(const TaggedPlan& field_plan) noexcept {
+		return sizeof(std::uint64_t) + (field_plan.kind == TaggedKind::Bytes ?
+			VarintSize(field_plan.size) : TaggedPaddedSizeBytes);
+	}
+
+	static bool WriteVarint(BinaryWriter& writer, std::uint64_t value) {
+		std::byte buffer[10];
+		std::size_t n = 0;
+		for (; value >= 0x80; value >>= 7)
+			buffer[n++] = static_cast<std::byte>((value & 0x7f) | 0x80);
+		buffer[n++] = static_cast<std::byte>(value);
+		return writer.Write(buffer, n);
+	}
+
+	static void PatchPaddedVarint(std::byte* pos, std::uint64_t value) noexcept {
+		assert(value < TaggedMaxPaddedSize);
+		for (std::size_t i = 0; i < TaggedPaddedSizeBytes - 1; i++, value >>= 7)
+			pos[i] = static_cast<std::byte>((value & 0x7f) | 0x80);
+		pos[TaggedPaddedSizeBytes - 1] = static_cast<std::byte>(value);
+	}
+
+	// accept redundant continuation bytes (see PatchPaddedVarint)
+	static bool ReadVarint(BinaryReader& reader, std::uint64_t& value) noexcept {
+		value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			if (reader.Remain() == 0)
+				return false;
+			const auto byte = static_cast<std::uint64_t>(*reader.cur++);
+			if (shift == 63 && (byte & 0x7e) != 0)
+				return false; // overflow
+			value |= (byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	//
+	// write
+	//////////
+
+	static std::size_t TaggedSizeOf(const TaggedPlan& plan, const void* obj) {
+		if (!plan.Valid())
+			return SerializeError;
+
+		switch (plan.kind)
+		{
+		case TaggedKind::Bytes:
+			return plan.size;
+		case TaggedKind::Object:
+		{
+			std::size_t rst = sizeof(std::uint32_t);
+			for (const auto& field : plan.fields) {
+				const std::size_t field_size = TaggedSizeOf(*field.plan, forward_offset(obj, field.offset));
+				if (field_size == SerializeError)
+					return SerializeError;
+				rst += TaggedFieldHeaderSize(*field.plan) + field_size;
+			}
+			return rst;
+		}
+		case TaggedKind::Container:
+		{
+			const TaggedPlan& element_plan = *plan.element_plan;
+			if (!element_plan.Valid())
+				return SerializeError;
+			void* container = const_cast<void*>(obj);
+			const std::size_t count = plan.vtable->size(container);
+			if (element_plan.kind == TaggedKind::Bytes)
+				return 2 * sizeof(std::uint64_t) + count * element_plan.size;
+			std::size_t rst = sizeof(std::uint64_t);
+			bool success = ForEachElement(plan.vtable, container, [&](void* element) {
+				const std::size_t element_size = TaggedSizeOf(element_plan, element);
+				if (element_size == SerializeError)
+					return false;
+				rst += element_size;
+				return true;
+			});
+			return success ? rst : SerializeError;
+		}
+		default:
+			assert(false);
+			return SerializeError;
+		}
+	}
+
+	static bool TaggedWriteValue(const TaggedPlan& plan, const void* obj, BinaryWriter& writer) {
+		if (!plan.Valid())
+			return false;
+
+		switch (plan.kind)
+		{
+		case TaggedKind::Bytes:
+			return writer.Write(obj, plan.size);
+		case TaggedKind::Object:
+		{
+			const auto count = static_cast<std::uint32_t>(plan.fields.size());
+			if (!writer.Write(&count, sizeof(std::uint32_t)))
+				return false;
+			for (const auto& field : plan.fields) {
+				const std::uint64_t id = field.id.GetValue();
+				if (!writer.Write(&id, sizeof(std::uint64_t)))
+					return false;
+				const TaggedPlan& field_plan = *field.plan;
+				if (field_plan.kind == TaggedKind::Bytes) {
+					if (!WriteVarint(writer, field_plan.size)
+						|| !writer.Write(forward_offset(obj, field.offset), field_plan.size))
+					{
+						return false;
+					}
+					continue;
+				}
+				std::byte* size_pos = writer.cur;
+				const std::byte padding[TaggedPaddedSizeBytes]{};
+				if (!writer.Write(padding, TaggedPaddedSizeBytes))
+					return false;
+				if (!TaggedWriteValue(field_plan, forward_offset(obj, field.offset), writer))
+					return false;
+				// patch the size
+				const auto size = static_cast<std::uint64_t>(writer.cur - size_pos - TaggedPaddedSizeBytes);
+				if (size >= TaggedMaxPaddedSize)
+					return false;
+				PatchPaddedVarint(size_pos, size);
+			}
+			return true;
+		}
+		case TaggedKind::Container:
+		{
+			const TaggedPlan& element_plan = *plan.element_plan;
+			if (!element_plan.Valid())
+				return false;
+			// the vtable takes non-const pointers, the container isn't modified
+			void* container = const_cast<void*>(obj);
+			const auto count = static_cast<std::uint64_t>(plan.vtable->size(container));
+			if (!writer.Write(&count, sizeof(std::uint64_t)))
+				return false;
+			if (element_plan.kind == TaggedKind::Bytes) {
+				const auto element_size = static_cast<std::uint64_t>(element_plan.size);
+				if (!writer.Write(&element_size, sizeof(std::uint64_t)))
+					return false;
+				if (plan.vtable->data)
+					return writer.Write(plan.vtable->data(container), static_cast<std::size_t>(count) * element_plan.size);
+			}
+			return ForEachElement(plan.vtable, container, [&](void* element) {
+				return TaggedWriteValue(element_plan, element, writer);
+			});
+		}
+		default:
+			assert(false);
+			return false;
+		}
+	}
+
+	//
+	// read
+	/////////
+
+	enum class TaggedResult : std::uint8_t {
+		Success,
+		Mismatch, // the value doesn't match the current type, the field is defaulted
+		Error     // corrupted
+	};
+
+	// value-initialize or default-construct a missing field
+	static bool TaggedResetField(const TaggedField& field, void* obj) {
+		const TaggedPlan& plan = *field.plan;
+		void* member = forward_offset(obj, field.offset);
+		if (plan.trivial) {
+			std::memset(member, 0, plan.size);
+			return true;
+		}
+		if (!plan.default_constructible)
+			return true; // keep it
+		const ObjectView view{ field.type, member };
+		return Mngr.Destruct(view) && Mngr.Construct(view);
+	}
+
+	static TaggedResult TaggedReadValue(const TaggedPlan& plan, void* obj, BinaryReader& reader);
+
+	static TaggedResult TaggedReadObject(const TaggedPlan& plan, void* obj, BinaryReader& reader) {
+		std::uint32_t count;
+		if (!reader.Read(&count, sizeof(std::uint32_t)))
+			return TaggedResult::Error;
+
+		// read fields, on the stack for <= 256 fields
+		const std::size_t num_words = (plan.fields.size() + 63) / 64;
+		std::uint64_t local_read[4]{};
+		std::vector<std::uint64_t> heap_read;
+		std::uint64_t* read = local_read;
+		if (num_words > std::size(local_read)) {
+			heap_read.resize(num_words, 0);
+			read = heap_read.data();
+		}
+
+		std::size_t hint = 0; // the writer usually has the same order
+		for (std::uint32_t i = 0; i < count; i++) {
+			std::uint64_t raw_id, size;
+			if (!reader.Read(&raw_id, sizeof(std::uint64_t)) || !ReadVarint(reader, size) || reader.Remain() < size)
+				return TaggedResult::Error;
+			BinaryReader value_reader{ reader.cur, reader.cur + size };
+			reader.cur += size;
+
+			const NameID id{ static_cast<std::size_t>(raw_id) };
+			const TaggedField* field = hint < plan.fields.size() && plan.fields[hint].id == id ?
+				&plan.fields[hint] : plan.Find(id);
+			if (!field)
+				continue; // unknown, skipped
+			const auto index = static_cast<std::size_t>(field - plan.fields.data());
+			hint = index + 1;
+
+			const TaggedPlan& field_plan = *field->plan;
+			if (field_plan.kind == TaggedKind::Bytes && size != field_plan.size)
+				continue; // raw size changed, defaulted below
+
+			switch (TaggedReadValue(field_plan, forward_offset(obj, field->offset), value_reader))
+			{
+			case TaggedResult::Success:
+				if (value_reader.cur != value_reader.end)
+					return TaggedResult::Error;
+				read[index / 64] |= std::uint64_t{ 1 } << (index % 64);
+				break;
+			case TaggedResult::Mismatch:
+				break; // defaulted below
+			default:
+				return TaggedResult::Error;
+			}
+		}
+
+		for (std::size_t i = 0; i < plan.fields.size(); i++) {
+			if (!(read[i / 64] & (std::uint64_t{ 1 } << (i % 64))) && !TaggedResetField(plan.fields[i], obj))
+				return TaggedResult::Error;
+		}
+		return TaggedResult::Success;
+	}
+
+	static TaggedResult TaggedReadContainer(const TaggedPlan& plan, void* container, BinaryReader& reader) {
+		const TaggedPlan& element_plan = *plan.element_plan;
+		const ContainerVTable* vtable = plan.vtable;
+		if (!element_plan.Valid())
+			return TaggedResult::Error;
+
+		std::uint64_t count;
+		if (!reader.Read(&count, sizeof(std::uint64_t)))
+			return TaggedResult::Error;
+		const bool bytes = element_plan.kind == TaggedKind::Bytes;
+		if (bytes) {
+			std::uint64_t element_size;
+			if (!reader.Read(&element_size, sizeof(std::uint64_t)))
+				return TaggedResult::Error;
+			if (element_size != element_plan.size)
+				return TaggedResult::Mismatch;
+		}
+		// reject corrupted counts before reserving
+		if (count > reader.Remain() / std::max<std::size_t>(element_plan.MinSize(), 1))
+			return TaggedResult::Error;
+		const auto n = static_cast<std::size_t>(count);
+
+		if (bytes && vtable->data) {
+			if (!vtable->clear) {
+				// fixed size (e.g. std::array)
+				if (n != vtable->size(container))
+					return TaggedResult::Mismatch;
+				return reader.Read(vtable->data(container), n * element_plan.size) ?
+					TaggedResult::Success : TaggedResult::Error;
+			}
+			if (element_plan.trivial && vtable->append) {
+				// resize + memcpy (see ContainerVTable::append)
+				vtable->clear(container);
+				if (!vtable->append(container, const_cast<std::byte*>(reader.cur), n, false))
+					return TaggedResult::Error;
+				reader.cur += n * element_plan.size;
+				return TaggedResult::Success;
+			}
+		}
+
+		ContainerFiller filler{ vtable, plan.element_type, container };
+		if (!filler.Begin())
+			return TaggedResult::Error;
+		if (!vtable->clear && n != vtable->size(container))
+			return TaggedResult::Mismatch;
+		if (vtable->reserve)
+			vtable->reserve(container, n);
+		for (std::size_t i = 0; i < n; i++) {
+			void* element = filler.Next();
+			if (!element)
+				return TaggedResult::Error;
+			const TaggedResult result = TaggedReadValue(element_plan, element, reader);
+			if (result != TaggedResult::Success)
+				return result;
+			if (!filler.Commit())
+				return TaggedResult::Error;
+		}
+		return filler.End() ? TaggedResult::Success : TaggedResult::Mismatch;
+	}
+
+	static TaggedResult TaggedReadValue(const TaggedPlan& plan, void* obj, BinaryReader& reader) {
+		if (!plan.Valid())
+			return TaggedResult::Error;
+
+		switch (plan.kind)
+		{
+		case TaggedKind::Bytes:
+			return reader.Read(obj, plan.size) ? TaggedResult::Success : TaggedResult::Error;
+		case TaggedKind::Object:
+			return TaggedReadObject(plan, obj, reader);
+		case TaggedKind::Container:
+			return TaggedReadContainer(plan, obj, reader);
+		default:
+			assert(false);
+			return TaggedResult::Error;
+		}
+	}
+}
+
+bool Ubpa::UDRefl::ext::IsTaggedSerializable(Type type) {
+	const TaggedPlan* plan = GetTaggedPlan(type);
+	return plan && plan->Valid();
+}
+
+std::size_t Ubpa::UDRefl::ext::TaggedSize(ObjectView obj) {
+	if (!obj.GetPtr())
+		return SerializeError;
+	const TaggedPlan* plan = GetTaggedPlan(obj.GetType());
+	if (!plan)
+		return SerializeError;
+	return TaggedSizeOf(*plan, obj.GetPtr());
+}
+
+std::size_t Ubpa::UDRefl::ext::TaggedWrite(ObjectView obj, std::span<std::byte> buffer) {
+	if (!obj.GetPtr())
+		return SerializeError;
+	const TaggedPlan* plan = GetTaggedPlan(obj.GetType());
+	if (!plan)
+		return SerializeError;
+	BinaryWriter writer{ buffer.data(), buffer.data() + buffer.size() };
+	if (!TaggedWriteValue(*plan, obj.GetPtr(), writer))
+		return SerializeError;
+	return static_cast<std::size_t>(writer.cur - buffer.data());
+}
+
+std::size_t Ubpa::UDRefl::ext::TaggedRead(ObjectView obj, std::span<const std::byte> buffer) {
+	if (!obj.GetPtr() || obj.GetType().RemoveReference().IsConst())
+		return SerializeError;
+	const TaggedPlan* plan = GetTaggedPlan(obj.GetType());
+	if (!plan)
+		return SerializeError;
+	BinaryReader reader{ buffer.data(), buffer.data() + buffer.size() };
+	if (TaggedReadValue(*plan, obj.GetPtr(), reader) != TaggedResult::Success)
+		return SerializeError;
+	return static_cast<std::size_t>(reader.cur - buffer.data());
+}
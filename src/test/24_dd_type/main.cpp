@@ -55,6 +55,16 @@ struct Field3 {
 	}
 };
 
+// stream operators are opt-in
+template<>
+struct Ubpa::UDRefl::AutoRegisterPolicy<Field2> {
+	static constexpr AutoRegisterFlag flags = AutoRegisterFlag::Default | AutoRegisterFlag::Stream;
+};
+template<>
+struct Ubpa::UDRefl::AutoRegisterPolicy<Field3> {
+	static constexpr AutoRegisterFlag flags = AutoRegisterFlag::Default | AutoRegisterFlag::Stream;
+};
+
 /*
 struct A : Base0, Empty, Base1 {
     Field2 f2;
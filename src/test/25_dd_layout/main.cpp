@@ -0,0 +1,62 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+/*
+struct Config {
+	bool enable;
+	double scale;
+	bool verbose;  // cold
+	double weight;
+	bool visible;
+	int count;     // cold
+};
+*/
+
+void Print(Type type, std::span<const Name> field_names) {
+	const auto& typeinfo = *Mngr.GetTypeInfo(type);
+	std::cout << type.GetName() << ": size " << typeinfo.size << ", alignment " << typeinfo.alignment << std::endl;
+
+	SharedObject obj = Mngr.MakeShared(type);
+	for (const auto& name : field_names) {
+		ObjectView var = obj.Var(name);
+		std::cout << "  " << name.GetView() << ": offset "
+			<< (static_cast<std::byte*>(var.GetPtr()) - static_cast<std::byte*>(obj.GetPtr()))
+			<< std::endl;
+	}
+}
+
+int main() {
+	Mngr.RegisterType<bool>();
+	Mngr.RegisterType<int>();
+	Mngr.RegisterType<double>();
+
+	Type field_types[] = { Type_of<bool>, Type_of<double>, Type_of<bool>, Type_of<double>, Type_of<bool>, Type_of<int> };
+	Name field_names[] = { Name{"enable"}, Name{"scale"}, Name{"verbose"}, Name{"weight"}, Name{"visible"}, Name{"count"} };
+
+	Attr cold = Mngr.MakeShared(Type_of<FieldTemperature>, TempArgsView{ FieldTemperature::Cold });
+	AttrSet field_attrs[] = { {}, {}, { cold }, {}, {}, { cold } };
+
+	Mngr.RegisterType("Config_Declared", {}, field_types, field_names, true);
+	Mngr.RegisterType("Config_AlignmentDescending", {}, field_types, field_names, {}, FieldLayoutPolicy::AlignmentDescending, 1, true);
+	Mngr.RegisterType("Config_HotCold", {}, field_types, field_names, field_attrs, FieldLayoutPolicy::HotCold, 64, true);
+
+	Print("Config_Declared", field_names);
+	Print("Config_AlignmentDescending", field_names);
+	Print("Config_HotCold", field_names);
+
+	SharedObject config = Mngr.MakeShared("Config_HotCold");
+	config.Var("scale") = 0.5;
+	config.Var("count") = 8;
+	config.Var("verbose") = true;
+
+	std::cout << "scale: " << config.Var("scale") << std::endl;
+	std::cout << "count: " << config.Var("count") << std::endl;
+	std::cout << "verbose: " << config.Var("verbose") << std::endl;
+
+	std::cout << "count is cold: " << std::boolalpha
+		<< (Mngr.GetFieldAttr("Config_HotCold", "count", Type_of<FieldTemperature>).As<FieldTemperature>() == FieldTemperature::Cold)
+		<< std::endl;
+}
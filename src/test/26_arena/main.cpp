@@ -0,0 +1,59 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Point {
+	float x;
+	float y;
+};
+
+struct Message {
+	std::string text;
+	Message() {
+		std::cout << "Message ctor" << std::endl;
+	}
+	Message(const Message& rhs) : text{ rhs.text } {
+		std::cout << "Message copy ctor" << std::endl;
+	}
+	~Message() {
+		std::cout << "Message dtor: " << text << std::endl;
+	}
+	Message Copy() const { return *this; }
+};
+
+int main() {
+	Mngr.RegisterType<Point>();
+	Mngr.AddField<&Point::x>("x");
+	Mngr.AddField<&Point::y>("y");
+
+	Mngr.RegisterType<Message>();
+	Mngr.AddField<&Message::text>("text");
+	Mngr.AddMethod<&Message::Copy>("Copy");
+
+	{
+		ScopedObjectArena arena;
+
+		for (int i = 0; i < 4; i++) {
+			SharedObject p = Mngr.MMakeShared(Type_of<Point>, &arena);
+			p.Var("x") = static_cast<float>(i);
+		}
+
+		SharedObject msg = Mngr.MMakeShared(Type_of<Message>, &arena);
+		msg.Var("text") = std::string{ "hello" };
+
+		SharedObject copy = msg.MInvoke("Copy", &arena);
+		copy.Var("text") = std::string{ "world" };
+
+		ObjectView raw = Mngr.MNew(Type_of<Message>, &arena);
+		raw.Var("text") = std::string{ "raw" };
+
+		std::cout << "tracked: " << arena.GetTrackedNum() << std::endl;
+		std::cout << "leave scope" << std::endl;
+	}
+
+	std::cout << "end" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x, y, z;
+};
+
+struct alignas(64) Block {
+	std::byte data[100];
+};
+
+void Print(const HugePageResource::Stats& stats) {
+	std::cout
+		<< "  allocated bytes: " << stats.allocated_bytes << std::endl
+		<< "  peak allocated bytes: " << stats.peak_allocated_bytes << std::endl
+		<< "  chunks: " << stats.num_chunks << std::endl
+		<< "  large blocks: " << stats.num_large_blocks << std::endl
+		<< "  allocations: " << stats.num_allocations << std::endl
+		<< "  deallocations: " << stats.num_deallocations << std::endl
+		<< "  reused blocks: " << stats.num_reused_blocks << std::endl;
+}
+
+int main() {
+	Mngr.RegisterType<Vec>();
+	Mngr.AddField<&Vec::x>("x");
+	Mngr.AddField<&Vec::y>("y");
+	Mngr.AddField<&Vec::z>("z");
+	Mngr.RegisterType<Block>();
+	Mngr.RegisterType<std::vector<float>>();
+
+	auto rsrc = std::make_shared<HugePageResource>();
+	Mngr.SetObjectResource(rsrc);
+
+	{
+		std::vector<SharedObject> vecs;
+		for (int i = 0; i < 1000; i++) {
+			vecs.push_back(Mngr.MakeShared(Type_of<Vec>));
+			vecs.back().Var("x") = static_cast<float>(i);
+		}
+
+		SharedObject block = Mngr.MakeShared(Type_of<Block>);
+		std::cout << "block aligned: " << std::boolalpha
+			<< (reinterpret_cast<std::size_t>(block.GetPtr()) % alignof(Block) == 0) << std::endl;
+
+		std::cout << "x of vecs[999]: " << vecs[999].Var("x") << std::endl;
+
+		std::cout << "[live]" << std::endl;
+		Print(rsrc->GetStats());
+	}
+
+	std::cout << "[released]" << std::endl;
+	Print(rsrc->GetStats());
+
+	SharedObject v = Mngr.MakeShared(Type_of<Vec>);
+
+	std::cout << "[reused]" << std::endl;
+	Print(rsrc->GetStats());
+
+	v.Reset();
+	rsrc->Clear();
+
+	std::cout << "[clear]" << std::endl;
+	Print(rsrc->GetStats());
+}
@@ -0,0 +1,46 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Point {
+	float x;
+	float y;
+	bool operator==(const Point&) const = default;
+};
+
+void Print(const MemoryStats::TypeStats& stats) {
+	std::cout
+		<< "  typeinfo: " << (stats.typeinfo > 0) << std::endl
+		<< "  fields: " << (stats.fields > 0) << std::endl
+		<< "  methods: " << (stats.methods > 0) << std::endl
+		<< "  attrs: " << (stats.attrs > 0) << std::endl
+		<< "  dynamic fields: " << (stats.dynamic_fields > 0) << std::endl;
+}
+
+int main() {
+	std::cout << std::boolalpha;
+
+	const MemoryStats before = Mngr.GetMemoryStats();
+
+	Mngr.RegisterType<Point>();
+	Mngr.AddField<&Point::x>("x");
+	Mngr.AddField<&Point::y>("y");
+	Mngr.AddField(Type_of<Point>, "origin", FieldInfo{ Mngr.GenerateDynamicFieldPtr<Point>() });
+	Mngr.AddField(Type_of<Point>, "tag", FieldInfo{ Mngr.GenerateDynamicFieldPtr<std::string>("point") });
+	Mngr.AddTypeAttr(Type_of<Point>, Mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::None }));
+
+	const MemoryStats after = Mngr.GetMemoryStats();
+
+	std::cout << "[Point]" << std::endl;
+	Print(after.types.at(Type_of<Point>));
+
+	std::cout << "grow: " << (after.Total() > before.Total()) << std::endl;
+	std::cout << "name arena grow: " << (after.name_arena >= before.name_arena) << std::endl;
+
+	std::size_t sum = 0;
+	for (const auto& [type, stats] : after.types)
+		sum += stats.Total();
+	std::cout << "consistent: " << (sum + after.name_arena <= after.Total()) << std::endl;
+}
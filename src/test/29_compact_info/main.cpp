@@ -0,0 +1,44 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x;
+	float y;
+	void Add(float dx, float dy) { x += dx; y += dy; }
+	void Scale(float sx, float sy) { x *= sx; y *= sy; }
+};
+
+int main() {
+	std::cout << std::boolalpha;
+
+	Mngr.RegisterType<Vec>();
+	Mngr.AddField<&Vec::x>("x");
+	Mngr.AddField<&Vec::y>("y");
+	Mngr.AddMethod<&Vec::Add>("Add");
+	Mngr.AddMethod<&Vec::Scale>("Scale");
+	Mngr.AddFieldAttr(Type_of<Vec>, "y", Mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::None }));
+
+	const TypeInfo* info = Mngr.GetTypeInfo(Type_of<Vec>);
+
+	// Add and Scale take (float, float)
+	const auto& add = info->methodinfos.find("Add")->second;
+	const auto& scale = info->methodinfos.find("Scale")->second;
+	std::cout << "shared paramlist: " << (&add.methodptr.GetParamList() == &scale.methodptr.GetParamList()) << std::endl;
+	std::cout << "paramlist size: " << add.methodptr.GetParamList().size() << std::endl;
+
+	const auto& x = info->fieldinfos.find("x")->second;
+	const auto& y = info->fieldinfos.find("y")->second;
+	std::cout << "compact attrs: " << (sizeof(CompactAttrSet) == sizeof(void*)) << std::endl;
+	std::cout << "x attrs empty: " << x.attrs.empty() << std::endl;
+	std::cout << "x attrs sentinel: " << (&x.attrs.Get() == &EmptyAttrSet()) << std::endl;
+	std::cout << "y attrs size: " << y.attrs.size() << std::endl;
+	std::cout << "y attr ContainerType: " << (y.attrs.find(Type_of<ContainerType>) != y.attrs.end()) << std::endl;
+
+	SharedObject v = Mngr.MakeShared(Type_of<Vec>);
+	v.Invoke("Add", TempArgsView{ 1.f, 2.f });
+	v.Invoke("Scale", TempArgsView{ 2.f, 3.f });
+	std::cout << "v: " << v.Var("x") << ", " << v.Var("y") << std::endl;
+}
@@ -0,0 +1,79 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Tooltip {
+	float delay;
+};
+
+struct Range {
+	float min_value;
+	float max_value;
+};
+
+struct Base {
+	float b;
+};
+
+struct Slider : Base {
+	float value;
+};
+
+int main() {
+	std::cout << std::boolalpha;
+
+	Mngr.RegisterType<Tooltip>();
+	Mngr.AddField<&Tooltip::delay>("delay");
+	Mngr.AddConstructor<Tooltip, float>();
+	Mngr.RegisterType<Range>();
+	Mngr.AddField<&Range::min_value>("min_value");
+	Mngr.AddField<&Range::max_value>("max_value");
+	Mngr.AddConstructor<Range, float, float>();
+
+	Mngr.RegisterType<Base>();
+	Mngr.AddField<&Base::b>("b", { Mngr.MakeShared(Type_of<Tooltip>, TempArgsView{ 0.5f }) });
+
+	Mngr.RegisterType<Slider>();
+	Mngr.AddBases<Slider, Base>();
+	Mngr.AddField<&Slider::value>("value", {
+		Mngr.MakeShared(Type_of<Range>, TempArgsView{ 0.f, 1.f }),
+		Mngr.MakeShared(Type_of<Tooltip>, TempArgsView{ 1.f })
+	});
+	Mngr.AddTypeAttr(Type_of<Slider>, Mngr.MakeShared(Type_of<Tooltip>, TempArgsView{ 2.f }));
+	Mngr.AddTypeAttr(Type_of<Slider>, Mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::None }));
+
+	// flat set
+	const auto& attrs = Mngr.GetTypeInfo(Type_of<Slider>)->fieldinfos.find("value")->second.attrs;
+	std::cout << "field attrs: " << attrs.size() << std::endl;
+	std::cout << "sorted: " << (attrs.Get()[0].GetType() < attrs.Get()[1].GetType()) << std::endl;
+	std::cout << "duplicate: " << Mngr.AddFieldAttr(Type_of<Slider>, "value", Mngr.MakeShared(Type_of<Tooltip>, TempArgsView{ 3.f })) << std::endl;
+
+	// typed
+	const Tooltip* tooltip = Mngr.GetTypeAttr<Tooltip>(Type_of<Slider>);
+	std::cout << "type Tooltip: " << (tooltip ? tooltip->delay : -1.f) << std::endl;
+	std::cout << "type Range: " << (Mngr.GetTypeAttr<Range>(Type_of<Slider>) != nullptr) << std::endl;
+	std::cout << "Base Tooltip: " << (Mngr.GetTypeAttr<Tooltip>(Type_of<Base>) != nullptr) << std::endl;
+
+	// slot
+	const ContainerType* container_type = Mngr.GetTypeAttr<ContainerType>(Type_of<Slider>);
+	std::cout << "slot ContainerType: " << (container_type && *container_type == ContainerType::None) << std::endl;
+	Mngr.RegisterType<std::vector<float>>();
+	std::cout << "slot vector: " << (*Mngr.GetTypeAttr<ContainerType>(Type_of<std::vector<float>>) == ContainerType::Vector) << std::endl;
+
+	// the slot follows erase / insert on the AttrSet
+	{
+		AttrSet& slider_attrs = Mngr.typeinfos.at(Type_of<Slider>).attrs;
+		slider_attrs.erase(Type_of<ContainerType>);
+		std::cout << "erased slot: " << (Mngr.GetTypeAttr<ContainerType>(Type_of<Slider>) == nullptr) << std::endl;
+		slider_attrs.insert(Mngr.MakeShared(Type_of<ContainerType>, TempArgsView{ ContainerType::Array }));
+		const ContainerType* inserted = Mngr.GetTypeAttr<ContainerType>(Type_of<Slider>);
+		std::cout << "inserted slot: " << (inserted && *inserted == ContainerType::Array) << std::endl;
+	}
+
+	// field / method attrs (declared and inherited)
+	std::cout << "value Range: " << Mngr.GetFieldAttr(Type_of<Slider>, "value", Type_of<Range>).Var("max_value") << std::endl;
+	std::cout << "b Tooltip: " << Mngr.GetFieldAttr(Type_of<Slider>, "b", Type_of<Tooltip>).Var("delay") << std::endl;
+	std::cout << "b Range: " << Mngr.GetFieldAttr(Type_of<Slider>, "b", Type_of<Range>).GetType().Valid() << std::endl;
+}
@@ -0,0 +1,75 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Plugin {};
+struct Serialize {};
+
+struct Renderer {
+	float fov;
+	int samples;
+	void Draw() {}
+};
+
+struct Physics {
+	float gravity;
+	void Step() {}
+	void Step(float) {}
+};
+
+int main() {
+	Mngr.RegisterType<Plugin>();
+	Mngr.RegisterType<Serialize>();
+
+	Mngr.RegisterType<Renderer>();
+	Mngr.AddField<&Renderer::fov>("fov", { Mngr.MakeShared(Type_of<Serialize>) });
+	Mngr.AddField<&Renderer::samples>("samples");
+	Mngr.AddMethod<&Renderer::Draw>("Draw");
+
+	Mngr.RegisterType<Physics>();
+	Mngr.AddField<&Physics::gravity>("gravity");
+	Mngr.AddMethod<MemFuncOf<Physics, void()>::get(&Physics::Step)>("Step", { Mngr.MakeShared(Type_of<Serialize>) });
+	// overloads share the index entry
+	Mngr.AddMethod<MemFuncOf<Physics, void(float)>::get(&Physics::Step)>("Step", { Mngr.MakeShared(Type_of<Serialize>) });
+
+	Mngr.AddTypeAttr(Type_of<Renderer>, Mngr.MakeShared(Type_of<Plugin>));
+	Mngr.AddTypeAttr(Type_of<Physics>, Mngr.MakeShared(Type_of<Plugin>));
+	Mngr.AddFieldAttr(Type_of<Renderer>, "samples", Mngr.MakeShared(Type_of<Serialize>));
+	Mngr.AddFieldAttr(Type_of<Physics>, "gravity", Mngr.MakeShared(Type_of<Serialize>));
+	Mngr.AddMethodAttr(Type_of<Physics>, "Step", Mngr.MakeShared(Type_of<Plugin>));
+	// duplicate, ignored
+	Mngr.AddFieldAttr(Type_of<Physics>, "gravity", Mngr.MakeShared(Type_of<Serialize>));
+
+	std::cout << "[types with Plugin]" << std::endl;
+	for (const auto& type : Mngr.GetTypesWithAttr(Type_of<Plugin>))
+		std::cout << type.GetName() << std::endl;
+
+	std::cout << "[float fields with Serialize]" << std::endl;
+	for (const auto& [type, name] : Mngr.GetFieldsWithAttr(Type_of<Serialize>)) {
+		const auto& fieldinfo = Mngr.GetTypeInfo(type)->fieldinfos.at(name);
+		if (fieldinfo.fieldptr.GetType() == Type_of<float>)
+			std::cout << type.GetName() << "::" << name.GetView() << std::endl;
+	}
+
+	std::cout << "[methods with Plugin]" << std::endl;
+	for (const auto& [type, name] : Mngr.GetMethodsWithAttr(Type_of<Plugin>))
+		std::cout << type.GetName() << "::" << name.GetView() << std::endl;
+
+	std::cout << "[methods with Serialize]" << std::endl;
+	std::cout << Mngr.GetMethodsWithAttr(Type_of<Serialize>).size() << std::endl;
+
+	std::cout << "[fields with Plugin]" << std::endl;
+	std::cout << Mngr.GetFieldsWithAttr(Type_of<Plugin>).size() << std::endl;
+
+	// removal keeps the indices in sync
+	Mngr.RemoveTypeAttr(Type_of<Renderer>, Type_of<Plugin>);
+	Mngr.RemoveFieldAttr(Type_of<Renderer>, "fov", Type_of<Serialize>);
+	Mngr.RemoveMethodAttr(Type_of<Physics>, "Step", Type_of<Serialize>);
+	std::cout << "[after remove]" << std::endl;
+	std::cout << "types with Plugin: " << Mngr.GetTypesWithAttr(Type_of<Plugin>).size()
+		<< ", fields with Serialize: " << Mngr.GetFieldsWithAttr(Type_of<Serialize>).size()
+		<< ", methods with Serialize: " << Mngr.GetMethodsWithAttr(Type_of<Serialize>).size() << std::endl;
+	std::cout << "again: " << Mngr.RemoveTypeAttr(Type_of<Renderer>, Type_of<Plugin>) << std::endl;
+}
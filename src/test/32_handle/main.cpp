@@ -0,0 +1,50 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+#include <unordered_set>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Point {
+	float x;
+	float y;
+};
+
+int main() {
+	std::cout << std::boolalpha;
+
+	// the handle is created before the type is registered
+	TypeHandle point_handle = Mngr.GetTypeHandle(Type_of<Point>);
+	std::cout << "typeinfo before register: " << (point_handle.GetTypeInfo() != nullptr) << std::endl;
+	// a cvref variant too
+	TypeHandle const_ref_handle = Mngr.GetTypeHandle(Type_of<const Point&>);
+
+	Mngr.RegisterType<Point>();
+	Mngr.AddField<&Point::x>("x");
+	Mngr.AddField<&Point::y>("y");
+
+	std::cout << "sizeof(TypeHandle): " << sizeof(TypeHandle) << std::endl;
+	std::cout << "sizeof(NameHandle): " << sizeof(NameHandle) << std::endl;
+	std::cout << "sizeof(CompactObjectView): " << sizeof(CompactObjectView) << std::endl;
+
+	std::cout << "interned: " << (Mngr.GetTypeHandle(Type_of<Point>) == point_handle) << std::endl;
+	std::cout << "name: " << point_handle.GetName() << std::endl;
+	std::cout << "to Type: " << (static_cast<Type>(point_handle) == Type_of<Point>) << std::endl;
+	std::cout << "typeinfo: " << (point_handle.GetTypeInfo() == Mngr.GetTypeInfo(Type_of<Point>)) << std::endl;
+	std::cout << "cvref typeinfo: " << (const_ref_handle.GetTypeInfo() == Mngr.GetTypeInfo(Type_of<const Point&>)) << std::endl;
+
+	NameHandle x_handle = Mngr.GetNameHandle("x");
+	std::cout << "name handle: " << x_handle.GetView() << std::endl;
+	std::cout << "name interned: " << (Mngr.GetNameHandle("x") == x_handle) << std::endl;
+
+	std::unordered_set<TypeHandle> handles{ point_handle, Mngr.GetTypeHandle(Type_of<float>) };
+	std::cout << "hash set: " << handles.count(Mngr.GetTypeHandle(Type_of<float>)) << std::endl;
+
+	Point p{ 1.f, 2.f };
+	CompactObjectView compact{ point_handle, &p };
+	ObjectView obj = compact;
+	obj.Var(x_handle) += 2.f;
+	std::cout << "p: " << obj.Var("x") << ", " << obj.Var("y") << std::endl;
+
+	std::cout << "invalid: " << Mngr.GetTypeHandle(Type{}).Valid() << std::endl;
+}
@@ -0,0 +1,65 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+// trivially copyable, but not trivial (user-provided default ctor)
+struct Color {
+	float r, g, b;
+	Color() : r{ 1.f }, g{ 1.f }, b{ 1.f } {}
+	friend std::ostream& operator<<(std::ostream& os, const Color& c) {
+		return os << "(" << c.r << ", " << c.g << ", " << c.b << ")";
+	}
+};
+
+struct Vec3 {
+	float x, y, z;
+	friend std::ostream& operator<<(std::ostream& os, const Vec3& v) {
+		return os << "(" << v.x << ", " << v.y << ", " << v.z << ")";
+	}
+};
+
+// opt in stream operators
+template<>
+struct Ubpa::UDRefl::AutoRegisterPolicy<Vec3> {
+	static constexpr AutoRegisterFlag flags = AutoRegisterFlag::Default | AutoRegisterFlag::Stream;
+};
+
+int main() {
+	std::cout << std::boolalpha;
+
+	Mngr.RegisterType<Color>();
+	Mngr.AddField<&Color::r>("r");
+	Mngr.AddField<&Color::g>("g");
+	Mngr.AddField<&Color::b>("b");
+	Mngr.RegisterType<Vec3>();
+	Mngr.AddField<&Vec3::x>("x");
+	Mngr.AddField<&Vec3::y>("y");
+	Mngr.AddField<&Vec3::z>("z");
+
+	std::cout << "Color stream: " << Mngr.GetTypeInfo(Type_of<Color>)->methodinfos.contains(NameIDRegistry::Meta::operator_shr) << std::endl;
+	std::cout << "Vec3 stream: " << Mngr.GetTypeInfo(Type_of<Vec3>)->methodinfos.contains(NameIDRegistry::Meta::operator_shr) << std::endl;
+
+	// memcpy copy ctor / assignment
+	Color c0;
+	c0.g = 0.5f;
+	SharedObject c1 = Mngr.MakeShared(Type_of<Color>, TempArgsView{ c0 });
+	std::cout << "copy ctor: " << c1.Var("g") << std::endl;
+	SharedObject c2 = Mngr.MakeShared(Type_of<Color>);
+	c2 = c1;
+	std::cout << "assign: " << c2.Var("g") << std::endl;
+
+	SharedObject v = Mngr.MakeShared(Type_of<Vec3>);
+	v.Var("x") = 1.f;
+	v.Var("y") = 2.f;
+	v.Var("z") = 3.f;
+	std::cout << "v: " << v << std::endl;
+
+	// container vtable
+	Mngr.RegisterType<std::vector<int>>();
+	std::vector<int> ints{ 1, 2, 3 };
+	ObjectView obj{ ints };
+	std::cout << "size: " << obj.size() << std::endl;
+	std::cout << "empty: " << obj.empty() << std::endl;
+}
@@ -0,0 +1,81 @@
+#include <UDRefl/UDRefl.hpp>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x, y;
+	Vec operator+(const Vec& rhs) const { return { x + rhs.x, y + rhs.y }; }
+	Vec& operator+=(const Vec& rhs) { x += rhs.x; y += rhs.y; return *this; }
+	bool operator==(const Vec&) const = default;
+};
+
+// registered with a policy
+struct Point {
+	float x, y;
+	Point operator+(const Point& rhs) const { return { x + rhs.x, y + rhs.y }; }
+	bool operator==(const Point&) const = default;
+};
+
+struct Segment : Vec {};
+
+// element types, registered without flags
+struct Item {
+	int id;
+};
+
+struct Tag {
+	char c;
+};
+
+// per-type trait
+template<>
+struct Ubpa::UDRefl::AutoRegisterPolicy<Segment> {
+	static constexpr AutoRegisterFlag flags = AutoRegisterFlag::Lifecycle | AutoRegisterFlag::Compare;
+};
+
+void print_methods(Type type) {
+	std::cout << type.GetName() << ":";
+	for (const auto& [name, info] : Mngr.GetTypeInfo(type)->methodinfos)
+		std::cout << " " << name.GetView();
+	std::cout << std::endl;
+}
+
+int main() {
+	Mngr.RegisterType<Vec>();
+	Mngr.RegisterType<Point, AutoRegisterFlag::None>();
+	Mngr.RegisterType<Segment>();
+	Mngr.RegisterType<std::vector<Point>, AutoRegisterFlag::Lifecycle>();
+
+	std::cout << "Vec: " << Mngr.GetTypeInfo(Type_of<Vec>)->methodinfos.size() << std::endl;
+	print_methods(Type_of<Point>);
+	print_methods(Type_of<Segment>);
+	std::cout << "std::vector<Point>: " << Mngr.GetTypeInfo(Type_of<std::vector<Point>>)->methodinfos.size() << std::endl;
+	std::cout << "std::vector<Point>::push_back: "
+		<< Mngr.GetTypeInfo(Type_of<std::vector<Point>>)->methodinfos.contains(NameIDRegistry::Meta::container_push_back)
+		<< std::endl;
+
+	// element types are registered without Container / TupleVariant
+	Mngr.RegisterType<std::vector<Item>, AutoRegisterFlag::None>();
+	Mngr.RegisterType<std::pair<Tag, int>, AutoRegisterFlag::None>();
+	std::cout << "Item: " << (Mngr.GetTypeInfo(Type_of<Item>) != nullptr)
+		<< ", Tag: " << (Mngr.GetTypeInfo(Type_of<Tag>) != nullptr) << std::endl;
+
+	// the container vtable is registered without Container
+	std::vector<Item> items{ { 1 }, { 2 } };
+	auto items_view = ObjectView{ items }.AsContainer();
+	std::cout << "std::vector<Item> vtable: " << items_view.Valid() << ", size: " << items_view.Size() << std::endl;
+	// but no container method
+	print_methods(Type_of<std::vector<Item>>);
+	print_methods(Type_of<std::vector<Point>>);
+
+	// fields still work
+	Mngr.AddField<&Point::x>("x");
+	Mngr.AddField<&Point::y>("y");
+	Point p;
+	p.x = 1.f;
+	p.y = 2.f;
+	ObjectView obj{ p };
+	std::cout << "p: " << obj.Var("x") << ", " << obj.Var("y") << std::endl;
+}
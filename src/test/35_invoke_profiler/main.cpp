@@ -0,0 +1,68 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x, y;
+	Vec() : x{ 0.f }, y{ 0.f } {}
+	Vec(float x, float y) : x{ x }, y{ y } {}
+	float dot(const Vec& v) const { return x * v.x + y * v.y; }
+	void scale(double k) { x *= static_cast<float>(k); y *= static_cast<float>(k); }
+	void scale(float k) { x *= k; y *= k; }
+};
+
+int main() {
+	Mngr.RegisterType<Vec>();
+	Mngr.AddConstructor<Vec, float, float>();
+	Mngr.AddField<&Vec::x>("x");
+	Mngr.AddField<&Vec::y>("y");
+	Mngr.AddMethod<&Vec::dot>("dot");
+	Mngr.AddMethod<MemFuncOf<Vec, void(double)>::get(&Vec::scale)>("scale");
+	Mngr.AddMethod<MemFuncOf<Vec, void(float)>::get(&Vec::scale)>("scale");
+
+	Mngr.ResetInvokeReport();
+
+	SharedObject v = Mngr.MakeShared(Type_of<Vec>, TempArgsView{ 1.f, 2.f });
+	for (int i = 0; i < 10; i++)
+		v.Invoke("dot", TempArgsView{ v });
+	v.Invoke("scale", TempArgsView{ 2.f });
+	v.Invoke("scale", TempArgsView{ 2 }); // int -> double / float (converted)
+	v.Invoke("norm"); // not exist
+
+	// other threads
+	std::thread t{ [&] {
+		for (int i = 0; i < 5; i++)
+			v.Invoke("dot", TempArgsView{ v });
+	} };
+	t.join();
+
+	InvokeReport report = Mngr.GetInvokeReport();
+	if constexpr (!InvokeProfilerEnabled) {
+		std::cout << "profiler disabled, entries: " << report.entries.size() << std::endl;
+		return 0;
+	}
+
+	// entries are sorted by time, sort by name for a stable output
+	std::sort(report.entries.begin(), report.entries.end(), [](const auto& lhs, const auto& rhs) {
+		return lhs.method.GetView() < rhs.method.GetView();
+	});
+	for (const auto& [type, method, stats] : report.entries) {
+		std::cout << type.GetName() << "::" << method.GetView()
+			<< " calls: " << stats.calls
+			<< ", failures: " << stats.failures
+			<< ", overloads tried: " << stats.overloads_tried
+			<< ", hits: [" << stats.phase_hits[0] << ", " << stats.phase_hits[1] << ", " << stats.phase_hits[2] << ", " << stats.phase_hits[3] << "]"
+			<< ", copied args: " << stats.copied_args
+			<< std::endl;
+	}
+	std::cout << "total calls: " << report.Total().calls << std::endl;
+
+	std::cout << report;
+	report.WriteCSV(std::cout);
+	return 0;
+}
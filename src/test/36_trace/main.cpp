@@ -0,0 +1,74 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x, y;
+	float dot(const Vec& v) const { return x * v.x + y * v.y; }
+};
+
+// count the events of each category
+std::map<std::string, std::size_t> CountCategories(const std::string& json) {
+	std::map<std::string, std::size_t> counts;
+	const std::string_view key = "\"cat\":\"";
+	for (auto pos = json.find(key); pos != std::string::npos; pos = json.find(key, pos)) {
+		pos += key.size();
+		auto end = json.find('"', pos);
+		counts[json.substr(pos, end - pos)]++;
+		pos = end;
+	}
+	return counts;
+}
+
+int main() {
+	Mngr.StartTrace();
+
+	Mngr.RegisterType<Vec>();
+	Mngr.AddField<&Vec::x>("x");
+	Mngr.AddField<&Vec::y>("y");
+	Mngr.AddMethod<&Vec::dot>("dot");
+
+	Type types[] = { Type_of<float>, Type_of<float> };
+	Name names[] = { "u", "v" };
+	Mngr.RegisterType("UV", {}, types, names);
+
+	{
+		SharedObject v = Mngr.MakeShared(Type_of<Vec>);
+		v.Var("x") = 1.f;
+		v.Var("y") = 2.f;
+		for (int i = 0; i < 3; i++)
+			v.Invoke("dot", TempArgsView{ v });
+
+		std::thread t{ [&] { v.Invoke("dot", TempArgsView{ v }); } };
+		t.join();
+	}
+
+	Mngr.StopTrace();
+	{ // not recorded
+		SharedObject v = Mngr.MakeShared(Type_of<Vec>);
+		v.Invoke("dot", TempArgsView{ v });
+	}
+
+	std::stringstream ss;
+	Mngr.WriteTrace(ss);
+	const std::string json = ss.str();
+
+	if constexpr (!TraceEnabled) {
+		std::cout << "trace disabled: " << json;
+		return 0;
+	}
+
+	for (const auto& [cat, count] : CountCategories(json))
+		std::cout << cat << ": " << count << std::endl;
+	std::cout << "Vec::dot: " << (json.find("\"name\":\"Vec::dot\"") != std::string::npos) << std::endl;
+	std::cout << "UV: " << (json.find("\"name\":\"UV\"") != std::string::npos) << std::endl;
+	std::cout << "threads: " << (json.find("\"tid\":1") != std::string::npos ? 2 : 1) << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <iostream>
+#include <list>
+#include <set>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Point {
+	int x, y;
+};
+
+int main() {
+	Mngr.RegisterType<Point>();
+	Mngr.AddField<&Point::x>("x");
+	Mngr.AddField<&Point::y>("y");
+	Mngr.RegisterType<std::vector<Point>>();
+	Mngr.RegisterType<std::list<int>>();
+	Mngr.RegisterType<std::set<int>>();
+
+	// vector : contiguous
+	{
+		SharedObject vec = Mngr.MakeShared(Type_of<std::vector<Point>>);
+		ContainerView view = vec.AsContainer();
+		std::cout << "element type: " << view.GetElementType().GetName() << std::endl;
+		view.Reserve(4);
+		for (int i = 0; i < 3; i++) {
+			ObjectView p = view.EmplaceBack();
+			p.Var("x") = i;
+			p.Var("y") = i * i;
+		}
+		std::cout << "size: " << view.Size() << ", capacity: " << vec.As<std::vector<Point>>().capacity() << std::endl;
+		for (std::size_t i = 0; i < view.Size(); i++)
+			std::cout << "[" << i << "] " << view[i].Var("x") << ", " << view[i].Var("y") << std::endl;
+		// ForEach : elements are visited without the size / operator[] methods
+		view.ForEach([](ObjectView element) {
+			for (const auto& [name, var] : element.GetVars())
+				std::cout << name.GetView() << ": " << var << " ";
+			std::cout << std::endl;
+		});
+		view.Resize(5);
+		std::cout << "resized: " << view.Size() << ", [4] " << view[4].Var("x") << ", " << view[4].Var("y") << std::endl;
+		view.Clear();
+		std::cout << "empty: " << view.Empty() << std::endl;
+	}
+
+	// list : not contiguous
+	{
+		SharedObject lst = Mngr.MakeShared(Type_of<std::list<int>>);
+		ContainerView view = lst.AsContainer();
+		for (int i = 0; i < 4; i++)
+			view.EmplaceBack().As<int>() = i + 10;
+		std::cout << "contiguous: " << view.IsContiguous() << ", data: " << (view.Data() != nullptr) << std::endl;
+		view.ForEach([](ObjectView element) {
+			std::cout << element.GetType().GetName() << ": " << element.As<int>() << std::endl;
+		});
+	}
+
+	// set : const elements
+	{
+		std::set<int> s{ 3, 1, 2 };
+		ContainerView view = ObjectView{ s }.AsContainer();
+		std::cout << "element type: " << view.GetElementType().GetName()
+			<< ", emplace_back: " << static_cast<bool>(view.EmplaceBack()) << std::endl;
+		view.ForEach([](ObjectView element) { std::cout << element.As<const int>() << " "; });
+		std::cout << std::endl;
+	}
+
+	// const container
+	{
+		const std::vector<Point> cvec{ {1, 2}, {3, 4} };
+		ContainerView view = ObjectView{ cvec }.AsContainer();
+		std::cout << "element type: " << view.GetElementType().GetName()
+			<< ", clear: " << view.Clear() << ", size: " << view.Size() << std::endl;
+	}
+
+	// not a container
+	{
+		Point p{ 1, 2 };
+		std::cout << "point: " << ObjectView{ p }.AsContainer().Valid() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <span>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+void Print(const char* name, ObjectSpan elements) {
+	std::cout << name << ": ";
+	if (!elements) {
+		std::cout << "not contiguous" << std::endl;
+		return;
+	}
+	std::cout << elements.GetElementType().GetName()
+		<< ", size: " << elements.Size()
+		<< ", stride: " << elements.GetStride()
+		<< ", [";
+	for (std::size_t i = 0; i < elements.Size(); i++)
+		std::cout << (i == 0 ? "" : ", ") << elements[i];
+	std::cout << "]" << std::endl;
+}
+
+int main() {
+	Mngr.RegisterType<std::vector<float>>();
+	Mngr.RegisterType<std::array<int, 4>>();
+	Mngr.RegisterType<double[3]>();
+	Mngr.RegisterType<std::span<double>>();
+	Mngr.RegisterType<std::list<int>>();
+
+	SharedObject vec = Mngr.MakeShared(Type_of<std::vector<float>>);
+	for (float f : { 1.f, 2.f, 3.f, 4.f, 5.f })
+		vec.push_back(f);
+	Print("vector", vec.GetContiguousElements());
+
+	// typed view for bulk algorithms
+	std::span<float> floats = vec.GetContiguousElements().As<float>();
+	std::cout << "sum: " << std::accumulate(floats.begin(), floats.end(), 0.f) << std::endl;
+
+	std::array<int, 4> arr{ 1, 2, 3, 4 };
+	ObjectSpan arr_elements = ObjectView{ arr }.GetContiguousElements();
+	Print("array", arr_elements);
+	Print("array subspan", arr_elements.Subspan(1, 2));
+
+	double raw[3] = { 0.5, 1.5, 2.5 };
+	Print("raw array", ObjectView{ raw }.GetContiguousElements());
+
+	std::span<double> sp{ raw };
+	Print("span", ObjectView{ sp }.GetContiguousElements());
+
+	// memcpy trivially copyable payloads
+	double copy[3];
+	ObjectSpan raw_elements = ObjectView{ raw }.GetContiguousElements();
+	std::memcpy(copy, raw_elements.GetData(), raw_elements.SizeBytes());
+	Print("memcpy", ObjectSpan{ std::span{ copy } });
+
+	const std::vector<float>& cvec = vec.As<std::vector<float>>();
+	Print("const vector", ObjectView{ cvec }.GetContiguousElements());
+
+	std::list<int> lst{ 1, 2 };
+	Print("list", ObjectView{ lst }.GetContiguousElements());
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+// push_back takes rvalues only, elements can't be copied in
+struct RvalueStack {
+	using value_type = int;
+	std::vector<int> items;
+
+	void push_back(int&& v) { items.push_back(v); }
+	void clear() { items.clear(); }
+	std::size_t size() const { return items.size(); }
+	auto begin() { return items.begin(); }
+	auto end() { return items.end(); }
+	auto begin() const { return items.begin(); }
+	auto end() const { return items.end(); }
+};
+
+int main() {
+	Mngr.RegisterType<std::vector<int>>();
+	Mngr.RegisterType<std::vector<std::string>>();
+	Mngr.RegisterType<std::set<int>>();
+	Mngr.RegisterType<std::map<std::string, int>>();
+	Mngr.RegisterType<RvalueStack>();
+
+	// trivially copyable : memcpy
+	{
+		SharedObject vec = Mngr.MakeShared(Type_of<std::vector<int>>);
+		int data[] = { 1, 2, 3 };
+		std::cout << "append: " << Mngr.AppendRange(vec, std::span{ data }) << std::endl;
+		std::cout << "append: " << Mngr.AppendRange(vec, std::span{ data }.subspan(1)) << std::endl;
+		for (int i : vec.As<std::vector<int>>())
+			std::cout << i << " ";
+		std::cout << std::endl;
+
+		const int others[] = { 7, 8 };
+		std::cout << "assign: " << Mngr.AssignRange(vec, std::span{ others }) << std::endl;
+		for (int i : vec.As<std::vector<int>>())
+			std::cout << i << " ";
+		std::cout << std::endl;
+
+		float floats[] = { 1.f };
+		std::cout << "mismatched type: " << Mngr.AppendRange(vec, std::span{ floats }) << std::endl;
+
+		const std::vector<int>& cvec = vec.As<std::vector<int>>();
+		std::cout << "const container: " << Mngr.AppendRange(ObjectView{ cvec }, std::span{ data }) << std::endl;
+	}
+
+	// copy / move
+	{
+		SharedObject vec = Mngr.MakeShared(Type_of<std::vector<std::string>>);
+		std::string strs[] = { "hello", "world" };
+		Mngr.AppendRange(vec, std::span{ strs });
+		std::cout << "copied, source: " << strs[0] << " " << strs[1] << std::endl;
+		Mngr.AppendRange(vec, std::span{ strs }, true);
+		std::cout << "moved, source empty: " << strs[0].empty() << " " << strs[1].empty() << std::endl;
+		for (const auto& str : vec.As<std::vector<std::string>>())
+			std::cout << str << " ";
+		std::cout << std::endl;
+	}
+
+	// associative : insert
+	{
+		std::set<int> s{ 2 };
+		int data[] = { 3, 1, 2 };
+		std::cout << "append: " << ObjectView{ s }.AsContainer().AppendRange(std::span{ data }) << std::endl;
+		for (int i : s)
+			std::cout << i << " ";
+		std::cout << std::endl;
+
+		std::map<std::string, int> m;
+		std::pair<const std::string, int> entries[] = { {"a", 1}, {"b", 2} };
+		std::cout << "assign: " << Mngr.AssignRange(ObjectView{ m }, std::span{ entries }) << std::endl;
+		for (const auto& [key, value] : m)
+			std::cout << key << ": " << value << std::endl;
+	}
+
+	// rvalue push_back only : copying fails, moving works
+	{
+		RvalueStack stack;
+		int data[] = { 4, 5 };
+		ContainerView view = ObjectView{ stack }.AsContainer();
+		std::cout << "copy: " << view.AppendRange(std::span{ data }) << ", size: " << stack.size() << std::endl;
+		std::cout << "move: " << view.AppendRange(std::span{ data }, true) << ", size: " << stack.size() << std::endl;
+		// not cleared if the copy fails
+		std::cout << "assign copy: " << view.AssignRange(std::span{ data }) << ", size: " << stack.size() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+static std::size_t num_allocation = 0;
+
+void* operator new(std::size_t size) {
+	num_allocation++;
+	if (void* ptr = std::malloc(size))
+		return ptr;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+int main() {
+	Mngr.RegisterType<std::map<std::string, int>>();
+	Mngr.RegisterType<std::vector<int>>();
+	Mngr.RegisterType<std::deque<int>>();
+	Mngr.RegisterType<std::set<int>>();
+
+	std::map<std::string, int> m{ {"a", 1}, {"b", 2}, {"c", 3} };
+	ContainerView map_view = ObjectView{ m }.AsContainer();
+	std::cout << "iterable: " << map_view.IsIterable() << std::endl;
+
+	const std::size_t num_allocation_before = num_allocation;
+	int sum = 0;
+	for (ObjectView element : map_view)
+		sum += element.Var("second").As<int>();
+	std::cout << "sum: " << sum << ", allocations: " << num_allocation - num_allocation_before << std::endl;
+
+	for (ObjectView element : map_view)
+		std::cout << element.Var("first").As<const std::string>() << ": " << element.Var("second").As<int>() << std::endl;
+
+	// modify by the element views
+	std::vector<int> vec{ 1, 2, 3 };
+	for (ObjectView element : ObjectView{ vec }.AsContainer())
+		element.As<int>() *= 10;
+	for (int i : vec)
+		std::cout << i << " ";
+	std::cout << std::endl;
+
+	std::deque<int> dq{ 4, 5, 6 };
+	auto dq_view = ObjectView{ dq }.AsContainer();
+	for (auto iter = dq_view.begin(); iter != dq_view.end(); iter++)
+		std::cout << (*iter).GetType().GetName() << ": " << (*iter).As<int>() << std::endl;
+
+	const std::set<int> s{ 3, 1, 2 };
+	for (ObjectView element : ObjectView{ s }.AsContainer())
+		std::cout << element.GetType().GetName() << ": " << element.As<const int>() << std::endl;
+
+	std::vector<int> empty;
+	std::cout << "empty: " << (ObjectView{ empty }.AsContainer().begin() == ObjectView{ empty }.AsContainer().end()) << std::endl;
+
+	// not a container
+	int i = 0;
+	std::size_t n = 0;
+	for (ObjectView element : ObjectView{ i }.AsContainer())
+		n++;
+	std::cout << "not a container: " << n << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,92 @@
+#include <UDRefl/UDRefl.hpp>
+
+#include <array>
+#include <iostream>
+#include <tuple>
+#include <variant>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+template<std::size_t N>
+struct Msg {
+	std::size_t id = N;
+};
+
+// copying throws, emplace leaves the variant valueless
+struct Throwing {
+	Throwing() = default;
+	Throwing(const Throwing&) { throw 0; }
+};
+
+using Message = std::variant<
+	Msg<0>, Msg<1>, Msg<2>, Msg<3>, Msg<4>, Msg<5>, Msg<6>, Msg<7>, Msg<8>, Msg<9>,
+	Msg<10>, Msg<11>, Msg<12>, Msg<13>, Msg<14>, Msg<15>, Msg<16>, Msg<17>, Msg<18>, Msg<19>>;
+
+template<std::size_t... Ns>
+void RegisterMsgs(std::index_sequence<Ns...>) {
+	(Mngr.RegisterType<Msg<Ns>>(), ...);
+	(Mngr.AddField<&Msg<Ns>::id>("id"), ...);
+}
+
+template<std::size_t... Ns>
+std::array<Message, sizeof...(Ns)> MakeMsgs(std::index_sequence<Ns...>) {
+	return { Message{ std::in_place_index<Ns> }... };
+}
+
+int main() {
+	RegisterMsgs(std::make_index_sequence<std::variant_size_v<Message>>{});
+	Mngr.RegisterType<Message>();
+	Mngr.RegisterType<std::tuple<int, float, int>>();
+
+	// compile-time table
+	using Table = UDRefl::details::TypeIndexTable_of<std::variant_size, std::variant_alternative, Message>;
+	static_assert(Table::Find(TypeID_of<Msg<0>>) == 0);
+	static_assert(Table::Find(TypeID_of<Msg<19>>) == 19);
+	static_assert(Table::Find(TypeID_of<int>) == Table::npos);
+
+	auto msgs = MakeMsgs(std::make_index_sequence<std::variant_size_v<Message>>{});
+	for (std::size_t i : { 0, 7, 13, 19 }) {
+		ObjectView msg{ msgs[i] };
+		ObjectView alt = msg.variant_visit_get();
+		std::cout << "index: " << msg.index()
+			<< ", visit: " << alt.Var("id")
+			<< ", holds: " << msg.holds_alternative(msg.variant_alternative(i))
+			<< ", holds other: " << msg.holds_alternative(msg.variant_alternative((i + 1) % 20))
+			<< ", get by type: " << msg.get(msg.variant_alternative(i)).Var("id")
+			<< std::endl;
+	}
+	std::cout << "holds int: " << ObjectView{ msgs[0] }.holds_alternative(Type_of<int>) << std::endl;
+
+	// repeated alternatives : compared with the active one
+	Mngr.RegisterType<std::variant<int, int>>();
+	std::variant<int, int> twins{ std::in_place_index<1>, 5 };
+	std::cout << "twins index: " << ObjectView{ twins }.index()
+		<< ", holds int: " << ObjectView{ twins }.holds_alternative(Type_of<int>)
+		<< ", get int: " << ObjectView{ twins }.get(Type_of<int>)
+		<< ", get float: " << static_cast<bool>(ObjectView{ twins }.get(Type_of<float>).GetPtr())
+		<< std::endl;
+
+	// valueless by exception
+	Mngr.RegisterType<std::variant<int, Throwing>>();
+	std::variant<int, Throwing> valueless;
+	try {
+		const Throwing t;
+		valueless.emplace<Throwing>(t);
+	}
+	catch (int) {}
+	std::cout << "valueless: " << (ObjectView{ valueless }.index() == std::variant_npos)
+		<< ", visit: " << static_cast<bool>(ObjectView{ valueless }.variant_visit_get().GetPtr())
+		<< std::endl;
+
+	// tuple : get by type returns the first element of the type
+	SharedObject tuple = Mngr.MakeShared(Type_of<std::tuple<int, float, int>>, TempArgsView{ 1, 2.f, 3 });
+	std::cout << "get int: " << tuple.get(Type_of<int>)
+		<< ", get float: " << tuple.get(Type_of<float>)
+		<< ", get double: " << static_cast<bool>(tuple.get(Type_of<double>).GetPtr())
+		<< std::endl;
+	for (std::size_t i = 0; i < tuple.tuple_size(); i++)
+		std::cout << tuple.tuple_element(i).GetName() << ": " << tuple.get(i) << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+#include <UDRefl/UDRefl.hpp>
+#include <UDRefl_ext/Serialize.hpp>
+
+#include <array>
+#include <iostream>
+#include <list>
+#include <map>
+#include <set>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec3 {
+	float x, y, z;
+};
+
+struct Padded {
+	char c;
+	int i;
+	double d;
+};
+
+struct Named {
+	std::string name;
+};
+
+struct Entity : Named {
+	Vec3 position;
+	std::vector<Vec3> path;
+	std::map<std::string, int> tags;
+	std::list<int> ids;
+	std::set<int> layers;
+	std::array<int, 3> color;
+};
+
+struct Node {
+	int value;
+	std::vector<Node> children;
+};
+
+struct Opaque {
+	std::string s;
+};
+
+// trivial, but the pointer is a process address
+struct Linked {
+	int value;
+	Linked* next;
+};
+
+// bytes layout, but not trivially copyable
+struct Counted {
+	inline static int copies = 0;
+	int a, b;
+	Counted() = default;
+	Counted(const Counted& other) : a{ other.a }, b{ other.b } { ++copies; }
+	Counted& operator=(const Counted&) = default;
+};
+
+void PrintPlan(Type type) {
+	auto info = ext::GetSerializePlanInfo(type);
+	std::cout << type.GetName() << " : valid " << info.valid
+		<< ", memcpy " << info.num_memcpy
+		<< ", container " << info.num_container << std::endl;
+}
+
+int main() {
+	Mngr.RegisterType<Vec3>();
+	Mngr.AddField<&Vec3::x>("x");
+	Mngr.AddField<&Vec3::y>("y");
+	Mngr.AddField<&Vec3::z>("z");
+
+	Mngr.RegisterType<Padded>();
+	Mngr.AddField<&Padded::c>("c");
+	Mngr.AddField<&Padded::i>("i");
+	Mngr.AddField<&Padded::d>("d");
+
+	Mngr.RegisterType<Named>();
+	Mngr.AddField<&Named::name>("name");
+
+	Mngr.RegisterType<Entity>();
+	Mngr.AddBases<Entity, Named>();
+	Mngr.AddField<&Entity::position>("position");
+	Mngr.AddField<&Entity::path>("path");
+	Mngr.AddField<&Entity::tags>("tags");
+	Mngr.AddField<&Entity::ids>("ids");
+	Mngr.AddField<&Entity::layers>("layers");
+	Mngr.AddField<&Entity::color>("color");
+
+	Mngr.RegisterType<Node>();
+	Mngr.AddField<&Node::value>("value");
+	Mngr.AddField<&Node::children>("children");
+
+	Mngr.RegisterType<Opaque>();
+
+	Mngr.RegisterType<Linked>();
+	Mngr.AddField<&Linked::value>("value");
+	Mngr.AddField<&Linked::next>("next");
+
+	Mngr.RegisterType<Counted>();
+	Mngr.AddField<&Counted::a>("a");
+	Mngr.AddField<&Counted::b>("b");
+	Mngr.RegisterType<std::vector<Counted>>();
+	Mngr.RegisterType<std::vector<int*>>();
+
+	PrintPlan(Type_of<Vec3>);
+	PrintPlan(Type_of<Padded>);
+	PrintPlan(Type_of<Entity>);
+	PrintPlan(Type_of<Node>);
+	PrintPlan(Type_of<Opaque>);
+
+	std::vector<std::byte> buffer;
+
+	// trivially copyable
+	{
+		Padded src{ 'a', 2, 3.5 };
+		std::cout << "Padded size: " << ext::BinarySize(ObjectView{ src }) << " (sizeof " << sizeof(Padded) << ")" << std::endl;
+		buffer.resize(ext::BinarySize(ObjectView{ src }));
+		std::cout << "write: " << ext::BinaryWrite(ObjectView{ src }, buffer) << std::endl;
+		Padded dst{};
+		std::cout << "read: " << ext::BinaryRead(ObjectView{ dst }, buffer) << std::endl;
+		std::cout << dst.c << ", " << dst.i << ", " << dst.d << std::endl;
+	}
+
+	// nested types, bases and containers
+	{
+		Entity src;
+		src.name = "hero";
+		src.position = { 1.f, 2.f, 3.f };
+		src.path = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f } };
+		src.tags = { { "hp", 100 }, { "mp", 50 } };
+		src.ids = { 7, 8, 9 };
+		src.layers = { 3, 1, 2 };
+		src.color = { 255, 128, 0 };
+
+		const std::size_t size = ext::BinarySize(ObjectView{ src });
+		std::cout << "Entity size: " << size << std::endl;
+		buffer.resize(size);
+		std::cout << "write: " << ext::BinaryWrite(ObjectView{ src }, buffer) << std::endl;
+
+		Entity dst;
+		dst.ids = { 42 }; // overwritten
+		std::cout << "read: " << ext::BinaryRead(ObjectView{ dst }, buffer) << std::endl;
+		std::cout << "name: " << dst.name << std::endl;
+		std::cout << "position: " << dst.position.x << ", " << dst.position.y << ", " << dst.position.z << std::endl;
+		for (const auto& p : dst.path)
+			std::cout << "path: " << p.x << ", " << p.y << ", " << p.z << std::endl;
+		for (const auto& [k, v] : dst.tags)
+			std::cout << "tag: " << k << " = " << v << std::endl;
+		for (int id : dst.ids)
+			std::cout << "id: " << id << std::endl;
+		for (int layer : dst.layers)
+			std::cout << "layer: " << layer << std::endl;
+		std::cout << "color: " << dst.color[0] << ", " << dst.color[1] << ", " << dst.color[2] << std::endl;
+
+		// errors
+		std::cout << "small buffer: " << (ext::BinaryWrite(ObjectView{ src }, std::span{ buffer }.first(size - 1)) == ext::SerializeError) << std::endl;
+		std::cout << "truncated: " << (ext::BinaryRead(ObjectView{ dst }, std::span<const std::byte>{ buffer }.first(size - 1)) == ext::SerializeError) << std::endl;
+		const Entity& const_dst = dst;
+		std::cout << "const: " << (ext::BinaryRead(ObjectView{ const_dst }, buffer) == ext::SerializeError) << std::endl;
+	}
+
+	// recursive
+	{
+		Node src{ 1, { Node{ 2, {} }, Node{ 3, { Node{ 4, {} } } } } };
+		buffer.resize(ext::BinarySize(ObjectView{ src }));
+		std::cout << "Node write: " << ext::BinaryWrite(ObjectView{ src }, buffer) << std::endl;
+		Node dst{};
+		std::cout << "Node read: " << ext::BinaryRead(ObjectView{ dst }, buffer) << std::endl;
+		std::cout << dst.value << " [" << dst.children[0].value << ", " << dst.children[1].value
+			<< " [" << dst.children[1].children[0].value << "]]" << std::endl;
+	}
+
+	// bytes elements without a trivial copy ctor aren't copy-constructed from the buffer
+	{
+		std::vector<Counted> src(3);
+		for (int i = 0; i < 3; i++)
+			src[i].a = i, src[i].b = 10 * i;
+		buffer.resize(ext::BinarySize(ObjectView{ src }));
+		ext::BinaryWrite(ObjectView{ src }, buffer);
+		std::vector<Counted> dst;
+		Counted::copies = 0;
+		std::cout << "Counted read: " << ext::BinaryRead(ObjectView{ dst }, buffer) << ", copies: " << Counted::copies << std::endl;
+		std::cout << dst[0].b << ", " << dst[1].b << ", " << dst[2].b << std::endl;
+	}
+
+	// unsupported
+	{
+		Opaque o;
+		std::cout << "Opaque size error: " << (ext::BinarySize(ObjectView{ o }) == ext::SerializeError) << std::endl;
+		std::cout << "Linked: " << ext::IsSerializable(Type_of<Linked>)
+			<< ", tagged: " << ext::IsTaggedSerializable(Type_of<Linked>)
+			<< ", std::vector<int*>: " << ext::IsSerializable(Type_of<std::vector<int*>>) << std::endl;
+	}
+
+	return 0;
+}
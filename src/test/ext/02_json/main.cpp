@@ -0,0 +1,159 @@
+#include <UDRefl/UDRefl.hpp>
+#include <UDRefl_ext/Json.hpp>
+
+#include <iostream>
+#include <map>
+#include <sstream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec2 {
+	float x, y;
+};
+
+struct Named {
+	std::string name;
+};
+
+struct Item : Named {
+	bool enabled;
+	std::uint8_t level;
+	int score;
+	double weight;
+	Vec2 position;
+	std::vector<int> ids;
+	std::map<std::string, int> tags;
+};
+
+// return one byte per Read, to cross the chunk boundaries everywhere
+class ByteSource final : public ext::JsonSource {
+public:
+	explicit ByteSource(std::string_view str) : str{ str } {}
+	virtual std::size_t Read(char* buffer, std::size_t size) override {
+		if (str.empty() || size == 0)
+			return 0;
+		buffer[0] = str.front();
+		str.remove_prefix(1);
+		return 1;
+	}
+private:
+	std::string_view str;
+};
+
+class CountingSink final : public ext::JsonSink {
+public:
+	virtual bool Write(std::string_view chunk) override {
+		++num_chunks;
+		size += chunk.size();
+		return true;
+	}
+	std::size_t num_chunks{ 0 };
+	std::size_t size{ 0 };
+};
+
+int main() {
+	Mngr.RegisterType<Vec2>();
+	Mngr.AddField<&Vec2::x>("x");
+	Mngr.AddField<&Vec2::y>("y");
+
+	Mngr.RegisterType<Named>();
+	Mngr.AddField<&Named::name>("name");
+
+	Mngr.RegisterType<Item>();
+	Mngr.AddBases<Item, Named>();
+	Mngr.AddField<&Item::enabled>("enabled");
+	Mngr.AddField<&Item::level>("level");
+	Mngr.AddField<&Item::score>("score");
+	Mngr.AddField<&Item::weight>("weight");
+	Mngr.AddField<&Item::position>("position");
+	Mngr.AddField<&Item::ids>("ids");
+	Mngr.AddField<&Item::tags>("tags");
+
+	Mngr.RegisterType<std::vector<Item>>();
+	Mngr.RegisterType<std::map<int, Vec2>>();
+
+	std::cout << "Item: " << ext::IsJsonSerializable(Type_of<Item>) << std::endl;
+
+	Item item;
+	item.name = "sword \"A\"\n";
+	item.enabled = true;
+	item.level = 7;
+	item.score = -42;
+	item.weight = 0.1;
+	item.position = { 1.5f, -2.f };
+	item.ids = { 1, 2, 3 };
+	item.tags = { { "fire", 3 }, { "ice", 1 } };
+
+	const std::string json = ext::JsonWriteString(ObjectView{ item });
+	std::cout << json << std::endl;
+
+	// round trip
+	{
+		Item dst{};
+		std::cout << "read: " << ext::JsonReadString(ObjectView{ dst }, json) << std::endl;
+		std::cout << "same: " << (ext::JsonWriteString(ObjectView{ dst }) == json) << std::endl;
+	}
+
+	// byte by byte, whitespace, escapes, unknown and missing fields
+	{
+		Item dst{};
+		dst.score = 100;
+		ByteSource source{ R"( {
+			"unknown" : { "a": [1, 2.5e3, "x", null, true], "b": {} },
+			"name" : "caf\u00e9 \ud83d\ude00",
+			"level" : 255,
+			"ids" : [ 4 , 5 ],
+			"position" : { "y" : 3, "x" : -1e-2 },
+			"tags" : [ { "first" : "k", "second" : 9 } ]
+		} )" };
+		std::cout << "read: " << ext::JsonRead(ObjectView{ dst }, source) << std::endl;
+		std::cout << "name: " << dst.name << " (" << dst.name.size() << " bytes)" << std::endl;
+		std::cout << "level: " << static_cast<int>(dst.level) << ", score: " << dst.score << std::endl;
+		std::cout << "ids: " << dst.ids.size() << ", " << dst.ids[0] << ", " << dst.ids[1] << std::endl;
+		std::cout << "position: " << dst.position.x << ", " << dst.position.y << std::endl;
+		std::cout << "tags: " << dst.tags.size() << ", k = " << dst.tags["k"] << std::endl;
+	}
+
+	// elements of associative containers don't inherit missing fields from the previous one
+	{
+		std::map<int, Vec2> points;
+		std::cout << "read: " << ext::JsonReadString(ObjectView{ points },
+			R"([{"first":1,"second":{"x":1,"y":2}},{"first":2,"second":{"x":3}}])") << std::endl;
+		std::cout << "points: " << points.size() << ", " << points[2].x << ", " << points[2].y << std::endl;
+	}
+
+	// errors
+	{
+		Item dst{};
+		std::cout << "out of range: " << ext::JsonReadString(ObjectView{ dst }, R"({"level":256})") << std::endl;
+		std::cout << "int overflow: " << ext::JsonReadString(ObjectView{ dst }, R"({"score":99999999999999999999})") << std::endl;
+		std::cout << "float overflow: " << ext::JsonReadString(ObjectView{ dst }, R"({"weight":1e999})") << std::endl;
+		std::cout << "skipped overflow: " << ext::JsonReadString(ObjectView{ dst }, R"({"unknown":[1e999]})") << std::endl;
+		std::cout << "type mismatch: " << ext::JsonReadString(ObjectView{ dst }, R"({"score":"1"})") << std::endl;
+		std::cout << "truncated: " << ext::JsonReadString(ObjectView{ dst }, R"({"ids":[1,2)") << std::endl;
+		std::cout << "too deep: " << ext::JsonReadString(ObjectView{ dst }, R"({"x":)" + std::string(1000, '[')) << std::endl;
+		const Item& const_dst = dst;
+		std::cout << "const: " << ext::JsonReadString(ObjectView{ const_dst }, json) << std::endl;
+	}
+
+	// large documents are streamed in chunks
+	{
+		std::vector<Item> items(2000, item);
+		CountingSink sink;
+		std::cout << "write: " << ext::JsonWrite(ObjectView{ items }, sink) << std::endl;
+		std::cout << "chunked: " << (sink.num_chunks > 1) << std::endl;
+
+		std::stringstream ss;
+		ext::JsonOStreamSink os_sink{ ss };
+		ext::JsonWrite(ObjectView{ items }, os_sink);
+		std::cout << "size: " << (ss.str().size() == sink.size) << std::endl;
+
+		std::vector<Item> dst;
+		ext::JsonIStreamSource is_source{ ss };
+		std::cout << "read: " << ext::JsonRead(ObjectView{ dst }, is_source) << std::endl;
+		std::cout << "count: " << dst.size() << ", last: " << dst.back().name.size() << ", " << dst.back().tags.size() << std::endl;
+	}
+
+	return 0;
+}
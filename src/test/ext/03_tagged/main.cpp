@@ -0,0 +1,147 @@
+#include <UDRefl/UDRefl.hpp>
+#include <UDRefl_ext/Serialize.hpp>
+
+#include <iostream>
+#include <list>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+// version 1 of the saved data
+
+struct PartV1 {
+	int kind;
+	float mass;
+};
+
+struct ShipV1 {
+	std::string name;
+	int level;              // int64 in version 2
+	float hp;               // removed in version 2
+	std::vector<PartV1> parts;
+	std::list<int> history; // removed in version 2
+};
+
+// version 2, fields are reordered, added and removed
+
+struct PartV2 {
+	float mass;
+	int kind;
+	bool broken;            // added
+};
+
+struct ShipV2 {
+	std::vector<PartV2> parts;
+	std::string name;
+	std::int64_t level;
+	std::string faction;    // added
+	std::vector<int> cargo; // added
+};
+
+// a base without registered fields is a nested value named by its type
+struct RawHeader {
+	int magic;
+	float scale;
+};
+
+struct Record : RawHeader {
+	int x;
+};
+
+int main() {
+	Mngr.RegisterType<PartV1>();
+	Mngr.AddField<&PartV1::kind>("kind");
+	Mngr.AddField<&PartV1::mass>("mass");
+
+	Mngr.RegisterType<ShipV1>();
+	Mngr.AddField<&ShipV1::name>("name");
+	Mngr.AddField<&ShipV1::level>("level");
+	Mngr.AddField<&ShipV1::hp>("hp");
+	Mngr.AddField<&ShipV1::parts>("parts");
+	Mngr.AddField<&ShipV1::history>("history");
+
+	Mngr.RegisterType<PartV2>();
+	Mngr.AddField<&PartV2::mass>("mass");
+	Mngr.AddField<&PartV2::kind>("kind");
+	Mngr.AddField<&PartV2::broken>("broken");
+
+	Mngr.RegisterType<ShipV2>();
+	Mngr.AddField<&ShipV2::parts>("parts");
+	Mngr.AddField<&ShipV2::name>("name");
+	Mngr.AddField<&ShipV2::level>("level");
+	Mngr.AddField<&ShipV2::faction>("faction");
+	Mngr.AddField<&ShipV2::cargo>("cargo");
+
+	Mngr.RegisterType<RawHeader>();
+	Mngr.RegisterType<Record>();
+	Mngr.AddBases<Record, RawHeader>();
+	Mngr.AddField<&Record::x>("x");
+
+	std::cout << "ShipV1: " << ext::IsTaggedSerializable(Type_of<ShipV1>) << std::endl;
+	std::cout << "ShipV2: " << ext::IsTaggedSerializable(Type_of<ShipV2>) << std::endl;
+
+	ShipV1 v1;
+	v1.name = "Falcon";
+	v1.level = 12;
+	v1.hp = 99.5f;
+	v1.parts = { { 1, 10.f }, { 2, 20.f } };
+	v1.history = { 3, 4, 5 };
+
+	std::vector<std::byte> buffer(ext::TaggedSize(ObjectView{ v1 }));
+	const std::size_t size = ext::TaggedWrite(ObjectView{ v1 }, buffer);
+	std::cout << "size: " << size << " (" << buffer.size() << "), binary: " << ext::BinarySize(ObjectView{ v1 }) << std::endl;
+
+	// same version
+	{
+		ShipV1 dst;
+		std::cout << "read v1: " << ext::TaggedRead(ObjectView{ dst }, buffer) << std::endl;
+		std::cout << dst.name << ", " << dst.level << ", " << dst.hp << ", parts " << dst.parts.size()
+			<< ", history " << dst.history.size() << std::endl;
+	}
+
+	// new version
+	{
+		ShipV2 dst;
+		dst.level = -1;
+		dst.faction = "stale";
+		dst.cargo = { 7 };
+		dst.parts = { { 1.f, 1, true } };
+		std::cout << "read v2: " << ext::TaggedRead(ObjectView{ dst }, buffer) << std::endl;
+		std::cout << "name: " << dst.name << std::endl;
+		std::cout << "level: " << dst.level << " (raw size changed)" << std::endl;
+		std::cout << "faction: \"" << dst.faction << "\", cargo: " << dst.cargo.size() << " (missing)" << std::endl;
+		for (const auto& part : dst.parts)
+			std::cout << "part: " << part.kind << ", " << part.mass << ", " << part.broken << std::endl;
+
+		// and back to version 1
+		std::vector<std::byte> buffer2(ext::TaggedSize(ObjectView{ dst }));
+		ext::TaggedWrite(ObjectView{ dst }, buffer2);
+		ShipV1 back;
+		back.hp = 1.f;
+		std::cout << "read back: " << (ext::TaggedRead(ObjectView{ back }, buffer2) == buffer2.size()) << std::endl;
+		std::cout << back.name << ", " << back.level << ", " << back.hp << ", parts " << back.parts.size()
+			<< ", history " << back.history.size() << std::endl;
+	}
+
+	// field-less base
+	{
+		Record record;
+		record.magic = 42;
+		record.scale = 0.5f;
+		record.x = 7;
+		std::vector<std::byte> record_buffer(ext::TaggedSize(ObjectView{ record }));
+		ext::TaggedWrite(ObjectView{ record }, record_buffer);
+		Record dst{};
+		std::cout << "read record: " << (ext::TaggedRead(ObjectView{ dst }, record_buffer) == record_buffer.size()) << std::endl;
+		std::cout << dst.magic << ", " << dst.scale << ", " << dst.x << std::endl;
+	}
+
+	// errors
+	{
+		ShipV2 dst;
+		std::cout << "truncated: " << (ext::TaggedRead(ObjectView{ dst }, std::span<const std::byte>{ buffer }.first(size - 1)) == ext::SerializeError) << std::endl;
+		std::cout << "small buffer: " << (ext::TaggedWrite(ObjectView{ v1 }, std::span{ buffer }.first(size - 1)) == ext::SerializeError) << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,170 @@
+#include <UDRefl/UDRefl.hpp>
+#include <UDRefl_ext/Archive.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec3 {
+	float x, y, z;
+};
+
+struct Named {
+	std::string name;
+};
+
+struct Part {
+	int kind;
+	float mass;
+};
+
+struct Ship : Named {
+	Vec3 position;
+	std::vector<Part> parts;
+	std::vector<std::string> crew;
+	std::map<std::string, int> cargo;
+	Ship* escort;
+};
+
+// archived std::string
+std::string_view AsString(ObjectView span) {
+	std::span<const char> chars = ext::ArchiveElements(span).As<const char>();
+	return { chars.data(), chars.size() };
+}
+
+struct Node {
+	int value;
+	Node* next;
+};
+
+int main() {
+	Mngr.RegisterType<Vec3>();
+	Mngr.AddField<&Vec3::x>("x");
+	Mngr.AddField<&Vec3::y>("y");
+	Mngr.AddField<&Vec3::z>("z");
+
+	Mngr.RegisterType<Named>();
+	Mngr.AddField<&Named::name>("name");
+
+	Mngr.RegisterType<Part>();
+	Mngr.AddField<&Part::kind>("kind");
+	Mngr.AddField<&Part::mass>("mass");
+
+	Mngr.RegisterType<Ship>();
+	Mngr.AddBases<Ship, Named>();
+	Mngr.AddField<&Ship::position>("position");
+	Mngr.AddField<&Ship::parts>("parts");
+	Mngr.AddField<&Ship::crew>("crew");
+	Mngr.AddField<&Ship::cargo>("cargo");
+	Mngr.AddField<&Ship::escort>("escort");
+
+	Mngr.RegisterType<Node>();
+	Mngr.AddField<&Node::value>("value");
+	Mngr.AddField<&Node::next>("next");
+
+	// archived types, registered on the first use
+	std::cout << "Vec3: " << ext::ArchivedType(Type_of<Vec3>).GetName() << std::endl;
+	std::cout << "Ship: " << ext::ArchivedType(Type_of<Ship>).GetName() << std::endl;
+	std::cout << "Node: " << ext::ArchivedType(Type_of<Node>).GetName() << std::endl;
+	for (auto&& [name, info] : FieldRange{ ext::ArchivedType(Type_of<Ship>) })
+		std::cout << "  " << name.GetView() << ": " << info.fieldptr.GetType().GetName() << std::endl;
+
+	Ship escort;
+	escort.name = "Hawk";
+	escort.position = { 4.f, 5.f, 6.f };
+	escort.escort = nullptr;
+
+	Ship ship;
+	ship.name = "Falcon";
+	ship.position = { 1.f, 2.f, 3.f };
+	ship.parts = { { 1, 10.f }, { 2, 20.f }, { 3, 30.f } };
+	ship.crew = { "Han", "Chewie" };
+	ship.cargo = { { "fuel", 9 }, { "spice", 3 } };
+	ship.escort = &escort;
+	escort.escort = &ship; // cyclic
+
+	const std::vector<std::byte> archive = ext::ArchiveWrite(ObjectView{ ship });
+	std::cout << "size: " << archive.size() << std::endl;
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "UDRefl_ext_04_archive.bin";
+	{
+		std::ofstream ofs{ path, std::ios::binary };
+		ofs.write(reinterpret_cast<const char*>(archive.data()), static_cast<std::streamsize>(archive.size()));
+	}
+
+	{
+		ext::ArchiveFile file{ path };
+		std::cout << "mapped: " << file.IsOpen() << std::endl;
+
+		ObjectView view = ext::ArchiveLoad(Type_of<Ship>, file.GetBytes(), true);
+		std::cout << "loaded: " << static_cast<bool>(view) << ", " << view.GetType().GetName() << std::endl;
+
+		// through the registry
+		std::cout << "name: " << AsString(view.Var("name")) << std::endl;
+		std::cout << "position.y: " << view.Var("position").Var("y").As<const float>() << std::endl;
+		ObjectSpan parts = ext::ArchiveElements(view.Var("parts"));
+		std::cout << "parts: " << parts.Size() << ", " << parts.GetElementType().GetName() << std::endl;
+		for (const Part& part : parts.As<const Part>())
+			std::cout << "  " << part.kind << ", " << part.mass << std::endl;
+		for (std::size_t i = 0; i < ext::ArchiveElements(view.Var("crew")).Size(); i++)
+			std::cout << "  crew: " << AsString(ext::ArchiveElements(view.Var("crew"))[i]) << std::endl;
+		for (std::size_t i = 0; i < ext::ArchiveElements(view.Var("cargo")).Size(); i++) {
+			ObjectView item = ext::ArchiveElements(view.Var("cargo"))[i];
+			std::cout << "  cargo: " << AsString(item.Var("first")) << ", " << item.Var("second").As<const int>() << std::endl;
+		}
+		ObjectView archived_escort = ext::ArchiveDeref(view.Var("escort"));
+		std::cout << "escort: " << AsString(archived_escort.Var("name")) << std::endl;
+		std::cout << "escort.escort is root: " << (ext::ArchiveDeref(archived_escort.Var("escort")).GetPtr() == view.GetPtr()) << std::endl;
+
+		// the wrong type
+		std::cout << "as Node: " << static_cast<bool>(ext::ArchiveLoad(Type_of<Node>, file.GetBytes())) << std::endl;
+	}
+	std::filesystem::remove(path);
+
+	// long linked lists are archived iteratively
+	{
+		std::vector<Node> nodes(100000);
+		for (std::size_t i = 0; i < nodes.size(); i++) {
+			nodes[i].value = static_cast<int>(i);
+			nodes[i].next = i + 1 < nodes.size() ? &nodes[i + 1] : nullptr;
+		}
+		const std::vector<std::byte> list = ext::ArchiveWrite(ObjectView{ nodes.front() });
+		ObjectView head = ext::ArchiveLoad(Type_of<Node>, list, true);
+		long long sum = 0;
+		std::size_t count = 0;
+		for (ObjectView node = head; node; node = ext::ArchiveDeref(node.Var("next"))) {
+			sum += node.Var("value").As<const int>();
+			++count;
+		}
+		std::cout << "list: " << count << ", " << sum << std::endl;
+	}
+
+	// corrupted
+	{
+		std::vector<std::byte> corrupted = archive;
+		ObjectView view = ext::ArchiveLoad(Type_of<Ship>, corrupted);
+		const auto offset = static_cast<std::byte*>(view.Var("parts").GetPtr()) - static_cast<const std::byte*>(view.GetPtr())
+			+ static_cast<std::ptrdiff_t>(reinterpret_cast<const ext::ArchiveHeader*>(corrupted.data())->root);
+		std::int64_t relative = 1 << 20;
+		std::memcpy(corrupted.data() + offset, &relative, sizeof(relative));
+		std::cout << "corrupted: " << static_cast<bool>(ext::ArchiveLoad(Type_of<Ship>, corrupted)) << ", verified: "
+			<< static_cast<bool>(ext::ArchiveLoad(Type_of<Ship>, corrupted, true)) << std::endl;
+		relative = std::numeric_limits<std::int64_t>::max();
+		std::memcpy(corrupted.data() + offset, &relative, sizeof(relative));
+		std::cout << "overflow verified: " << static_cast<bool>(ext::ArchiveLoad(Type_of<Ship>, corrupted, true)) << std::endl;
+		std::vector<std::byte> other_layout = archive;
+		reinterpret_cast<ext::ArchiveHeader*>(other_layout.data())->fingerprint ^= 1;
+		std::cout << "other layout: " << static_cast<bool>(ext::ArchiveLoad(Type_of<Ship>, other_layout)) << std::endl;
+		std::vector<std::byte> misaligned(archive.size() + 1);
+		std::memcpy(misaligned.data() + 1, archive.data(), archive.size());
+		std::cout << "misaligned: " << static_cast<bool>(ext::ArchiveLoad(Type_of<Ship>, std::span{ misaligned }.subspan(1))) << std::endl;
+		std::cout << "truncated: " << static_cast<bool>(ext::ArchiveLoad(Type_of<Ship>, std::span{ archive }.first(archive.size() - 1))) << std::endl;
+	}
+
+	return 0;
+}
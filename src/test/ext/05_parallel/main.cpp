@@ -0,0 +1,116 @@
+#include <UDRefl/UDRefl.hpp>
+#include <UDRefl_ext/Serialize.hpp>
+
+#include <array>
+#include <iostream>
+#include <list>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Point {
+	float x, y;
+
+	friend bool operator==(const Point&, const Point&) = default;
+};
+
+struct Record {
+	std::uint32_t id;
+	Point position;
+	std::string name;
+	std::vector<int> values;
+
+	friend bool operator==(const Record&, const Record&) = default;
+};
+
+int main() {
+	Mngr.RegisterType<Point>();
+	Mngr.AddField<&Point::x>("x");
+	Mngr.AddField<&Point::y>("y");
+
+	Mngr.RegisterType<Record>();
+	Mngr.AddField<&Record::id>("id");
+	Mngr.AddField<&Record::position>("position");
+	Mngr.AddField<&Record::name>("name");
+	Mngr.AddField<&Record::values>("values");
+
+	Mngr.RegisterType<std::vector<Record>>();
+	Mngr.RegisterType<std::vector<Point>>();
+	Mngr.RegisterType<std::list<int>>();
+	Mngr.RegisterType<std::array<Point, 3000>>();
+
+	std::vector<Record> records(100000);
+	for (std::size_t i = 0; i < records.size(); i++) {
+		auto& r = records[i];
+		r.id = static_cast<std::uint32_t>(i);
+		r.position = { static_cast<float>(i), -static_cast<float>(i) };
+		r.name = "record_" + std::to_string(i);
+		r.values.assign(i % 7, static_cast<int>(i));
+	}
+
+	// the format doesn't depend on the number of threads
+	const std::size_t size = ext::ParallelBinarySize(ObjectView{ records });
+	std::cout << "size: " << (size == ext::ParallelBinarySize(ObjectView{ records }, 1)) << std::endl;
+	std::vector<std::byte> buffer(size);
+	std::cout << "write: " << (ext::ParallelBinaryWrite(ObjectView{ records }, buffer, 4) == size) << std::endl;
+	{
+		std::vector<std::byte> buffer1(size);
+		ext::ParallelBinaryWrite(ObjectView{ records }, buffer1, 1);
+		std::cout << "same: " << (buffer == buffer1) << std::endl;
+	}
+	std::uint64_t header[2];
+	std::memcpy(header, buffer.data(), sizeof(header));
+	std::cout << "count: " << header[0] << ", chunks: " << header[1] << std::endl;
+
+	for (std::size_t num_threads : { 1, 3, 8 }) {
+		std::vector<Record> dst(5);
+		const std::size_t read = ext::ParallelBinaryRead(ObjectView{ dst }, buffer, num_threads);
+		std::cout << num_threads << " threads: " << (read == size) << ", equal: " << (dst == records) << std::endl;
+	}
+
+	// trivially copyable elements, chunks are memcpy-ed
+	{
+		std::vector<Point> points(5000);
+		for (std::size_t i = 0; i < points.size(); i++)
+			points[i] = { static_cast<float>(i), 1.f };
+		std::vector<std::byte> point_buffer(ext::ParallelBinarySize(ObjectView{ points }));
+		ext::ParallelBinaryWrite(ObjectView{ points }, point_buffer, 2);
+		std::vector<Point> dst;
+		std::cout << "points: " << (ext::ParallelBinaryRead(ObjectView{ dst }, point_buffer, 2) == point_buffer.size())
+			<< ", equal: " << (dst == points) << std::endl;
+
+		// fixed size, read in place
+		auto arr = std::make_unique<std::array<Point, 3000>>();
+		std::cout << "array (wrong size): " << (ext::ParallelBinaryRead(ObjectView{ *arr }, point_buffer) == ext::SerializeError) << std::endl;
+		points.resize(3000);
+		point_buffer.resize(ext::ParallelBinarySize(ObjectView{ points }));
+		ext::ParallelBinaryWrite(ObjectView{ points }, point_buffer);
+		std::cout << "array: " << (ext::ParallelBinaryRead(ObjectView{ *arr }, point_buffer) == point_buffer.size())
+			<< ", last: " << (*arr)[2999].x << std::endl;
+	}
+
+	// empty
+	{
+		std::vector<Record> empty;
+		std::vector<std::byte> empty_buffer(ext::ParallelBinarySize(ObjectView{ empty }));
+		std::vector<Record> dst(3);
+		std::cout << "empty: " << empty_buffer.size() << ", " << ext::ParallelBinaryWrite(ObjectView{ empty }, empty_buffer)
+			<< ", " << ext::ParallelBinaryRead(ObjectView{ dst }, empty_buffer) << ", " << dst.size() << std::endl;
+	}
+
+	// errors
+	{
+		std::list<int> lst;
+		std::cout << "not contiguous: " << (ext::ParallelBinarySize(ObjectView{ lst }) == ext::SerializeError) << std::endl;
+		std::cout << "small buffer: " << (ext::ParallelBinaryWrite(ObjectView{ records }, std::span{ buffer }.first(size - 1)) == ext::SerializeError) << std::endl;
+		std::vector<Record> dst;
+		std::cout << "truncated: " << (ext::ParallelBinaryRead(ObjectView{ dst }, std::span<const std::byte>{ buffer }.first(size - 1)) == ext::SerializeError) << std::endl;
+		std::vector<std::byte> corrupted = buffer;
+		const std::uint64_t huge = std::uint64_t{ 1 } << 40;
+		std::memcpy(corrupted.data() + 2 * sizeof(std::uint64_t), &huge, sizeof(huge)); // count of the first chunk
+		std::cout << "corrupted index: " << (ext::ParallelBinaryRead(ObjectView{ dst }, corrupted) == ext::SerializeError)
+			<< ", untouched: " << dst.empty() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,233 @@
+#include <UDRefl/UDRefl.hpp>
+#include <UDRefl_ext/Diff.hpp>
+
+#include <iostream>
+#include <map>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec3 {
+	float x, y, z;
+
+	friend bool operator==(const Vec3&, const Vec3&) = default;
+};
+
+struct Named {
+	std::string name;
+
+	friend bool operator==(const Named&, const Named&) = default;
+};
+
+// padding between kind and mass, compared field by field
+struct Part {
+	char kind;
+	double mass;
+
+	friend bool operator==(const Part&, const Part&) = default;
+};
+
+struct Ship : Named {
+	Vec3 position;
+	int health;
+	std::vector<Part> parts;
+	std::vector<std::string> crew;
+	std::map<std::string, int> cargo;
+
+	friend bool operator==(const Ship&, const Ship&) = default;
+};
+
+// mutually recursive through a container
+struct Leaf;
+
+struct Tree {
+	int id;
+	std::vector<Leaf> leaves;
+
+	friend bool operator==(const Tree&, const Tree&) = default;
+};
+
+struct Leaf {
+	float weight;
+	Tree subtree;
+
+	friend bool operator==(const Leaf&, const Leaf&) = default;
+};
+
+// a base without registered fields is diffed as a whole
+struct RawHeader {
+	int magic;
+	float scale;
+
+	friend bool operator==(const RawHeader&, const RawHeader&) = default;
+};
+
+struct Record : RawHeader {
+	int x;
+
+	friend bool operator==(const Record&, const Record&) = default;
+};
+
+// entries : path = size
+void Print(const std::vector<std::byte>& patch) {
+	std::cout << "entries: " << ext::PatchEntryCount(patch) << ", bytes: " << patch.size() << std::endl;
+	const std::byte* cur = patch.data() + 2 * sizeof(std::uint64_t);
+	for (std::size_t i = 0; i < ext::PatchEntryCount(patch); i++) {
+		std::uint32_t depth;
+		std::memcpy(&depth, cur, sizeof(depth));
+		cur += sizeof(depth);
+		std::cout << "  /";
+		for (std::uint32_t j = 0; j < depth; j++) {
+			std::uint64_t step;
+			std::memcpy(&step, cur, sizeof(step));
+			cur += sizeof(step);
+			std::cout << step << "/";
+		}
+		std::uint64_t size;
+		std::memcpy(&size, cur, sizeof(size));
+		cur += sizeof(size) + size;
+		std::cout << " = " << size << " bytes" << std::endl;
+	}
+}
+
+int main() {
+	Mngr.RegisterType<Vec3>();
+	Mngr.AddField<&Vec3::x>("x");
+	Mngr.AddField<&Vec3::y>("y");
+	Mngr.AddField<&Vec3::z>("z");
+
+	Mngr.RegisterType<Named>();
+	Mngr.AddField<&Named::name>("name");
+
+	Mngr.RegisterType<Part>();
+	Mngr.AddField<&Part::kind>("kind");
+	Mngr.AddField<&Part::mass>("mass");
+
+	Mngr.RegisterType<Ship>();
+	Mngr.AddBases<Ship, Named>();
+	Mngr.AddField<&Ship::position>("position");
+	Mngr.AddField<&Ship::health>("health");
+	Mngr.AddField<&Ship::parts>("parts");
+	Mngr.AddField<&Ship::crew>("crew");
+	Mngr.AddField<&Ship::cargo>("cargo");
+
+	Mngr.RegisterType<std::vector<Part>>();
+	Mngr.RegisterType<std::vector<std::string>>();
+	Mngr.RegisterType<std::map<std::string, int>>();
+	Mngr.RegisterType<std::vector<Ship>>();
+
+	Mngr.RegisterType<Tree>();
+	Mngr.AddField<&Tree::id>("id");
+	Mngr.AddField<&Tree::leaves>("leaves");
+	Mngr.RegisterType<Leaf>();
+	Mngr.AddField<&Leaf::weight>("weight");
+	Mngr.AddField<&Leaf::subtree>("subtree");
+	Mngr.RegisterType<std::vector<Leaf>>();
+
+	Mngr.RegisterType<RawHeader>();
+	Mngr.RegisterType<Record>();
+	Mngr.AddBases<Record, RawHeader>();
+	Mngr.AddField<&Record::x>("x");
+
+	std::cout << "diffable: " << ext::IsDiffable(Type_of<Ship>) << std::endl;
+
+	// fields : 0 name (base), 1 position, 2 health, 3 parts, 4 crew, 5 cargo
+	const Ship before{
+		{ "Nostromo" },
+		{ 1.f, 2.f, 3.f },
+		100,
+		{ { 'a', 10. }, { 'b', 20. }, { 'c', 30. } },
+		{ "Dallas", "Ripley" },
+		{ { "ore", 5 } }
+	};
+
+	// no change
+	{
+		const Ship same = before;
+		std::vector<std::byte> patch = ext::Diff(ObjectView{ before }, ObjectView{ same });
+		Print(patch);
+	}
+
+	// changed fields, nested fields and elements
+	{
+		Ship after = before;
+		after.position.y = 5.f;
+		after.health = 80;
+		after.parts[1].mass = 25.;
+		after.crew[1] = "Ellen Ripley";
+		after.cargo["fuel"] = 7;
+		std::vector<std::byte> patch = ext::Diff(ObjectView{ before }, ObjectView{ after });
+		Print(patch);
+
+		Ship ship = before;
+		std::cout << "apply: " << ext::Apply(ObjectView{ ship }, patch) << ", equal: " << (ship == after) << std::endl;
+		// applying twice is idempotent
+		std::cout << "apply: " << ext::Apply(ObjectView{ ship }, patch) << ", equal: " << (ship == after) << std::endl;
+		std::cout << "diff after apply: " << ext::PatchEntryCount(ext::Diff(ObjectView{ ship }, ObjectView{ after })) << std::endl;
+	}
+
+	// resized containers are whole entries
+	{
+		Ship after = before;
+		after.name = "Sulaco";
+		after.parts.push_back({ 'd', 40. });
+		after.crew.clear();
+		std::vector<std::byte> patch = ext::Diff(ObjectView{ before }, ObjectView{ after });
+		Print(patch);
+		Ship ship = before;
+		std::cout << "apply: " << ext::Apply(ObjectView{ ship }, patch) << ", equal: " << (ship == after) << std::endl;
+	}
+
+	// containers of objects, the paths start with the index
+	{
+		std::vector<Ship> fleet(3, before);
+		std::vector<Ship> next = fleet;
+		next[2].position.z = -1.f;
+		std::vector<std::byte> patch;
+		std::cout << "fleet: " << ext::Diff(ObjectView{ fleet }, ObjectView{ next }, patch) << std::endl;
+		Print(patch);
+		std::cout << "apply: " << ext::Apply(ObjectView{ fleet }, patch) << ", equal: " << (fleet == next) << std::endl;
+	}
+
+	// mutual recursion, the plan of Tree is compiled first
+	{
+		std::cout << "diffable Tree: " << ext::IsDiffable(Type_of<Tree>) << ", Leaf: " << ext::IsDiffable(Type_of<Leaf>) << std::endl;
+		Tree tree{ 1, { { 0.5f, { 2, {} } }, { 1.5f, { 3, { { 2.5f, { 4, {} } } } } } } };
+		Tree next = tree;
+		next.leaves[1].subtree.leaves[0].weight = 9.f;
+		std::vector<std::byte> patch = ext::Diff(ObjectView{ tree }, ObjectView{ next });
+		Print(patch);
+		std::cout << "apply: " << ext::Apply(ObjectView{ tree }, patch) << ", equal: " << (tree == next) << std::endl;
+	}
+
+	// only the bytes of the field-less base change
+	{
+		const Record record{ { 1, 1.f }, 7 };
+		Record next = record;
+		next.scale = 2.f;
+		std::vector<std::byte> patch = ext::Diff(ObjectView{ record }, ObjectView{ next });
+		Print(patch);
+		Record dst = record;
+		std::cout << "apply: " << ext::Apply(ObjectView{ dst }, patch) << ", equal: " << (dst == next) << std::endl;
+	}
+
+	// errors
+	{
+		Ship after = before;
+		after.health = 1;
+		std::vector<std::byte> patch = ext::Diff(ObjectView{ before }, ObjectView{ after });
+		Vec3 v{};
+		std::cout << "different types: " << ext::Diff(ObjectView{ before }, ObjectView{ v }).empty() << std::endl;
+		std::cout << "wrong type: " << ext::Apply(ObjectView{ v }, patch) << std::endl;
+		std::cout << "const: " << ext::Apply(ObjectView{ before }, patch) << std::endl;
+
+		Ship ship = before;
+		std::cout << "truncated: " << ext::Apply(ObjectView{ ship }, std::span{ patch }.first(patch.size() - 1)) << std::endl;
+		std::vector<std::byte> corrupted = patch;
+		const std::uint64_t bad_step = 42;
+		std::memcpy(corrupted.data() + 2 * sizeof(std::uint64_t) + sizeof(std::uint32_t), &bad_step, sizeof(bad_step));
+		std::cout << "bad path: " << ext::Apply(ObjectView{ ship }, corrupted) << ", unchanged: " << (ship == before) << std::endl;
+	}
+
+	return 0;
+}